@@ -0,0 +1,119 @@
+#include "tangram.h"
+#include "platform_mock.h"
+#include "data/memoryCacheDataSource.h"
+#include "data/rawTileCache.h"
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileCache.h"
+#include "util/mapProjection.h"
+
+#include "fixtures.h"
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Tiles of a 16x16 grid around the fixture tile, visited row by row
+static std::vector<TileID> gridTiles() {
+    std::vector<TileID> ids;
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            ids.emplace_back(Fixtures::tileID.x - 8 + x, Fixtures::tileID.y - 8 + y, Fixtures::tileID.z);
+        }
+    }
+    return ids;
+}
+
+// Look up the grid tiles in a cache with room for a quarter of them, putting
+// them back as TileManager does when they are no longer visible
+static void BM_Tangram_TileCacheChurn(benchmark::State& state) {
+    auto platform = std::make_shared<MockPlatform>();
+    auto scene = Fixtures::loadScene(platform, Fixtures::scene());
+    if (!scene) {
+        state.SkipWithError("Could not load the fixture scene");
+        return;
+    }
+
+    auto& source = *scene->tileSources().front();
+    auto task = Fixtures::task(source, Fixtures::mvt(Fixtures::sparse));
+    auto tileData = source.parse(*task, *scene->mapProjection());
+
+    TileBuilder builder(scene);
+    std::vector<std::shared_ptr<Tile>> tiles;
+    size_t usage = 0;
+    for (auto& id : gridTiles()) {
+        tiles.push_back(builder.build(id, *tileData, source));
+        usage += tiles.back()->getMemoryUsage();
+    }
+
+    TileCache cache(usage / 4);
+    int64_t hits = 0;
+
+    while (state.KeepRunning()) {
+        for (auto& tile : tiles) {
+            auto cached = cache.get(source.id(), tile->getID());
+            if (cached) { hits++; }
+            cache.put(source.id(), cached ? cached : tile);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * tiles.size());
+    benchmark::DoNotOptimize(hits);
+}
+BENCHMARK(BM_Tangram_TileCacheChurn);
+
+// Provides a copy of the fixture tile for every task
+struct FixtureDataSource : TileSource::DataSource {
+
+    std::vector<char> data = Fixtures::mvt(Fixtures::sparse);
+
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        auto copy = data;
+        static_cast<BinaryTileTask&>(*_task).rawTileData = std::make_shared<RawData>(std::move(copy));
+        _cb.func(_task);
+        return true;
+    }
+
+    std::string cacheKey(const TileID& _tile) const override {
+        return "fixtures/" + _tile.toString();
+    }
+};
+
+// Load the grid tiles through a MemoryCacheDataSource with room for a quarter
+// of them, with a RawTileCache of state.range(0) shards
+static void BM_Tangram_MemoryCacheChurn(benchmark::State& state) {
+    auto platform = std::make_shared<MockPlatform>();
+    auto scene = Fixtures::loadScene(platform, Fixtures::scene());
+    if (!scene) {
+        state.SkipWithError("Could not load the fixture scene");
+        return;
+    }
+
+    auto& source = *scene->tileSources().front();
+    auto ids = gridTiles();
+
+    size_t budget = ids.size() * Fixtures::mvt(Fixtures::sparse).size() / 4;
+    MemoryCacheDataSource cacheSource(std::make_shared<RawTileCache>(budget, state.range(0)));
+    cacheSource.setNext(std::make_unique<FixtureDataSource>());
+
+    int64_t loaded = 0;
+    TileTaskCb cb{[&](std::shared_ptr<TileTask> _task) { loaded++; }};
+
+    while (state.KeepRunning()) {
+        for (auto& id : ids) {
+            cacheSource.loadTileData(source.createTask(id), cb);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * ids.size());
+    benchmark::DoNotOptimize(loaded);
+}
+BENCHMARK(BM_Tangram_MemoryCacheChurn)->Arg(1)->Arg(16);
+
+BENCHMARK_MAIN();
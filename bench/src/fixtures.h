@@ -0,0 +1,509 @@
+#pragma once
+
+// Synthetic tiles and scene for the benchmarks
+//
+// The fixtures are generated from a fixed seed, so that every run and every
+// machine benchmarks the same bytes. A tile of N features contains
+// - 'buildings': N/2 polygons, some of them with a hole
+// - 'roads': 3N/10 lines of 6 to 12 points
+// - 'pois': N/5 points
+// with 'kind', 'name', 'height' and 'id' properties, and is encoded as MVT,
+// GeoJSON or TopoJSON.
+
+#include "log.h"
+#include "platform.h"
+#include "data/rawData.h"
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+#include "text/fontContext.h"
+#include "tile/tileID.h"
+#include "tile/tileTask.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Fixtures {
+
+// Tile the fixtures are located in
+const Tangram::TileID tileID(4824, 6157, 14);
+
+// Tile extent of the generated coordinates
+const int extent = 4096;
+
+// Feature counts of the benchmarked densities
+const int sparse = 100;
+const int medium = 1000;
+const int dense = 10000;
+
+struct Point { int x, y; };
+
+struct Feature {
+    enum Type { point = 1, line = 2, polygon = 3 } type;
+    // Points or line of the feature, rings of polygons, first ring is the outer one
+    std::vector<std::vector<Point>> rings;
+    std::string kind;
+    std::string name;
+    int height;
+    uint64_t id;
+};
+
+struct Layer {
+    std::string name;
+    std::vector<Feature> features;
+};
+
+// Linear congruential generator, identical on all platforms
+class Random {
+public:
+    explicit Random(uint32_t _seed) : m_state(_seed) {}
+    uint32_t next() { m_state = m_state * 1664525u + 1013904223u; return m_state >> 8; }
+    int range(int _min, int _max) { return _min + int(next() % uint32_t(_max - _min + 1)); }
+private:
+    uint32_t m_state;
+};
+
+inline std::vector<Layer> layers(int _features) {
+
+    Random random(_features);
+    std::vector<Layer> result(3);
+    result[0].name = "buildings";
+    result[1].name = "roads";
+    result[2].name = "pois";
+
+    static const char* buildingKinds[] = { "residential", "commercial", "industrial", "school" };
+    static const char* roadKinds[] = { "highway", "major_road", "minor_road", "path" };
+    static const char* poiKinds[] = { "cafe", "restaurant", "shop", "park", "station" };
+
+    uint64_t id = 1;
+
+    for (int i = 0; i < _features / 2; i++) {
+        Feature f;
+        f.type = Feature::polygon;
+        int size = random.range(16, 160);
+        int x = random.range(0, extent - size), y = random.range(0, extent - size);
+        // Clockwise in tile coordinates, as MVT requires for outer rings
+        f.rings.push_back({ {x, y}, {x + size, y}, {x + size, y + size}, {x, y + size} });
+        if (i % 8 == 0) {
+            int s = size / 4;
+            int cx = x + size / 2, cy = y + size / 2;
+            f.rings.push_back({ {cx - s, cy - s}, {cx - s, cy + s}, {cx + s, cy + s}, {cx + s, cy - s} });
+        }
+        f.kind = buildingKinds[i % 4];
+        f.name = "Building " + std::to_string(i);
+        f.height = random.range(3, 120);
+        f.id = id++;
+        result[0].features.push_back(std::move(f));
+    }
+
+    for (int i = 0; i < _features * 3 / 10; i++) {
+        Feature f;
+        f.type = Feature::line;
+        std::vector<Point> line;
+        int x = random.range(0, extent), y = random.range(0, extent);
+        int points = random.range(6, 12);
+        for (int p = 0; p < points; p++) {
+            line.push_back({x, y});
+            x = std::min(extent, std::max(0, x + random.range(-200, 200)));
+            y = std::min(extent, std::max(0, y + random.range(-200, 200)));
+        }
+        f.rings.push_back(std::move(line));
+        f.kind = roadKinds[i % 4];
+        f.name = "Road " + std::to_string(i);
+        f.height = 0;
+        f.id = id++;
+        result[1].features.push_back(std::move(f));
+    }
+
+    for (int i = 0; i < _features / 5; i++) {
+        Feature f;
+        f.type = Feature::point;
+        f.rings.push_back({ {random.range(0, extent), random.range(0, extent)} });
+        f.kind = poiKinds[i % 5];
+        f.name = "Place " + std::to_string(i);
+        f.height = 0;
+        f.id = id++;
+        result[2].features.push_back(std::move(f));
+    }
+
+    return result;
+}
+
+// Protocol buffer encoding
+
+class PbfWriter {
+public:
+    void varint(uint64_t _value) {
+        while (_value >= 0x80) {
+            data.push_back(char((_value & 0x7f) | 0x80));
+            _value >>= 7;
+        }
+        data.push_back(char(_value));
+    }
+    void key(int _field, int _wireType) { varint((uint64_t(_field) << 3) | uint64_t(_wireType)); }
+    void uint(int _field, uint64_t _value) { key(_field, 0); varint(_value); }
+    void bytes(int _field, const std::string& _bytes) {
+        key(_field, 2);
+        varint(_bytes.size());
+        data.append(_bytes);
+    }
+    void packed(int _field, const std::vector<uint32_t>& _values) {
+        PbfWriter values;
+        for (auto v : _values) { values.varint(v); }
+        bytes(_field, values.data);
+    }
+    std::string data;
+};
+
+inline uint32_t zigzag(int32_t _value) { return uint32_t((_value << 1) ^ (_value >> 31)); }
+
+inline uint32_t command(uint32_t _id, uint32_t _count) { return (_id & 0x7) | (_count << 3); }
+
+inline std::vector<char> mvt(int _features) {
+
+    PbfWriter tile;
+
+    for (auto& layer : layers(_features)) {
+        PbfWriter out;
+        out.uint(15, 2);
+        out.bytes(1, layer.name);
+
+        // keys: kind, name, height; values: one per feature and property
+        uint32_t value = 0;
+        std::vector<std::string> values;
+
+        for (auto& feature : layer.features) {
+            PbfWriter f;
+            f.uint(1, feature.id);
+
+            std::vector<uint32_t> tags;
+            for (uint32_t k = 0; k < 3; k++) {
+                PbfWriter v;
+                if (k == 0) { v.bytes(1, feature.kind); }
+                if (k == 1) { v.bytes(1, feature.name); }
+                if (k == 2) { v.uint(4, feature.height); }
+                values.push_back(v.data);
+                tags.push_back(k);
+                tags.push_back(value++);
+            }
+            f.packed(2, tags);
+            f.uint(3, feature.type);
+
+            std::vector<uint32_t> geometry;
+            Point cursor{0, 0};
+            auto moveTo = [&](const Point& _p) {
+                geometry.push_back(zigzag(_p.x - cursor.x));
+                geometry.push_back(zigzag(_p.y - cursor.y));
+                cursor = _p;
+            };
+
+            if (feature.type == Feature::point) {
+                geometry.push_back(command(1, feature.rings[0].size()));
+                for (auto& p : feature.rings[0]) { moveTo(p); }
+            } else {
+                for (auto& ring : feature.rings) {
+                    geometry.push_back(command(1, 1));
+                    moveTo(ring[0]);
+                    geometry.push_back(command(2, ring.size() - 1));
+                    for (size_t i = 1; i < ring.size(); i++) { moveTo(ring[i]); }
+                    if (feature.type == Feature::polygon) { geometry.push_back(command(7, 1)); }
+                }
+            }
+            f.packed(4, geometry);
+
+            out.bytes(2, f.data);
+        }
+
+        out.bytes(3, "kind");
+        out.bytes(3, "name");
+        out.bytes(3, "height");
+        for (auto& v : values) { out.bytes(4, v); }
+        out.uint(5, extent);
+
+        tile.bytes(3, out.data);
+    }
+
+    return std::vector<char>(tile.data.begin(), tile.data.end());
+}
+
+// Longitude and latitude bounds of tileID
+
+inline double tileLon(double _x) { return _x / (1 << tileID.z) * 360.0 - 180.0; }
+
+inline double tileLat(double _y) {
+    double n = M_PI - 2.0 * M_PI * _y / (1 << tileID.z);
+    return 180.0 / M_PI * std::atan(0.5 * (std::exp(n) - std::exp(-n)));
+}
+
+struct Bounds {
+    double west = tileLon(tileID.x), east = tileLon(tileID.x + 1);
+    double north = tileLat(tileID.y), south = tileLat(tileID.y + 1);
+};
+
+inline std::string properties(const Feature& _feature) {
+    std::ostringstream out;
+    out << "{\"kind\":\"" << _feature.kind << "\",\"name\":\"" << _feature.name
+        << "\",\"height\":" << _feature.height << ",\"id\":" << _feature.id << "}";
+    return out.str();
+}
+
+inline std::vector<char> geoJson(int _features) {
+
+    Bounds b;
+    std::ostringstream out;
+    out.precision(9);
+
+    auto position = [&](const Point& _p) {
+        out << "[" << b.west + (b.east - b.west) * _p.x / extent << ","
+            << b.north + (b.south - b.north) * _p.y / extent << "]";
+    };
+    auto line = [&](const std::vector<Point>& _line) {
+        out << "[";
+        for (size_t i = 0; i < _line.size(); i++) {
+            if (i > 0) { out << ","; }
+            position(_line[i]);
+        }
+        out << "]";
+    };
+
+    out << "{";
+    bool firstLayer = true;
+    for (auto& layer : layers(_features)) {
+        if (!firstLayer) { out << ","; }
+        firstLayer = false;
+
+        out << "\"" << layer.name << "\":{\"type\":\"FeatureCollection\",\"features\":[";
+        for (size_t i = 0; i < layer.features.size(); i++) {
+            auto& feature = layer.features[i];
+            if (i > 0) { out << ","; }
+
+            out << "{\"type\":\"Feature\",\"geometry\":";
+            if (feature.type == Feature::point) {
+                out << "{\"type\":\"Point\",\"coordinates\":";
+                position(feature.rings[0][0]);
+            } else if (feature.type == Feature::line) {
+                out << "{\"type\":\"LineString\",\"coordinates\":";
+                line(feature.rings[0]);
+            } else {
+                out << "{\"type\":\"Polygon\",\"coordinates\":[";
+                for (size_t r = 0; r < feature.rings.size(); r++) {
+                    if (r > 0) { out << ","; }
+                    // GeoJSON rings are closed
+                    auto ring = feature.rings[r];
+                    ring.push_back(ring[0]);
+                    line(ring);
+                }
+                out << "]";
+            }
+            out << "},\"properties\":" << properties(feature) << "}";
+        }
+        out << "]}";
+    }
+    out << "}";
+
+    auto json = out.str();
+    return std::vector<char>(json.begin(), json.end());
+}
+
+inline std::vector<char> topoJson(int _features) {
+
+    Bounds b;
+    std::ostringstream out;
+    out.precision(12);
+
+    std::ostringstream arcs;
+    int arcCount = 0;
+
+    // Quantized arcs, delta-encoded and with y pointing north
+    auto arc = [&](const std::vector<Point>& _line) {
+        if (arcCount > 0) { arcs << ","; }
+        arcs << "[";
+        Point cursor{0, 0};
+        for (size_t i = 0; i < _line.size(); i++) {
+            Point q{ _line[i].x, extent - _line[i].y };
+            if (i > 0) { arcs << ","; }
+            arcs << "[" << q.x - cursor.x << "," << q.y - cursor.y << "]";
+            cursor = q;
+        }
+        arcs << "]";
+        return arcCount++;
+    };
+
+    out << "{\"type\":\"Topology\",\"transform\":{\"scale\":["
+        << (b.east - b.west) / extent << "," << (b.north - b.south) / extent << "],\"translate\":["
+        << b.west << "," << b.south << "]},\"objects\":{";
+
+    bool firstLayer = true;
+    for (auto& layer : layers(_features)) {
+        if (!firstLayer) { out << ","; }
+        firstLayer = false;
+
+        out << "\"" << layer.name << "\":{\"type\":\"GeometryCollection\",\"geometries\":[";
+        for (size_t i = 0; i < layer.features.size(); i++) {
+            auto& feature = layer.features[i];
+            if (i > 0) { out << ","; }
+
+            if (feature.type == Feature::point) {
+                auto& p = feature.rings[0][0];
+                out << "{\"type\":\"Point\",\"coordinates\":[" << p.x << "," << extent - p.y << "]";
+            } else if (feature.type == Feature::line) {
+                out << "{\"type\":\"LineString\",\"arcs\":[" << arc(feature.rings[0]) << "]";
+            } else {
+                out << "{\"type\":\"Polygon\",\"arcs\":[";
+                for (size_t r = 0; r < feature.rings.size(); r++) {
+                    if (r > 0) { out << ","; }
+                    auto ring = feature.rings[r];
+                    ring.push_back(ring[0]);
+                    out << "[" << arc(ring) << "]";
+                }
+                out << "]";
+            }
+            out << ",\"properties\":" << properties(feature) << "}";
+        }
+        out << "]}";
+    }
+    out << "},\"arcs\":[" << arcs.str() << "]}";
+
+    auto json = out.str();
+    return std::vector<char>(json.begin(), json.end());
+}
+
+// Scene drawing the fixture layers of the source 'fixtures' with one style each.
+// @_type is the source type, MVT, GeoJSON or TopoJSON; @_layers the layers to include;
+// @_url the URL template of the source.
+inline std::string scene(const std::string& _type = "MVT",
+                         const std::vector<std::string>& _layers = { "buildings", "roads", "pois", "labels" },
+                         const std::string& _url = "file:///fixtures/{z}/{x}/{y}") {
+
+    std::string yaml = R"END(
+sources:
+    fixtures:
+        type: )END" + _type + R"END(
+        url: )END" + _url + R"END(
+        max_zoom: 16
+styles:
+    icons:
+        base: points
+layers:
+)END";
+
+    for (auto& layer : _layers) {
+        if (layer == "buildings") {
+            yaml += R"END(
+    buildings:
+        data: { source: fixtures, layer: buildings }
+        filter: { kind: [residential, commercial, industrial] }
+        draw:
+            polygons:
+                order: 1
+                color: '#ccc'
+                interactive: true
+        tall:
+            filter: { height: { min: 50 } }
+            draw:
+                polygons:
+                    color: '#aaa'
+                    extrude: true
+        schools:
+            filter: { kind: school }
+            draw:
+                polygons:
+                    order: 2
+                    color: '#cca'
+)END";
+        } else if (layer == "roads") {
+            yaml += R"END(
+    roads:
+        data: { source: fixtures, layer: roads }
+        draw:
+            lines:
+                order: 3
+                color: white
+                width: [[12, 1px], [16, 4m]]
+                cap: round
+                join: round
+        highway:
+            filter: { kind: highway }
+            draw:
+                lines:
+                    order: 4
+                    color: orange
+                    width: 8m
+                    outline:
+                        color: '#666'
+                        width: 1px
+        paths:
+            filter: { kind: path }
+            draw:
+                lines:
+                    color: '#999'
+                    width: 1px
+)END";
+        } else if (layer == "pois") {
+            yaml += R"END(
+    pois:
+        data: { source: fixtures, layer: pois }
+        draw:
+            icons:
+                size: 16px
+                color: red
+                interactive: true
+                collide: true
+)END";
+        } else if (layer == "labels") {
+            yaml += R"END(
+    labels:
+        data: { source: fixtures, layer: [roads, pois] }
+        draw:
+            text:
+                text_source: name
+                font:
+                    size: 12px
+                    fill: black
+                    stroke: { color: white, width: 2px }
+                collide: true
+                interactive: true
+)END";
+        }
+    }
+
+    return yaml;
+}
+
+// Load the scene @_yaml, returns nullptr on failure
+inline std::shared_ptr<Tangram::Scene> loadScene(const std::shared_ptr<Tangram::Platform>& _platform,
+                                                 const std::string& _yaml) {
+    using namespace Tangram;
+
+    auto scene = std::make_shared<Scene>(_platform);
+
+    try { scene->config() = YAML::Load(_yaml); }
+    catch (YAML::ParserException& e) {
+        LOGE("Parsing scene config '%s'", e.what());
+        return nullptr;
+    }
+    if (!SceneLoader::applyConfig(_platform, scene)) { return nullptr; }
+
+    scene->fontContext()->loadFonts();
+
+    return scene;
+}
+
+// Task of @_source for the tile @_tileID with the raw tile @_data
+inline std::shared_ptr<Tangram::TileTask> task(Tangram::TileSource& _source, std::vector<char> _data,
+                                               Tangram::TileID _tileID = tileID) {
+    using namespace Tangram;
+
+    auto task = _source.createTask(_tileID);
+    static_cast<BinaryTileTask&>(*task).rawTileData = std::make_shared<RawData>(std::move(_data));
+    return task;
+}
+
+}
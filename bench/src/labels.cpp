@@ -0,0 +1,130 @@
+#include "tangram.h"
+#include "platform_mock.h"
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "labels/label.h"
+#include "labels/labelCollider.h"
+#include "labels/labels.h"
+#include "labels/labelSet.h"
+#include "marker/marker.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileCache.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include "fixtures.h"
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Scene with the fixture labels and points and the parsed fixture tile of @_features
+struct LabelContext {
+
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<TileSource> source;
+    std::shared_ptr<TileData> tileData;
+
+    LabelContext(int _features) {
+        scene = Fixtures::loadScene(platform, Fixtures::scene("MVT", { "pois", "labels" }));
+        if (!scene) { return; }
+
+        source = scene->tileSources().front();
+        auto task = Fixtures::task(*source, Fixtures::mvt(_features));
+        tileData = source->parse(*task, *scene->mapProjection());
+    }
+
+    bool ready() const { return tileData != nullptr; }
+};
+
+static void BM_Tangram_CollideLabels(benchmark::State& state) {
+    LabelContext context(state.range(0));
+    if (!context.ready()) {
+        state.SkipWithError("Could not load the fixture scene or tile");
+        return;
+    }
+
+    // Keep the labels that the collider of the tile builder occludes
+    setDebugFlag(DebugFlags::draw_all_labels, true);
+    TileBuilder builder(context.scene);
+    auto tile = builder.build(Fixtures::tileID, *context.tileData, *context.source);
+    setDebugFlag(DebugFlags::draw_all_labels, false);
+
+    std::vector<std::vector<std::unique_ptr<Label>>*> labelSets;
+    size_t labelCount = 0;
+    for (const auto& style : context.scene->styles()) {
+        if (auto* labelSet = dynamic_cast<LabelSet*>(tile->getMesh(*style).get())) {
+            labelSets.push_back(&labelSet->getLabels());
+            labelCount += labelSet->getLabels().size();
+        }
+    }
+
+    float tileSize = context.scene->mapProjection()->TileSize() * context.scene->pixelScale();
+    LabelCollider collider;
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        for (auto* labels : labelSets) {
+            for (auto& label : *labels) {
+                label->occlude(false);
+                label->enterState(Label::State::none, 0.f);
+            }
+        }
+        state.ResumeTiming();
+
+        for (auto* labels : labelSets) {
+            collider.addLabels(*labels);
+        }
+        collider.process(Fixtures::tileID, tile->getInverseScale(), tileSize);
+    }
+
+    state.SetItemsProcessed(state.iterations() * labelCount);
+}
+BENCHMARK(BM_Tangram_CollideLabels)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+// Place the labels of 3x3 fixture tiles around the fixture tile at zoom
+// state.range(0) and pitch state.range(1) degrees
+static void BM_Tangram_UpdateLabelSet(benchmark::State& state) {
+    LabelContext context(Fixtures::medium);
+    if (!context.ready()) {
+        state.SkipWithError("Could not load the fixture scene or tile");
+        return;
+    }
+
+    TileBuilder builder(context.scene);
+    std::vector<std::shared_ptr<Tile>> tiles;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            TileID id(Fixtures::tileID.x + x, Fixtures::tileID.y + y, Fixtures::tileID.z);
+            tiles.push_back(builder.build(id, *context.tileData, *context.source));
+        }
+    }
+
+    View view(1920, 1080);
+    const auto& tileID = Fixtures::tileID;
+    view.setPosition(view.getMapProjection().LonLatToMeters({ Fixtures::tileLon(tileID.x + 0.5),
+                                                              Fixtures::tileLat(tileID.y + 0.5) }));
+    view.setZoom(state.range(0));
+    view.setPitch(state.range(1) * M_PI / 180.0);
+    view.update();
+
+    for (auto& tile : tiles) { tile->update(0, view); }
+
+    Labels labels;
+    TileCache cache(0);
+    std::vector<std::unique_ptr<Marker>> markers;
+
+    while (state.KeepRunning()) {
+        labels.updateLabelSet(view.state(), 0.016f, context.scene->styles(), tiles, markers, cache);
+    }
+}
+BENCHMARK(BM_Tangram_UpdateLabelSet)->ArgPair(14, 0)->ArgPair(15, 0)->ArgPair(16, 0)->ArgPair(15, 60);
+
+BENCHMARK_MAIN();
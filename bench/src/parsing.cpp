@@ -0,0 +1,57 @@
+#include "tangram.h"
+#include "platform_mock.h"
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "util/mapProjection.h"
+
+#include "fixtures.h"
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Parse the fixture tile of state.range(0) features, as encoded by @_encode
+static void parseTile(benchmark::State& state, const std::string& _type,
+                      std::vector<char> (*_encode)(int)) {
+
+    auto platform = std::make_shared<MockPlatform>();
+    auto scene = Fixtures::loadScene(platform, Fixtures::scene(_type));
+    if (!scene) {
+        state.SkipWithError("Could not load the fixture scene");
+        return;
+    }
+
+    auto& source = *scene->tileSources().front();
+    auto data = _encode(state.range(0));
+    size_t bytes = data.size();
+    auto task = Fixtures::task(source, std::move(data));
+
+    while (state.KeepRunning()) {
+        auto tileData = source.parse(*task, *scene->mapProjection());
+        benchmark::DoNotOptimize(tileData);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+static void BM_Tangram_ParseMVT(benchmark::State& state) {
+    parseTile(state, "MVT", Fixtures::mvt);
+}
+BENCHMARK(BM_Tangram_ParseMVT)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+static void BM_Tangram_ParseGeoJSON(benchmark::State& state) {
+    parseTile(state, "GeoJSON", Fixtures::geoJson);
+}
+BENCHMARK(BM_Tangram_ParseGeoJSON)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+static void BM_Tangram_ParseTopoJSON(benchmark::State& state) {
+    parseTile(state, "TopoJSON", Fixtures::topoJson);
+}
+BENCHMARK(BM_Tangram_ParseTopoJSON)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+BENCHMARK_MAIN();
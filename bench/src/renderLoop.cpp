@@ -0,0 +1,317 @@
+// Render loop benchmark
+//
+// Drives Map::update and Map::render along scripted camera paths without a GPU,
+// with the GL and platform mocks. The tiles are served from a directory of
+// fixture tiles which is created in the working directory. Frames are paced
+// at a fixed time step, so that the tile workers get the same time per frame
+// as in an application.
+//
+// For each path the update times, the label placement time, the tile requests
+// per second and the GL calls per frame are reported. Use
+// --benchmark_out=<file> to also write them as Google Benchmark JSON.
+
+#include "tangram.h"
+#include "gl_mock.h"
+#include "platform_mock.h"
+
+#include "fixtures.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Tangram;
+
+// Counts the tile requests, which are all served from the fixture directory
+class FixturePlatform : public MockUrlPlatform {
+
+public:
+
+    FixturePlatform() { serveFiles = true; }
+
+    bool startUrlRequest(const std::string& _url, UrlCallback _callback) override {
+        requests++;
+        return MockUrlPlatform::startUrlRequest(_url, std::move(_callback));
+    }
+
+    std::atomic<size_t> requests{0};
+};
+
+struct CameraPath {
+    std::string name;
+    // Number of scripted frames
+    int frames;
+    // Called before frame @_frame
+    std::function<void(Map& _map, int _frame)> step;
+};
+
+struct PathResult {
+    std::string name;
+    int frames = 0;
+    float seconds = 0;
+    // Percentiles of the update time in ms
+    float updateP50 = 0, updateP90 = 0, updateP99 = 0, updateMax = 0;
+    // Mean times of a frame in ms
+    float labelTime = 0;
+    float renderTime = 0;
+    // Tile data URL requests, tiles reloaded from a cache are not counted
+    float requestsPerSecond = 0;
+    // Means per frame
+    float glCalls = 0;
+    float drawCalls = 0;
+};
+
+const int viewWidth = 1024;
+const int viewHeight = 768;
+const float frameTime = 1.f / 60.f;
+// Frames after the scripted ones to wait for the view to complete
+const int maxSettleFrames = 600;
+// Zoom levels and tile radius around the center covered by the fixture directory
+const int minFixtureZoom = 12;
+const int maxFixtureZoom = 16;
+const int fixtureRadius = 4;
+
+static bool makeDirectory(const std::string& _path) {
+    return mkdir(_path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+// Write the fixture tile to all tiles of the fixture directory at @_dir
+static bool writeFixtures(const std::string& _dir) {
+
+    auto tile = Fixtures::mvt(Fixtures::medium);
+    const auto& center = Fixtures::tileID;
+
+    if (!makeDirectory(_dir)) { return false; }
+
+    for (int z = minFixtureZoom; z <= maxFixtureZoom; z++) {
+        double scale = std::pow(2.0, z - center.z);
+        int cx = (center.x + 0.5) * scale;
+        int cy = (center.y + 0.5) * scale;
+
+        std::string zdir = _dir + "/" + std::to_string(z);
+        if (!makeDirectory(zdir)) { return false; }
+
+        for (int x = cx - fixtureRadius; x <= cx + fixtureRadius; x++) {
+            std::string xdir = zdir + "/" + std::to_string(x);
+            if (!makeDirectory(xdir)) { return false; }
+
+            for (int y = cy - fixtureRadius; y <= cy + fixtureRadius; y++) {
+                std::string path = xdir + "/" + std::to_string(y) + ".mvt";
+
+                struct stat info;
+                if (stat(path.c_str(), &info) == 0 && size_t(info.st_size) == tile.size()) { continue; }
+
+                std::ofstream file(path, std::ios::binary);
+                file.write(tile.data(), tile.size());
+                if (!file) { return false; }
+            }
+        }
+    }
+    return true;
+}
+
+static float percentile(std::vector<float> _values, float _p) {
+    if (_values.empty()) { return 0; }
+    std::sort(_values.begin(), _values.end());
+    size_t i = std::min(_values.size() - 1, size_t(_p * _values.size()));
+    return _values[i];
+}
+
+// Move the camera back to the center of the fixtures and wait until its tiles are loaded
+static void resetCamera(Map& _map) {
+    const auto& center = Fixtures::tileID;
+    _map.setPosition(Fixtures::tileLon(center.x + 0.5), Fixtures::tileLat(center.y + 0.5));
+    _map.setZoom(15);
+    _map.setTilt(0);
+    _map.setRotation(0);
+
+    for (int i = 0; i < maxSettleFrames; i++) {
+        bool complete = _map.update(frameTime);
+        _map.render();
+        if (complete) { break; }
+        std::this_thread::sleep_for(std::chrono::duration<float>(frameTime));
+    }
+}
+
+static PathResult runPath(Map& _map, FixturePlatform& _platform, const CameraPath& _path) {
+
+    using clock = std::chrono::steady_clock;
+
+    resetCamera(_map);
+
+    PathResult result;
+    result.name = _path.name;
+
+    std::vector<float> updateTimes;
+    float labelTime = 0, renderTime = 0, drawCalls = 0;
+    uint64_t lastFrame = 0;
+
+    size_t requests = _platform.requests;
+    GLMock::resetCalls();
+
+    auto start = clock::now();
+    auto deadline = start;
+
+    for (int frame = 0; frame < _path.frames + maxSettleFrames; frame++) {
+        if (frame < _path.frames) { _path.step(_map, frame); }
+
+        bool complete = _map.update(frameTime);
+        _map.render();
+
+        FrameStats stats;
+        if (_map.getFrameStats(stats) && stats.frame != lastFrame) {
+            lastFrame = stats.frame;
+            updateTimes.push_back(stats.updateTime);
+            labelTime += stats.labelTime;
+            renderTime += stats.renderTime;
+            drawCalls += stats.drawCalls;
+        }
+        result.frames++;
+
+        if (frame >= _path.frames && complete) { break; }
+
+        deadline += std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(frameTime));
+        std::this_thread::sleep_until(deadline);
+    }
+
+    result.seconds = std::chrono::duration<float>(clock::now() - start).count();
+
+    size_t frames = std::max<size_t>(1, updateTimes.size());
+    result.updateP50 = percentile(updateTimes, 0.5f);
+    result.updateP90 = percentile(updateTimes, 0.9f);
+    result.updateP99 = percentile(updateTimes, 0.99f);
+    result.updateMax = percentile(updateTimes, 1.f);
+    result.labelTime = labelTime / frames;
+    result.renderTime = renderTime / frames;
+    result.drawCalls = drawCalls / frames;
+    result.glCalls = float(GLMock::calls()) / result.frames;
+    result.requestsPerSecond = (_platform.requests - requests) / result.seconds;
+
+    return result;
+}
+
+static std::vector<CameraPath> cameraPaths() {
+
+    const float cx = viewWidth / 2.f;
+    const float cy = viewHeight / 2.f;
+
+    return {
+        { "pan", 180, [=](Map& _map, int _frame) {
+            _map.handlePanGesture(cx, cy, cx - 3, cy);
+        }},
+        { "fling", 120, [=](Map& _map, int _frame) {
+            if (_frame == 0) { _map.handleFlingGesture(cx, cy, -1500, -500); }
+        }},
+        { "zoom_in", 150, [=](Map& _map, int _frame) {
+            if (_frame == 0) { _map.setZoomEased(17, 2.f); }
+        }},
+        { "zoom_out", 150, [=](Map& _map, int _frame) {
+            if (_frame == 0) { _map.setZoomEased(13, 2.f); }
+        }},
+        { "tilt", 150, [=](Map& _map, int _frame) {
+            if (_frame == 0) { _map.setTiltEased(60 * M_PI / 180, 2.f); }
+        }},
+    };
+}
+
+static void writeJson(const std::string& _path, const std::vector<PathResult>& _results) {
+
+    FILE* file = fopen(_path.c_str(), "w");
+    if (!file) {
+        LOGE("Cannot write benchmark results to '%s'", _path.c_str());
+        return;
+    }
+
+    // The layout of Google Benchmark, with the median update time as 'real_time'.
+    // CPU time is not measured and left out.
+    fprintf(file, "{\n  \"context\": {\n    \"executable\": \"renderLoop.out\"\n  },\n  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < _results.size(); i++) {
+        const auto& r = _results[i];
+        fprintf(file,
+                "    {\n"
+                "      \"name\": \"BM_Tangram_RenderLoop/%s\",\n"
+                "      \"iterations\": %d,\n"
+                "      \"real_time\": %f,\n"
+                "      \"time_unit\": \"ms\",\n"
+                "      \"update_p50\": %f,\n"
+                "      \"update_p90\": %f,\n"
+                "      \"update_p99\": %f,\n"
+                "      \"update_max\": %f,\n"
+                "      \"label_time\": %f,\n"
+                "      \"render_time\": %f,\n"
+                "      \"requests_per_second\": %f,\n"
+                "      \"gl_calls\": %f,\n"
+                "      \"draw_calls\": %f\n"
+                "    }%s\n",
+                r.name.c_str(), r.frames, r.updateP50,
+                r.updateP50, r.updateP90, r.updateP99, r.updateMax,
+                r.labelTime, r.renderTime, r.requestsPerSecond, r.glCalls, r.drawCalls,
+                i + 1 < _results.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+}
+
+int main(int argc, char** argv) {
+
+    std::string out;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 16, "--benchmark_out=") == 0) { out = arg.substr(16); }
+    }
+
+    char cwd[1024];
+    if (!getcwd(cwd, sizeof(cwd))) { return 1; }
+    std::string dir = std::string(cwd) + "/fixtures";
+
+    if (!writeFixtures(dir)) {
+        LOGE("Cannot write fixture tiles to '%s'", dir.c_str());
+        return 1;
+    }
+
+    std::string scenePath = dir + "/scene.yaml";
+    {
+        std::ofstream scene(scenePath);
+        scene << Fixtures::scene("MVT", { "buildings", "roads", "pois", "labels" }, dir + "/{z}/{x}/{y}.mvt");
+    }
+
+    // Let shaders compile and framebuffers complete, so that the render path runs
+    GLMock::setAcceptAll(true);
+
+    auto platform = std::make_shared<FixturePlatform>();
+    Map map(platform);
+    map.loadScene(scenePath.c_str());
+    map.setupGL();
+    map.resize(viewWidth, viewHeight);
+    map.useFrameStats(true);
+
+    std::vector<PathResult> results;
+    for (const auto& path : cameraPaths()) {
+        results.push_back(runPath(map, *platform, path));
+    }
+
+    printf("%-10s %7s %9s %9s %9s %9s %9s %9s %9s %9s\n", "path", "frames", "upd p50", "upd p90",
+           "upd p99", "label", "render", "req/s", "gl calls", "draws");
+    for (const auto& r : results) {
+        printf("%-10s %7d %9.3f %9.3f %9.3f %9.3f %9.3f %9.1f %9.1f %9.1f\n", r.name.c_str(), r.frames,
+               r.updateP50, r.updateP90, r.updateP99, r.labelTime, r.renderTime, r.requestsPerSecond,
+               r.glCalls, r.drawCalls);
+    }
+
+    if (!out.empty()) { writeJson(out, results); }
+
+    return 0;
+}
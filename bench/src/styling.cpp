@@ -0,0 +1,153 @@
+#include "tangram.h"
+#include "platform_mock.h"
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "scene/dataLayer.h"
+#include "scene/drawRule.h"
+#include "scene/filters.h"
+#include "scene/layerIndex.h"
+#include "scene/scene.h"
+#include "scene/styleContext.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "util/mapProjection.h"
+
+#include "fixtures.h"
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Scene with the fixture @_layers and the parsed fixture tile of @_features
+struct StylingContext {
+
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<TileSource> source;
+    std::shared_ptr<TileData> tileData;
+
+    StylingContext(const std::vector<std::string>& _layers, int _features) {
+        scene = Fixtures::loadScene(platform, Fixtures::scene("MVT", _layers));
+        if (!scene) { return; }
+
+        source = scene->tileSources().front();
+        auto task = Fixtures::task(*source, Fixtures::mvt(_features));
+        tileData = source->parse(*task, *scene->mapProjection());
+    }
+
+    bool ready() const { return tileData != nullptr; }
+
+    // Call @_fn for each feature of the tile with each data layer it belongs to
+    template<typename F>
+    void forEachFeature(F _fn) const {
+        for (const auto& collection : tileData->layers) {
+            for (auto* layer : scene->layerIndex().layers(source->name(), collection.name)) {
+                for (const auto& feature : collection.features) {
+                    _fn(feature, *layer);
+                }
+            }
+        }
+    }
+};
+
+static const std::vector<std::string> allLayers = { "buildings", "roads", "pois", "labels" };
+
+// Number of layers of the subtree @_layer with a filter matching @_feature
+static int matchFilters(const SceneLayer& _layer, const Feature& _feature, StyleContext& _ctx) {
+    if (!_layer.filter().eval(_feature, _ctx)) { return 0; }
+
+    int matches = 1;
+    for (const auto& sublayer : _layer.sublayers()) {
+        matches += matchFilters(sublayer, _feature, _ctx);
+    }
+    return matches;
+}
+
+static void BM_Tangram_MatchFilters(benchmark::State& state) {
+    StylingContext context(allLayers, state.range(0));
+    if (!context.ready()) {
+        state.SkipWithError("Could not load the fixture scene or tile");
+        return;
+    }
+
+    StyleContext ctx;
+    ctx.initFunctions(*context.scene);
+    ctx.setKeywordZoom(Fixtures::tileID.z);
+
+    while (state.KeepRunning()) {
+        int matches = 0;
+        context.forEachFeature([&](const Feature& _feature, const DataLayer& _layer) {
+            ctx.setFeature(_feature);
+            matches += matchFilters(_layer, _feature, ctx);
+        });
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Tangram_MatchFilters)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+static void BM_Tangram_MergeDrawRules(benchmark::State& state) {
+    StylingContext context(allLayers, state.range(0));
+    if (!context.ready()) {
+        state.SkipWithError("Could not load the fixture scene or tile");
+        return;
+    }
+
+    StyleContext ctx;
+    ctx.initFunctions(*context.scene);
+    ctx.setKeywordZoom(Fixtures::tileID.z);
+
+    DrawRuleMergeSet ruleSet;
+
+    while (state.KeepRunning()) {
+        int rules = 0;
+        context.forEachFeature([&](const Feature& _feature, const DataLayer& _layer) {
+            if (!ruleSet.match(_feature, _layer, ctx)) { return; }
+
+            for (auto& rule : ruleSet.matchedRules()) {
+                rules += ruleSet.evaluateRuleForContext(rule, ctx);
+            }
+        });
+        benchmark::DoNotOptimize(rules);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Tangram_MergeDrawRules)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+// Build the fixture tile with only the fixture layer @_layer, i.e. with one style builder
+static void buildTile(benchmark::State& state, const std::string& _layer) {
+    StylingContext context({ _layer }, state.range(0));
+    if (!context.ready()) {
+        state.SkipWithError("Could not load the fixture scene or tile");
+        return;
+    }
+
+    TileBuilder builder(context.scene);
+
+    while (state.KeepRunning()) {
+        auto tile = builder.build(Fixtures::tileID, *context.tileData, *context.source);
+        benchmark::DoNotOptimize(tile);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Tangram_BuildPolygons(benchmark::State& state) { buildTile(state, "buildings"); }
+BENCHMARK(BM_Tangram_BuildPolygons)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+static void BM_Tangram_BuildLines(benchmark::State& state) { buildTile(state, "roads"); }
+BENCHMARK(BM_Tangram_BuildLines)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+static void BM_Tangram_BuildPoints(benchmark::State& state) { buildTile(state, "pois"); }
+BENCHMARK(BM_Tangram_BuildPoints)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+// Includes text shaping and glyph atlas updates of the road and poi names
+static void BM_Tangram_BuildText(benchmark::State& state) { buildTile(state, "labels"); }
+BENCHMARK(BM_Tangram_BuildText)->Arg(Fixtures::sparse)->Arg(Fixtures::medium)->Arg(Fixtures::dense);
+
+BENCHMARK_MAIN();
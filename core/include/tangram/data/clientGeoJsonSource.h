@@ -3,6 +3,7 @@
 #include "data/tileSource.h"
 #include "util/types.h"
 
+#include <atomic>
 #include <mutex>
 
 class Platform;
@@ -10,15 +11,13 @@ class Platform;
 namespace mapbox {
 namespace util {
 namespace geojsonvt {
-class GeoJSONVT;
 class TilePoint;
 class ProjectedFeature;
 }}}
 
 namespace Tangram {
 
-using GeoJSONVT = mapbox::util::geojsonvt::GeoJSONVT;
-
+class ClientTileIndex;
 struct Properties;
 
 class ClientGeoJsonSource : public TileSource {
@@ -32,8 +31,10 @@ public:
     // http://www.iana.org/assignments/media-types/application/geo+json
     virtual const char* mimeType() override { return "application/geo+json"; };
 
-    // after this is called, any call to add*() and clearData() will not take effect
-    // until commitChangeBlock() is called
+    using FeatureID = uint64_t;
+
+    // after this is called, any call to add*(), updateFeature(), removeFeature()
+    // and clearData() will not take effect until endChangeBlock() is called
     void beginChangeBlock();
 
     // commits changes after beginChangeBlock() was called
@@ -41,9 +42,20 @@ public:
 
     // Add geometry from a GeoJSON string
     void addData(const std::string& _data);
-    void addPoint(const Properties& _tags, LngLat _point);
-    void addLine(const Properties& _tags, const Coordinates& _line);
-    void addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    // Add a feature, returning its ID. The ID is also set as Properties::featureId
+    // of the feature in tile data and selection results.
+    FeatureID addPoint(const Properties& _tags, LngLat _point);
+    FeatureID addLine(const Properties& _tags, const Coordinates& _line);
+    FeatureID addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    // Replace properties and geometry of the feature with @_id; has no effect
+    // when the feature does not exist (anymore)
+    void updateFeature(FeatureID _id, const Properties& _tags, LngLat _point);
+    void updateFeature(FeatureID _id, const Properties& _tags, const Coordinates& _line);
+    void updateFeature(FeatureID _id, const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    void removeFeature(FeatureID _id);
 
     virtual void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override;
     std::shared_ptr<TileTask> createTask(TileID _tileId, int _subTask) override;
@@ -51,14 +63,29 @@ public:
     virtual void cancelLoadingTile(const TileID& _tile) override {};
     virtual void clearData() override;
 
+    // Only tiles which contain changed features are invalidated by updates
+    virtual int64_t tileGeneration(const TileID& _tile) const override;
+
 protected:
 
     virtual std::shared_ptr<TileData> parse(const TileTask& _task,
                                             const MapProjection& _projection) const override;
 
-    std::unique_ptr<GeoJSONVT> m_store;
+    struct Change;
+
+    void applyChange(Change&& _change);
+
+    // Apply changes made within a change block to m_index
+    void commitChanges();
+
+    std::unique_ptr<ClientTileIndex> m_index;
+
+    // Guards the pending changes
     mutable std::mutex m_mutexStore;
-    std::vector<mapbox::util::geojsonvt::ProjectedFeature> m_features;
+    std::vector<Change> m_pendingChanges;
+    bool m_pendingClear = false;
+    std::atomic<FeatureID> m_nextFeatureId{1};
+
     bool m_hasPendingData = false;
 
      std::shared_ptr<Platform> m_platform;
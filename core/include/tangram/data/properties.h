@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,9 @@ struct Properties {
 
     int32_t sourceId;
 
+    // ID of the feature within its source; 0 when the source provides none
+    uint64_t featureId = 0;
+
     static bool keyComparator(const std::string& a, const std::string& b) {
         if (a.size() == b.size()) {
             return a < b;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+/* Read-only raw bytes of a tile
+ *
+ * The bytes are either owned in a vector or a view of memory which is kept
+ * alive by an owner, e.g. a memory-mapped file. Parsers read the bytes in
+ * place in both cases.
+ */
+class RawData {
+
+public:
+
+    RawData() {}
+
+    explicit RawData(std::vector<char>&& _data)
+        : m_buffer(std::move(_data)),
+          m_data(m_buffer.data()),
+          m_size(m_buffer.size()) {}
+
+    /* View of @_size bytes at @_data which are valid as long as @_owner lives */
+    RawData(const char* _data, size_t _size, std::shared_ptr<const void> _owner)
+        : m_owner(std::move(_owner)),
+          m_data(_data),
+          m_size(_size) {}
+
+    RawData(const RawData&) = delete;
+    RawData& operator=(const RawData&) = delete;
+
+    /* Map the file at @_path into memory. Small files are read instead.
+     * Returns nullptr when the file cannot be read. */
+    static std::shared_ptr<RawData> mapFile(const std::string& _path);
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /* Whether the bytes are a view of memory owned elsewhere, e.g. a mapped file */
+    bool isView() const { return bool(m_owner); }
+
+private:
+
+    std::vector<char> m_buffer;
+    std::shared_ptr<const void> m_owner;
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+}
@@ -15,7 +15,6 @@ struct TileID;
 struct Raster;
 class Tile;
 class TileManager;
-struct RawCache;
 class Texture;
 
 class TileSource : public std::enable_shared_from_this<TileSource> {
@@ -34,6 +33,12 @@ public:
 
         virtual void clear() { if (next) next->clear(); }
 
+        /* Key that identifies the data of @_tile across sources, e.g. its URL.
+         * Empty when the data cannot be shared. */
+        virtual std::string cacheKey(const TileID& _tile) const {
+            return next ? next->cacheKey(_tile) : "";
+        }
+
         void setNext(std::unique_ptr<DataSource> _next) {
             next = std::move(_next);
             next->level = level + 1;
@@ -71,6 +76,11 @@ public:
     /* Parse a <TileTask> with data into a <TileData>, returning an empty TileData on failure */
     virtual std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const = 0;
 
+    /* Parse @_task like parse(), reusing recent results for tiles at the max zoom
+     * of this source: Overzoomed tiles are built from the same data tile for each
+     * styling zoom, so the TileData is parsed only once for all of them. */
+    std::shared_ptr<TileData> parseTile(const TileTask& _task, const MapProjection& _projection);
+
     /* Clears all data associated with this TileSource */
     virtual void clearData();
 
@@ -89,6 +99,10 @@ public:
     /* Generation ID of TileSource state (incremented for each update, e.g. on clearData()) */
     int64_t generation() const { return m_generation; }
 
+    /* Generation of the last update which affects the data of @_tile. A tile
+     * built at generation() needs to be reloaded when this is greater. */
+    virtual int64_t tileGeneration(const TileID& _tile) const { return m_generation; }
+
     int32_t minDisplayZoom() const { return m_minDisplayZoom; }
     int32_t maxDisplayZoom() const { return m_maxDisplayZoom; }
     int32_t maxZoom() const { return m_maxZoom; }
@@ -143,6 +157,18 @@ protected:
     std::vector<std::shared_ptr<TileSource>> m_rasterSources;
 
     std::unique_ptr<DataSource> m_sources;
+
+private:
+
+    struct ParsedTile {
+        TileID tileID;
+        int64_t generation;
+        std::shared_ptr<TileData> data;
+    };
+
+    // Recently parsed data tiles at max zoom, most recent last
+    std::vector<ParsedTile> m_parsedTiles;
+    std::mutex m_parsedTilesMutex;
 };
 
 }
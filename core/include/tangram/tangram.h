@@ -58,6 +58,35 @@ struct MarkerPickResult {
 // Returns a pointer to the selected marker pick result or null, only valid on the callback scope
 using MarkerPickCallback = std::function<void(const MarkerPickResult*)>;
 
+// Statistics of one update and render of a Map. Times are wall-clock milliseconds,
+// GPU times are negative where timer queries are not supported.
+struct FrameStats {
+    struct StyleStats {
+        std::string name;
+        // Time to submit the draw calls of the style
+        float cpuTime = 0;
+        // Time of the GPU to execute them
+        float gpuTime = -1;
+        uint32_t drawCalls = 0;
+        uint32_t vertices = 0;
+    };
+
+    // Number of the frame since the stats were enabled
+    uint64_t frame = 0;
+    float updateTime = 0;
+    // Part of the update time spent placing labels
+    float labelTime = 0;
+    float renderTime = 0;
+    // Sum of the GPU times of the styles
+    float gpuTime = -1;
+    uint32_t tilesDrawn = 0;
+    // Totals of the frame, including the selection pass
+    uint32_t drawCalls = 0;
+    uint32_t vertices = 0;
+    size_t uploadBytes = 0;
+    std::vector<StyleStats> styles;
+};
+
 struct SceneUpdate {
     std::string path;
     std::string value;
@@ -204,6 +233,11 @@ public:
     // the marker will not be drawn until both styling and geometry are set using the functions below.
     MarkerID markerAdd();
 
+    // Add a point marker for each of the _count LngLats in _coordinates, all styled with _styling;
+    // the styling is parsed once and shared by the new markers; returns the IDs of the markers in
+    // the order of _coordinates, or no IDs if the styling is invalid.
+    std::vector<MarkerID> markerAddPoints(const char* _styling, const LngLat* _coordinates, int _count);
+
     // Remove a marker object from the map; returns true if the marker ID was found and successfully
     // removed, otherwise returns false.
     bool markerRemove(MarkerID _marker);
@@ -281,9 +315,35 @@ public:
     // efficiency, but can cause errors if your application code makes OpenGL calls (false by default)
     void useCachedGlState(bool _use);
 
+    // Set the size in bytes of the cache for downloaded tile data. The cache is shared by all
+    // tile sources and Map instances of the process (32MB by default), where each source used
+    // to have its own cache of 16MB. Memory-mapped local tile files are not cached.
+    void setTileDataCacheSize(size_t _bytes);
+
     // Set the radius in logical pixels to use when picking features on the map (default is 0.5).
     void setPickRadius(float _radius);
 
+    // Set whether features and labels are picked with spatial indexes built for the 'interactive'
+    // features of each tile instead of rendering the selection buffer and reading back its pixels
+    // (false by default); this avoids stalling the GPU on each pick, e.g. when picking on hover.
+    // Lines and points are matched within the pick radius of their geometry, regardless of their
+    // styled width or size. Markers are always picked with the selection buffer.
+    void useFeatureIndex(bool _use);
+
+    // Set whether picking reads the selection buffer through pixel buffer objects without waiting
+    // for the GPU (false by default); pick callbacks are then called one or more frames after the
+    // selection pass. Falls back to blocking reads where pixel buffer objects are not supported.
+    void useAsyncPicking(bool _use);
+
+    // Set whether statistics of each update and render are collected (false by default); GPU
+    // times are measured with timer queries where supported, which adds a few frames of latency
+    // until the stats of a frame can be read.
+    void useFrameStats(bool _use);
+
+    // Get the statistics of the latest frame whose stats are complete; returns false if there
+    // is none, e.g. when useFrameStats is off. Can be called from any thread.
+    bool getFrameStats(FrameStats& _stats);
+
     // Create a query to select a feature marked as 'interactive'. The query runs on the next frame.
     // Calls _onFeaturePickCallback once the query has completed, and returns the FeaturePickResult
     // with its associated properties or null if no feature was found.
@@ -337,4 +397,15 @@ bool getDebugFlag(DebugFlags _flag);
 // Toggle the boolean state of a debug feature (see debug.h)
 void toggleDebugFlag(DebugFlags _flag);
 
+// Set whether spans of the tile pipeline (download, parsing, styling, label layout, mesh upload
+// and label placement) are recorded by all threads of the process (false by default)
+void setTracing(bool _on);
+
+// Get the spans recorded since tracing was enabled or the last call to clearTrace, as Chrome
+// trace-event JSON (load it in chrome://tracing); only the latest spans of each thread are kept
+std::string getTraceJson();
+
+// Drop the recorded spans
+void clearTrace();
+
 }
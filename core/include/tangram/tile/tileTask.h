@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/rawData.h"
 #include "tile/tileID.h"
 
 #include <atomic>
@@ -115,7 +116,7 @@ public:
         return rawTileData && !rawTileData->empty();
     }
     // Raw tile data that will be processed by TileSource.
-    std::shared_ptr<std::vector<char>> rawTileData;
+    std::shared_ptr<RawData> rawTileData;
 
     bool dataFromCache = false;
 };
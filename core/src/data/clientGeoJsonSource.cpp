@@ -1,4 +1,5 @@
 #include "data/clientGeoJsonSource.h"
+#include "data/clientTileIndex.h"
 #define GEOJSONVT_CUSTOM_TAGS
 #include "mapbox/geojsonvt/geojsonvt_types.hpp"
 #include "mapbox/geojsonvt/geojsonvt.hpp"
@@ -22,6 +23,15 @@ const double extent = 4096;
 const uint32_t indexMaxPoints = 100000;
 double tolerance = 1E-8;
 
+struct ClientGeoJsonSource::Change {
+    enum Type { add, update, remove };
+
+    Type type;
+    FeatureID id;
+    // Unset for 'remove'
+    std::unique_ptr<geojsonvt::ProjectedFeature> feature;
+};
+
 std::shared_ptr<TileTask> ClientGeoJsonSource::createTask(TileID _tileId, int _subTask) {
     return std::make_shared<TileTask>(_tileId, shared_from_this(), _subTask);
 }
@@ -36,6 +46,8 @@ ClientGeoJsonSource::ClientGeoJsonSource(std::shared_ptr<Platform> _platform, co
                                          int32_t _minDisplayZoom, int32_t _maxDisplayZoom, int32_t _maxZoom)
     : TileSource(_name, nullptr, _minDisplayZoom, _maxDisplayZoom, _maxZoom), m_platform(_platform) {
 
+    m_index = std::make_unique<ClientTileIndex>(m_maxZoom, indexMaxPoints, tolerance);
+
     // TODO: handle network url for client datasource data
     // TODO: generic uri handling
     m_generateGeometry = true;
@@ -60,33 +72,114 @@ ClientGeoJsonSource::ClientGeoJsonSource(std::shared_ptr<Platform> _platform, co
 
 ClientGeoJsonSource::~ClientGeoJsonSource() {}
 
+static std::unique_ptr<geojsonvt::ProjectedFeature> createPoint(const Properties& _tags, LngLat _point) {
+
+    auto container = geojsonvt::Convert::project({ geojsonvt::LonLat(_point.longitude, _point.latitude) }, tolerance);
+
+    return std::make_unique<geojsonvt::ProjectedFeature>(
+        geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
+                                   geojsonvt::ProjectedFeatureType::Point,
+                                   container.members));
+}
+
+static std::unique_ptr<geojsonvt::ProjectedFeature> createLine(const Properties& _tags, const Coordinates& _line) {
+
+    auto& line = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_line);
+
+    std::vector<geojsonvt::ProjectedGeometry> geometry = { geojsonvt::Convert::project(line, tolerance) };
+
+    return std::make_unique<geojsonvt::ProjectedFeature>(
+        geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
+                                   geojsonvt::ProjectedFeatureType::LineString,
+                                   geometry));
+}
+
+static std::unique_ptr<geojsonvt::ProjectedFeature> createPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
+
+    geojsonvt::ProjectedGeometryContainer geometry;
+    for (auto& _ring : _poly) {
+        auto& ring = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_ring);
+        geometry.members.push_back(geojsonvt::Convert::project(ring, tolerance));
+    }
+
+    return std::make_unique<geojsonvt::ProjectedFeature>(
+        geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
+                                   geojsonvt::ProjectedFeatureType::Polygon,
+                                   geometry));
+}
+
 void ClientGeoJsonSource::beginChangeBlock()
 {
     m_inChangeBlock = true;
 }
-  
+
 void ClientGeoJsonSource::endChangeBlock()
 {
     m_inChangeBlock = false;
 
+    commitChanges();
+}
+
+void ClientGeoJsonSource::commitChanges() {
+
     std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
 
+    if (m_pendingClear) {
+        m_index->clear();
+        m_pendingClear = false;
+    }
+
+    for (auto& change : m_pendingChanges) {
+        switch (change.type) {
+        case Change::add:
+            m_index->set(change.id, std::move(*change.feature));
+            break;
+        case Change::update:
+            m_index->update(change.id, std::move(*change.feature));
+            break;
+        case Change::remove:
+            m_index->remove(change.id);
+            break;
+        }
+    }
+    m_pendingChanges.clear();
+
+    m_generation = m_index->generation();
+}
+
+void ClientGeoJsonSource::applyChange(Change&& _change) {
+
+    if (_change.feature) {
+        // Let tile data and selection results refer to the feature
+        _change.feature->tags.map->featureId = _change.id;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStore);
+        m_pendingChanges.push_back(std::move(_change));
+    }
+
+    if (!m_inChangeBlock) {
+        commitChanges();
+    }
 }
-  
+
 void ClientGeoJsonSource::addData(const std::string& _data) {
 
     auto features = geojsonvt::GeoJSONVT::convertFeatures(_data);
 
-    for (auto& f : features) {
-        m_features.push_back(std::move(f));
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStore);
+        for (auto& f : features) {
+            FeatureID id = m_nextFeatureId++;
+            f.tags.map->featureId = id;
+            m_pendingChanges.push_back({ Change::add, id,
+                        std::make_unique<geojsonvt::ProjectedFeature>(std::move(f)) });
+        }
     }
 
-    if(!m_inChangeBlock) {
-      std::lock_guard<std::mutex> lock(m_mutexStore);
-      m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-      m_generation++;
+    if (!m_inChangeBlock) {
+        commitChanges();
     }
 }
 
@@ -108,139 +201,120 @@ void ClientGeoJsonSource::loadTileData(std::shared_ptr<TileTask> _task, TileTask
 
 void ClientGeoJsonSource::clearData() {
 
-    m_features.clear();
-
-    if(!m_inChangeBlock) {
-      std::lock_guard<std::mutex> lock(m_mutexStore);
-
-      m_store.reset();
-      m_generation++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStore);
+        m_pendingChanges.clear();
+        m_pendingClear = true;
     }
-}
-
-void ClientGeoJsonSource::addPoint(const Properties& _tags, LngLat _point) {
-
-    auto container = geojsonvt::Convert::project({ geojsonvt::LonLat(_point.longitude, _point.latitude) }, tolerance);
-
-    geojsonvt::Tags tags;
-
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::Point,
-                                              container.members);
 
-    m_features.push_back(std::move(feature));
-
-    if(!m_inChangeBlock) {
-      std::lock_guard<std::mutex> lock(m_mutexStore);
-      m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-      m_generation++;
+    if (!m_inChangeBlock) {
+        commitChanges();
     }
 }
 
-void ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _line) {
-    auto& line = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_line);
-
-    std::vector<geojsonvt::ProjectedGeometry> geometry = { geojsonvt::Convert::project(line, tolerance) };
-
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::LineString,
-                                              geometry);
+int64_t ClientGeoJsonSource::tileGeneration(const TileID& _tile) const {
+    return m_index->generation(_tile);
+}
 
-    m_features.push_back(std::move(feature));
+ClientGeoJsonSource::FeatureID ClientGeoJsonSource::addPoint(const Properties& _tags, LngLat _point) {
+    FeatureID id = m_nextFeatureId++;
+    applyChange({ Change::add, id, createPoint(_tags, _point) });
+    return id;
+}
 
-    if(!m_inChangeBlock) {
-      std::lock_guard<std::mutex> lock(m_mutexStore);
-      m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-      m_generation++;
-    }
+ClientGeoJsonSource::FeatureID ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _line) {
+    FeatureID id = m_nextFeatureId++;
+    applyChange({ Change::add, id, createLine(_tags, _line) });
+    return id;
 }
 
-void ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
+ClientGeoJsonSource::FeatureID ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
+    FeatureID id = m_nextFeatureId++;
+    applyChange({ Change::add, id, createPoly(_tags, _poly) });
+    return id;
+}
 
-    geojsonvt::ProjectedGeometryContainer geometry;
-    for (auto& _ring : _poly) {
-        auto& ring = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_ring);
-        geometry.members.push_back(geojsonvt::Convert::project(ring, tolerance));
-    }
+void ClientGeoJsonSource::updateFeature(FeatureID _id, const Properties& _tags, LngLat _point) {
+    applyChange({ Change::update, _id, createPoint(_tags, _point) });
+}
 
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::Polygon,
-                                              geometry);
+void ClientGeoJsonSource::updateFeature(FeatureID _id, const Properties& _tags, const Coordinates& _line) {
+    applyChange({ Change::update, _id, createLine(_tags, _line) });
+}
 
-    m_features.push_back(std::move(feature));
+void ClientGeoJsonSource::updateFeature(FeatureID _id, const Properties& _tags, const std::vector<Coordinates>& _poly) {
+    applyChange({ Change::update, _id, createPoly(_tags, _poly) });
+}
 
-    if(!m_inChangeBlock) {
-      std::lock_guard<std::mutex> lock(m_mutexStore);
-      m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-      m_generation++;
-    }
+void ClientGeoJsonSource::removeFeature(FeatureID _id) {
+    applyChange({ Change::remove, _id, nullptr });
 }
 
 std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
                                                      const MapProjection& _projection) const {
 
-    auto data = std::make_shared<TileData>();
+    if (m_index->empty()) { return nullptr; }
 
-    geojsonvt::Tile tile;
-    {
-        std::lock_guard<std::mutex> lock(m_mutexStore);
-        if (!m_store) { return nullptr; }
-        tile = m_store->getTile(_task.tileId().z, _task.tileId().x, _task.tileId().y);
-    }
+    std::vector<geojsonvt::Tile> tiles;
+    m_index->getTile(_task.tileId(), tiles);
 
     Layer layer(""); // empty name will skip filtering by 'collection'
 
-    for (auto& it : tile.features) {
+    for (auto& tile : tiles) {
+        for (auto& it : tile.features) {
 
-        Feature feat(m_id);
+            Feature feat(m_id);
 
-        const auto& geom = it.tileGeometry;
-        const auto type = it.type;
+            const auto& geom = it.tileGeometry;
+            const auto type = it.type;
 
-        switch (type) {
-            case geojsonvt::TileFeatureType::Point: {
-                feat.geometryType = GeometryType::points;
-                for (const auto& pt : geom) {
-                    const auto& point = pt.get<geojsonvt::TilePoint>();
-                    feat.points.push_back(transformPoint(point));
-                }
-                break;
-            }
-            case geojsonvt::TileFeatureType::LineString: {
-                feat.geometryType = GeometryType::lines;
-                for (const auto& r : geom) {
-                    Line line;
-                    for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
-                        line.push_back(transformPoint(pt));
+            switch (type) {
+                case geojsonvt::TileFeatureType::Point: {
+                    feat.geometryType = GeometryType::points;
+                    for (const auto& pt : geom) {
+                        const auto& point = pt.get<geojsonvt::TilePoint>();
+                        feat.points.push_back(transformPoint(point));
                     }
-                    feat.lines.emplace_back(std::move(line));
+                    break;
                 }
-                break;
-            }
-            case geojsonvt::TileFeatureType::Polygon: {
-                feat.geometryType = GeometryType::polygons;
-                for (const auto& r : geom) {
-                    Line line;
-                    for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
-                        line.push_back(transformPoint(pt));
+                case geojsonvt::TileFeatureType::LineString: {
+                    feat.geometryType = GeometryType::lines;
+                    for (const auto& r : geom) {
+                        Line line;
+                        for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
+                            line.push_back(transformPoint(pt));
+                        }
+                        feat.lines.emplace_back(std::move(line));
                     }
-                    // Polygons are in a flat list of rings, with ccw rings indicating
-                    // the beginning of a new polygon
-                    if (signedArea(line.begin(), line.end()) >= 0 || feat.polygons.empty()) {
-                        feat.polygons.emplace_back();
+                    break;
+                }
+                case geojsonvt::TileFeatureType::Polygon: {
+                    feat.geometryType = GeometryType::polygons;
+                    for (const auto& r : geom) {
+                        Line line;
+                        for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
+                            line.push_back(transformPoint(pt));
+                        }
+                        // Polygons are in a flat list of rings, with ccw rings indicating
+                        // the beginning of a new polygon
+                        if (signedArea(line.begin(), line.end()) >= 0 || feat.polygons.empty()) {
+                            feat.polygons.emplace_back();
+                        }
+                        feat.polygons.back().push_back(std::move(line));
                     }
-                    feat.polygons.back().push_back(std::move(line));
+                    break;
                 }
-                break;
+                default: break;
             }
-            default: break;
-        }
 
-        feat.props = *it.tags.map;
-        layer.features.emplace_back(std::move(feat));
+            feat.props = *it.tags.map;
+            feat.props.sourceId = m_id;
+            layer.features.emplace_back(std::move(feat));
 
+        }
     }
 
+    auto data = std::make_shared<TileData>();
     data->layers.emplace_back(std::move(layer));
 
     return data;
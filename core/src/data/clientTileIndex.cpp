@@ -0,0 +1,338 @@
+#include "data/clientTileIndex.h"
+#define GEOJSONVT_CUSTOM_TAGS
+#include "mapbox/geojsonvt/geojsonvt_types.hpp"
+#include "mapbox/geojsonvt/geojsonvt.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mapbox::util;
+
+namespace Tangram {
+
+// GeoJSONVT tile buffer relative to the tile extent
+const double tileBuffer = 64. / 4096.;
+
+// Deepest zoom of the grid cells
+const int32_t maxIndexZoom = 10;
+
+// Entries per level of TileGenerations before the level is collapsed
+const size_t maxLevelEntries = 1 << 16;
+
+static uint64_t tileKey(int64_t _x, int64_t _y) {
+    return (uint64_t(_x) << 32) | uint64_t(_y);
+}
+
+TileGenerations::TileGenerations(int32_t _maxZoom, double _buffer)
+    : m_levels(std::max(_maxZoom, 0) + 1), m_buffer(_buffer) {}
+
+int64_t TileGenerations::update(double _minX, double _minY, double _maxX, double _maxY) {
+
+    int64_t generation = ++m_generation;
+
+    if (_minX > _maxX || _minY > _maxY) { return generation; }
+
+    // Record the update at the deepest level at which it covers no more
+    // than four tiles, and as 'subtree' update of their ancestors.
+    for (int32_t z = m_levels.size() - 1; z >= 0; z--) {
+        double scale = 1 << z;
+        int64_t max = (int64_t(1) << z) - 1;
+
+        int64_t x0 = std::max<int64_t>(std::floor(_minX * scale - m_buffer), 0);
+        int64_t y0 = std::max<int64_t>(std::floor(_minY * scale - m_buffer), 0);
+        int64_t x1 = std::min<int64_t>(std::floor(_maxX * scale + m_buffer), max);
+        int64_t y1 = std::min<int64_t>(std::floor(_maxY * scale + m_buffer), max);
+
+        if (x0 > x1 || y0 > y1) { break; }
+
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) <= 4 || z == 0) {
+            for (int64_t x = x0; x <= x1; x++) {
+                for (int64_t y = y0; y <= y1; y++) {
+                    record(z, x, y, true);
+                }
+            }
+            break;
+        }
+    }
+    return generation;
+}
+
+int64_t TileGenerations::updateAll() {
+
+    int64_t generation = ++m_generation;
+
+    for (auto& level : m_levels) {
+        level.entries.clear();
+        level.base = 0;
+    }
+    m_levels[0].base = generation;
+
+    return generation;
+}
+
+void TileGenerations::record(int32_t _z, int64_t _x, int64_t _y, bool _whole) {
+
+    for (int32_t z = _z; z >= 0; z--) {
+        auto& level = m_levels[z];
+
+        if (level.entries.size() >= maxLevelEntries) {
+            // Drop the entries of this level: all its tiles are considered
+            // updated by the current generation.
+            level.entries.clear();
+            level.base = m_generation;
+        }
+
+        int32_t d = _z - z;
+        auto& entry = level.entries[tileKey(_x >> d, _y >> d)];
+        entry.subtree = m_generation;
+        if (_whole && z == _z) { entry.whole = m_generation; }
+    }
+}
+
+int64_t TileGenerations::generation(const TileID& _tile) const {
+
+    int32_t z = std::min<int32_t>(_tile.z, m_levels.size() - 1);
+    int32_t over = _tile.z - z;
+    int64_t x = _tile.x >> over;
+    int64_t y = _tile.y >> over;
+
+    int64_t generation = 0;
+
+    for (int32_t l = 0; l <= z; l++) {
+        auto& level = m_levels[l];
+        generation = std::max(generation, level.base);
+
+        int32_t d = z - l;
+        auto it = level.entries.find(tileKey(x >> d, y >> d));
+        if (it != level.entries.end()) {
+            generation = std::max(generation, l == z ? it->second.subtree : it->second.whole);
+        }
+    }
+    return generation;
+}
+
+struct ClientTileIndex::Snapshot {
+    // Shared with the store, released once 'store' is built
+    std::vector<std::shared_ptr<const geojsonvt::ProjectedFeature>> features;
+    // Built on first use by a reader
+    std::unique_ptr<geojsonvt::GeoJSONVT> store;
+    // GeoJSONVT creates tiles lazily in getTile
+    std::mutex mutex;
+};
+
+ClientTileIndex::ClientTileIndex(int32_t _maxZoom, uint32_t _indexMaxPoints, double _tolerance)
+    : m_maxZoom(_maxZoom),
+      m_indexZoom(std::max(std::min(_maxZoom, maxIndexZoom), 0)),
+      m_indexMaxPoints(_indexMaxPoints),
+      m_tolerance(_tolerance),
+      m_generations(_maxZoom, tileBuffer) {}
+
+ClientTileIndex::~ClientTileIndex() {}
+
+uint32_t ClientTileIndex::cellKey(const ProjectedFeature& _feature) const {
+
+    double scale = 1 << m_indexZoom;
+
+    double x0 = std::floor(_feature.min.x * scale - tileBuffer);
+    double y0 = std::floor(_feature.min.y * scale - tileBuffer);
+    double x1 = std::floor(_feature.max.x * scale + tileBuffer);
+    double y1 = std::floor(_feature.max.y * scale + tileBuffer);
+
+    if (x0 != x1 || y0 != y1 || x0 < 0 || y0 < 0 || x0 >= scale || y0 >= scale) {
+        return largeCell;
+    }
+    return (uint32_t(x0) << 16) | uint32_t(y0);
+}
+
+ClientTileIndex::Store* ClientTileIndex::findStore(uint32_t _cell) {
+    if (_cell == largeCell) { return &m_large; }
+
+    auto it = m_cells.find(_cell);
+    if (it == m_cells.end()) { return nullptr; }
+    return &it->second;
+}
+
+void ClientTileIndex::invalidate(Store& _store, const ProjectedFeature& _feature) {
+    _store.snapshot.reset();
+    m_generations.update(_feature.min.x, _feature.min.y, _feature.max.x, _feature.max.y);
+}
+
+void ClientTileIndex::set(FeatureID _id, ProjectedFeature _feature) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    setFeature(_id, std::move(_feature));
+}
+
+bool ClientTileIndex::update(FeatureID _id, ProjectedFeature _feature) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_featureCells.find(_id) == m_featureCells.end()) { return false; }
+
+    setFeature(_id, std::move(_feature));
+    return true;
+}
+
+void ClientTileIndex::setFeature(FeatureID _id, ProjectedFeature&& _feature) {
+
+    uint32_t cell = cellKey(_feature);
+
+    auto it = m_featureCells.find(_id);
+    if (it != m_featureCells.end()) {
+        // Remove the previous version of the feature
+        Store* store = findStore(it->second);
+        auto feature = store->features.find(_id);
+        invalidate(*store, *feature->second);
+        store->features.erase(feature);
+
+        if (store != &m_large && store->features.empty()) {
+            m_cells.erase(it->second);
+        }
+        it->second = cell;
+    } else {
+        m_featureCells.emplace(_id, cell);
+    }
+
+    Store& store = (cell == largeCell) ? m_large : m_cells[cell];
+    invalidate(store, _feature);
+    store.features.emplace(_id, std::make_shared<const ProjectedFeature>(std::move(_feature)));
+}
+
+bool ClientTileIndex::remove(FeatureID _id) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_featureCells.find(_id);
+    if (it == m_featureCells.end()) { return false; }
+
+    Store* store = findStore(it->second);
+    auto feature = store->features.find(_id);
+    invalidate(*store, *feature->second);
+    store->features.erase(feature);
+
+    if (store != &m_large && store->features.empty()) {
+        m_cells.erase(it->second);
+    }
+    m_featureCells.erase(it);
+
+    return true;
+}
+
+void ClientTileIndex::clear() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_featureCells.clear();
+    m_cells.clear();
+    m_large.features.clear();
+    m_large.snapshot.reset();
+
+    m_generations.updateAll();
+}
+
+bool ClientTileIndex::empty() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_featureCells.empty();
+}
+
+size_t ClientTileIndex::featureCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_featureCells.size();
+}
+
+int64_t ClientTileIndex::generation(const TileID& _tile) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_generations.generation(_tile);
+}
+
+int64_t ClientTileIndex::generation() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_generations.generation();
+}
+
+std::shared_ptr<ClientTileIndex::Snapshot> ClientTileIndex::snapshot(Store& _store) const {
+
+    // Only copies the feature pointers, the features are copied for
+    // GeoJSONVT outside of the index lock
+    if (!_store.snapshot) {
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->features.reserve(_store.features.size());
+        for (auto& it : _store.features) {
+            snapshot->features.push_back(it.second);
+        }
+        _store.snapshot = snapshot;
+    }
+    return _store.snapshot;
+}
+
+void ClientTileIndex::getTile(const TileID& _tile, std::vector<GeoJSONTile>& _tiles) const {
+
+    std::vector<std::shared_ptr<Snapshot>> snapshots;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_large.features.empty()) {
+            snapshots.push_back(snapshot(m_large));
+        }
+
+        if (_tile.z >= m_indexZoom) {
+            // The tile is within one cell
+            int32_t d = _tile.z - m_indexZoom;
+            auto it = m_cells.find((uint32_t(_tile.x >> d) << 16) | uint32_t(_tile.y >> d));
+            if (it != m_cells.end()) {
+                snapshots.push_back(snapshot(it->second));
+            }
+        } else {
+            // Cells covered by the tile, including its buffer
+            int32_t d = m_indexZoom - _tile.z;
+            int64_t max = (int64_t(1) << m_indexZoom) - 1;
+            int64_t buffer = std::ceil(tileBuffer * (1 << d));
+
+            int64_t x0 = std::max<int64_t>((int64_t(_tile.x) << d) - buffer, 0);
+            int64_t y0 = std::max<int64_t>((int64_t(_tile.y) << d) - buffer, 0);
+            int64_t x1 = std::min<int64_t>((int64_t(_tile.x + 1) << d) - 1 + buffer, max);
+            int64_t y1 = std::min<int64_t>((int64_t(_tile.y + 1) << d) - 1 + buffer, max);
+
+            if (size_t((x1 - x0 + 1) * (y1 - y0 + 1)) > m_cells.size()) {
+                for (auto& it : m_cells) {
+                    int64_t x = it.first >> 16;
+                    int64_t y = it.first & 0xffff;
+                    if (x >= x0 && x <= x1 && y >= y0 && y <= y1) {
+                        snapshots.push_back(snapshot(it.second));
+                    }
+                }
+            } else {
+                for (int64_t x = x0; x <= x1; x++) {
+                    for (int64_t y = y0; y <= y1; y++) {
+                        auto it = m_cells.find((uint32_t(x) << 16) | uint32_t(y));
+                        if (it != m_cells.end()) {
+                            snapshots.push_back(snapshot(it->second));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto& snapshot : snapshots) {
+        std::lock_guard<std::mutex> lock(snapshot->mutex);
+
+        if (!snapshot->store) {
+            std::vector<geojsonvt::ProjectedFeature> features;
+            features.reserve(snapshot->features.size());
+            for (auto& feature : snapshot->features) {
+                features.push_back(*feature);
+            }
+            snapshot->features.clear();
+            snapshot->features.shrink_to_fit();
+
+            snapshot->store = std::make_unique<geojsonvt::GeoJSONVT>(std::move(features), m_maxZoom, m_maxZoom,
+                                                                     m_indexMaxPoints, m_tolerance);
+            m_buildCount++;
+        }
+        _tiles.push_back(snapshot->store->getTile(_tile.z, _tile.x, _tile.y));
+    }
+}
+
+}
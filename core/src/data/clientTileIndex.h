@@ -0,0 +1,162 @@
+#pragma once
+
+#include "tile/tileID.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mapbox {
+namespace util {
+namespace geojsonvt {
+class GeoJSONVT;
+class ProjectedFeature;
+class Tile;
+}}}
+
+namespace Tangram {
+
+/*
+ * Generations of the updates of a tiled data set, tracked per tile.
+ *
+ * Each update records the area it changed with a new generation. A tile
+ * needs to be rebuilt when its generation is greater than the generation its
+ * data was built from, such that an update only invalidates the tiles it
+ * touches instead of the whole source.
+ */
+class TileGenerations {
+
+public:
+
+    // Track changes down to @_maxZoom; updates below are recorded at @_maxZoom.
+    // @_buffer is the area around a tile which is part of its data, relative
+    // to the tile size.
+    TileGenerations(int32_t _maxZoom, double _buffer = 0);
+
+    // Record an update of the area between @_min and @_max in projected
+    // coordinates ([0..1] from the top-left), returning its generation
+    int64_t update(double _minX, double _minY, double _maxX, double _maxY);
+
+    // Record an update which affects all tiles
+    int64_t updateAll();
+
+    // Generation of the last update which affected @_tile
+    int64_t generation(const TileID& _tile) const;
+
+    // Generation of the last update
+    int64_t generation() const { return m_generation; }
+
+private:
+
+    struct Entry {
+        // Last update of any part of the tile
+        int64_t subtree = 0;
+        // Last update which covered the whole tile and its descendants
+        int64_t whole = 0;
+    };
+
+    struct Level {
+        std::unordered_map<uint64_t, Entry> entries;
+        // Generation of entries dropped from this level, applies to all its tiles
+        int64_t base = 0;
+    };
+
+    void record(int32_t _z, int64_t _x, int64_t _y, bool _whole);
+
+    std::vector<Level> m_levels;
+    double m_buffer;
+    int64_t m_generation = 1;
+};
+
+/*
+ * Incremental tile index of ClientGeoJsonSource features.
+ *
+ * Features are kept in the cells of a grid at a fixed index zoom when their
+ * bounds (including the tile buffer) fit into one cell, and in a shared
+ * 'large' store otherwise. Each store builds its own GeoJSONVT lazily when
+ * a tile needs it, so that an update only requires the store of the changed
+ * feature to be rebuilt. Writers only lock the index for the map updates;
+ * readers take a snapshot of the stores a tile needs and build and query
+ * them outside of the index lock.
+ */
+class ClientTileIndex {
+
+public:
+
+    using FeatureID = uint64_t;
+    using ProjectedFeature = mapbox::util::geojsonvt::ProjectedFeature;
+    using GeoJSONTile = mapbox::util::geojsonvt::Tile;
+
+    ClientTileIndex(int32_t _maxZoom, uint32_t _indexMaxPoints, double _tolerance);
+    ~ClientTileIndex();
+
+    // Insert @_feature or replace the feature with @_id
+    void set(FeatureID _id, ProjectedFeature _feature);
+
+    // Replace the feature with @_id; returns false when there is none
+    bool update(FeatureID _id, ProjectedFeature _feature);
+
+    // Returns false when there is no feature with @_id
+    bool remove(FeatureID _id);
+
+    void clear();
+
+    bool empty() const;
+
+    // Append the tiles of all stores which contain features of @_tile
+    void getTile(const TileID& _tile, std::vector<GeoJSONTile>& _tiles) const;
+
+    // See TileGenerations
+    int64_t generation(const TileID& _tile) const;
+    int64_t generation() const;
+
+    size_t featureCount() const;
+
+    // Number of GeoJSONVT builds since creation
+    uint32_t buildCount() const { return m_buildCount; }
+
+    // Zoom of the grid cells
+    int32_t indexZoom() const { return m_indexZoom; }
+
+private:
+
+    struct Snapshot;
+
+    struct Store {
+        // Immutable once inserted, shared with the snapshots
+        std::map<FeatureID, std::shared_ptr<const ProjectedFeature>> features;
+        // Built from 'features'; reset when they change
+        std::shared_ptr<Snapshot> snapshot;
+    };
+
+    static constexpr uint32_t largeCell = UINT32_MAX;
+
+    // Requires m_mutex to be locked
+    void setFeature(FeatureID _id, ProjectedFeature&& _feature);
+
+    uint32_t cellKey(const ProjectedFeature& _feature) const;
+    Store* findStore(uint32_t _cell);
+    void invalidate(Store& _store, const ProjectedFeature& _feature);
+    std::shared_ptr<Snapshot> snapshot(Store& _store) const;
+
+    int32_t m_maxZoom;
+    int32_t m_indexZoom;
+    uint32_t m_indexMaxPoints;
+    double m_tolerance;
+
+    // Cell of each feature
+    std::unordered_map<FeatureID, uint32_t> m_featureCells;
+    mutable std::unordered_map<uint32_t, Store> m_cells;
+    mutable Store m_large;
+
+    TileGenerations m_generations;
+
+    mutable std::mutex m_mutex;
+    mutable std::atomic<uint32_t> m_buildCount{0};
+};
+
+}
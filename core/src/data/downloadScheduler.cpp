@@ -0,0 +1,356 @@
+#include "data/downloadScheduler.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace Tangram {
+
+// Smoothing factor of the latency average
+const double latencyAlpha = 0.2;
+// Smoothing factor of the adaptive limit
+const double limitAlpha = 0.2;
+// Samples after which the minimum latency is reset to the average latency
+const uint32_t minLatencySamples = 100;
+// Interval in seconds over which throughput is measured
+const double throughputInterval = 1.0;
+
+static double steadyClock() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+DownloadScheduler::DownloadScheduler(std::shared_ptr<Platform> _platform, Options _options)
+    : m_platform(_platform),
+      m_options(std::move(_options)) {
+
+    m_options.maxDownloads = std::max(m_options.maxDownloads, 1u);
+    m_options.minDownloads = std::min(std::max(m_options.minDownloads, 1u), m_options.maxDownloads);
+    m_options.maxDownloadsPerHost = std::max(m_options.maxDownloadsPerHost, 1u);
+
+    if (!m_options.clock) { m_options.clock = steadyClock; }
+
+    // Start adaptive scheduling from the previous fixed limit
+    m_limit = m_options.adaptive
+        ? std::min(std::max(4u, m_options.minDownloads), m_options.maxDownloads)
+        : m_options.maxDownloads;
+
+    m_windowStart = m_options.clock();
+}
+
+DownloadScheduler::~DownloadScheduler() {}
+
+std::string DownloadScheduler::host(const std::string& _url) {
+
+    size_t start = _url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+
+    size_t end = _url.find('/', start);
+    if (end == std::string::npos) { end = _url.size(); }
+
+    return _url.substr(start, end - start);
+}
+
+DownloadScheduler::RequestID DownloadScheduler::request(Request _request) {
+
+    RequestID id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        id = m_nextRequestId++;
+
+        auto& download = m_downloads[_request.url];
+        if (download.waiters.empty()) {
+            download.host = host(_request.url);
+        } else {
+            m_stats.coalesced++;
+        }
+
+        m_requests.emplace(id, _request.url);
+        download.waiters.push_back({ id, std::move(_request) });
+    }
+
+    dispatch();
+
+    return id;
+}
+
+void DownloadScheduler::cancel(RequestID _id) {
+
+    std::string url;
+    bool cancelActive = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_requests.find(_id);
+        if (it == m_requests.end()) { return; }
+
+        url = std::move(it->second);
+        m_requests.erase(it);
+
+        auto downloadIt = m_downloads.find(url);
+        if (downloadIt == m_downloads.end()) { return; }
+
+        auto& download = downloadIt->second;
+        auto& waiters = download.waiters;
+        waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                     [&](auto& waiter) { return waiter.id == _id; }),
+                      waiters.end());
+
+        if (!waiters.empty()) { return; }
+
+        if (download.active) {
+            // Release the slot now; a late response is ignored as the
+            // download will not be found anymore.
+            releaseSlot(download.host);
+            cancelActive = true;
+        } else {
+            m_stats.dropped++;
+        }
+        m_downloads.erase(downloadIt);
+    }
+
+    if (cancelActive) {
+        m_platform->cancelUrlRequest(url);
+        dispatch();
+    }
+}
+
+void DownloadScheduler::releaseSlot(const std::string& _host) {
+    m_active--;
+
+    auto it = m_hostActive.find(_host);
+    if (it != m_hostActive.end() && --it->second == 0) {
+        m_hostActive.erase(it);
+    }
+}
+
+void DownloadScheduler::dispatch() {
+
+    bool retry = true;
+
+    // Dispatch again when the Platform refused requests, as their slots are free again
+    while (retry) {
+        retry = false;
+
+        std::vector<std::pair<std::string, uint64_t>> start;
+        std::vector<Request> dropped;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            uint32_t limit = std::max(uint32_t(m_limit), 1u);
+            if (m_active >= limit) { return; }
+
+            // Evaluate the priority of each queued download once, dropping
+            // canceled requests, then start them in priority order
+            m_queue.clear();
+
+            for (auto it = m_downloads.begin(); it != m_downloads.end(); ) {
+                auto& download = it->second;
+                if (download.active) { ++it; continue; }
+
+                auto& waiters = download.waiters;
+                auto end = std::stable_partition(waiters.begin(), waiters.end(), [](auto& waiter) {
+                        return !(waiter.request.canceled && waiter.request.canceled());
+                    });
+                for (auto w = end; w != waiters.end(); ++w) {
+                    m_requests.erase(w->id);
+                    m_stats.dropped++;
+                    dropped.push_back(std::move(w->request));
+                }
+                waiters.erase(end, waiters.end());
+
+                if (waiters.empty()) {
+                    it = m_downloads.erase(it);
+                    continue;
+                }
+
+                double priority = std::numeric_limits<double>::max();
+                for (auto& waiter : waiters) {
+                    if (waiter.request.priority) {
+                        priority = std::min(priority, waiter.request.priority());
+                    }
+                }
+                m_queue.push_back({ priority, &*it });
+                ++it;
+            }
+
+            std::stable_sort(m_queue.begin(), m_queue.end(),
+                             [](auto& a, auto& b) { return a.first < b.first; });
+
+            for (auto& entry : m_queue) {
+                if (m_active >= limit) { break; }
+
+                auto& download = entry.second->second;
+
+                auto& hostActive = m_hostActive[download.host];
+                if (hostActive >= m_options.maxDownloadsPerHost) { continue; }
+
+                download.active = true;
+                download.startTime = m_options.clock();
+                download.token = m_nextToken++;
+
+                m_active++;
+                hostActive++;
+                m_stats.started++;
+
+                start.emplace_back(entry.second->first, download.token);
+            }
+            m_queue.clear();
+        }
+
+        // Let the owners of dropped requests release their state
+        for (auto& request : dropped) {
+            if (request.failed) { request.failed(); }
+        }
+
+        for (auto& it : start) {
+            std::weak_ptr<DownloadScheduler> weak = shared_from_this();
+
+            bool started = m_platform->startUrlRequest(it.first,
+                [weak, url = it.first, token = it.second](std::vector<char>&& _rawData) {
+                    if (auto self = weak.lock()) {
+                        self->onResponse(url, token, std::move(_rawData));
+                    }
+                });
+
+            if (!started) {
+                onFailure(it.first, it.second);
+                retry = true;
+            }
+        }
+    }
+}
+
+bool DownloadScheduler::finish(const std::string& _url, uint64_t _token,
+                               std::vector<Waiter>& _waiters, double& _latency) {
+
+    auto it = m_downloads.find(_url);
+    if (it == m_downloads.end()) { return false; }
+
+    auto& download = it->second;
+    if (!download.active || download.token != _token) { return false; }
+
+    releaseSlot(download.host);
+
+    for (auto& waiter : download.waiters) {
+        m_requests.erase(waiter.id);
+    }
+    _waiters = std::move(download.waiters);
+    _latency = m_options.clock() - download.startTime;
+
+    m_downloads.erase(it);
+    return true;
+}
+
+void DownloadScheduler::onResponse(const std::string& _url, uint64_t _token, std::vector<char>&& _rawData) {
+
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        double latency = 0;
+        if (!finish(_url, _token, waiters, latency)) { return; }
+
+        m_stats.completed++;
+
+        // Failed requests say nothing about the available bandwidth
+        if (!_rawData.empty()) {
+            addSample(latency, _rawData.size());
+        }
+    }
+
+    for (size_t i = 0; i < waiters.size(); i++) {
+        auto& callback = waiters[i].request.callback;
+        if (!callback) { continue; }
+
+        if (i + 1 == waiters.size()) {
+            callback(std::move(_rawData));
+        } else {
+            callback(std::vector<char>(_rawData));
+        }
+    }
+
+    dispatch();
+}
+
+void DownloadScheduler::onFailure(const std::string& _url, uint64_t _token) {
+
+    LOGW("Could not start request for '%s'", _url.c_str());
+
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        double latency = 0;
+        if (!finish(_url, _token, waiters, latency)) { return; }
+    }
+
+    for (auto& waiter : waiters) {
+        if (waiter.request.failed) {
+            waiter.request.failed();
+        } else if (waiter.request.callback) {
+            waiter.request.callback({});
+        }
+    }
+}
+
+void DownloadScheduler::addSample(double _latency, size_t _bytes) {
+
+    _latency = std::max(_latency, 1e-6);
+
+    if (m_samples == 0) {
+        m_latency = _latency;
+        m_minLatency = _latency;
+    } else {
+        m_latency += latencyAlpha * (_latency - m_latency);
+        m_minLatency = std::min(m_minLatency, _latency);
+    }
+
+    // Let the minimum follow changing network conditions
+    if (++m_samples % minLatencySamples == 0) {
+        m_minLatency = m_latency;
+    }
+
+    double now = m_options.clock();
+    m_windowBytes += _bytes;
+    if (now - m_windowStart >= throughputInterval) {
+        m_throughput = m_windowBytes / (now - m_windowStart);
+        m_windowBytes = 0;
+        m_windowStart = now;
+    }
+
+    if (!m_options.adaptive) { return; }
+
+    // Latency above the minimum means that requests wait somewhere on the
+    // way, i.e. there are more requests in flight than the connection can
+    // serve. Scale the limit down by the ratio and add some headroom to
+    // probe for more capacity when latency is at its minimum.
+    double gradient = std::max(0.5, std::min(1.0, m_minLatency / m_latency));
+    double target = m_limit * gradient + std::sqrt(m_limit);
+
+    m_limit += limitAlpha * (target - m_limit);
+    m_limit = std::max(double(m_options.minDownloads),
+                       std::min(double(m_options.maxDownloads), m_limit));
+}
+
+DownloadScheduler::Stats DownloadScheduler::stats() const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stats stats = m_stats;
+    stats.active = m_active;
+    stats.limit = std::max(uint32_t(m_limit), 1u);
+    stats.latency = m_latency;
+    stats.throughput = m_throughput;
+
+    for (auto& it : m_downloads) {
+        if (!it.second.active) { stats.queued += it.second.waiters.size(); }
+    }
+    return stats;
+}
+
+}
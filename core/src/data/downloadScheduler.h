@@ -0,0 +1,162 @@
+#pragma once
+
+#include "platform.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * Schedules the URL requests of the NetworkDataSources of a Scene.
+ *
+ * - Requests are queued and started in the order of their current priority,
+ *   which is evaluated when a slot becomes free rather than when the request
+ *   was made.
+ * - Requests for the same URL (e.g. from several sources or raster subtasks)
+ *   are coalesced into one platform request.
+ * - Requests which are canceled while queued never reach the Platform.
+ * - The number of concurrent requests is bounded globally and per host. With
+ *   'adaptive' the global limit follows the measured request latency: it
+ *   shrinks when latency rises above the observed minimum (i.e. requests
+ *   queue up on the way) and grows again while latency stays low.
+ */
+class DownloadScheduler : public std::enable_shared_from_this<DownloadScheduler> {
+
+public:
+
+    using RequestID = uint64_t;
+
+    struct Options {
+        // Upper bound of concurrent requests
+        uint32_t maxDownloads = 8;
+        // Lower bound of concurrent requests for 'adaptive'
+        uint32_t minDownloads = 2;
+        // Concurrent requests per host; HTTP/1.1 clients typically open up to
+        // six connections per host while HTTP/2 servers multiplex many streams
+        // over one connection and can be given the full maxDownloads.
+        uint32_t maxDownloadsPerHost = 6;
+        // Adapt the number of concurrent requests to the measured latency
+        bool adaptive = true;
+        // Time source in seconds, replaceable for tests
+        std::function<double()> clock;
+    };
+
+    struct Request {
+        std::string url;
+        // Called with the response; empty data when the request failed
+        UrlCallback callback;
+        // Called instead of 'callback' when the Platform could not start the
+        // request or when the request was dropped as canceled
+        std::function<void()> failed;
+        // Evaluated when the request is to be dispatched: lower values first
+        std::function<double()> priority;
+        // Evaluated when the request is to be dispatched: canceled requests are dropped
+        std::function<bool()> canceled;
+    };
+
+    struct Stats {
+        uint32_t active = 0;
+        uint32_t queued = 0;
+        // Current limit of concurrent requests
+        uint32_t limit = 0;
+        // Platform requests started and completed
+        uint64_t started = 0;
+        uint64_t completed = 0;
+        // Requests served by another request for the same URL
+        uint64_t coalesced = 0;
+        // Requests canceled before they were started
+        uint64_t dropped = 0;
+        // Smoothed request latency in seconds and throughput in bytes per second
+        double latency = 0;
+        double throughput = 0;
+    };
+
+    DownloadScheduler(std::shared_ptr<Platform> _platform, Options _options);
+    ~DownloadScheduler();
+
+    // Queue @_request, returns the ID to cancel it
+    RequestID request(Request _request);
+
+    // Cancel the request with @_id; the platform request is only canceled when
+    // no other request for the same URL is waiting for it
+    void cancel(RequestID _id);
+
+    // Start queued requests while slots are available. Called automatically
+    // on new and completed requests; call it after priorities changed or
+    // when requests may have been canceled.
+    void dispatch();
+
+    Stats stats() const;
+
+    const Options& options() const { return m_options; }
+
+    // Host part of @_url, used for the per-host limits
+    static std::string host(const std::string& _url);
+
+private:
+
+    struct Waiter {
+        RequestID id;
+        Request request;
+    };
+
+    struct Download {
+        std::string host;
+        std::vector<Waiter> waiters;
+        bool active = false;
+        double startTime = 0;
+        // Identifies the platform request of an active download
+        uint64_t token = 0;
+    };
+
+    void onResponse(const std::string& _url, uint64_t _token, std::vector<char>&& _rawData);
+    // Notify the waiters of a download the Platform could not start; the
+    // caller dispatches the queued downloads on the released slot
+    void onFailure(const std::string& _url, uint64_t _token);
+
+    // Remove the active download of @_url started with @_token, returning its
+    // waiters. Returns false when the download was canceled meanwhile.
+    bool finish(const std::string& _url, uint64_t _token, std::vector<Waiter>& _waiters,
+                double& _latency);
+
+    void releaseSlot(const std::string& _host);
+    void addSample(double _latency, size_t _bytes);
+
+    std::shared_ptr<Platform> m_platform;
+    Options m_options;
+
+    // Downloads by URL
+    std::unordered_map<std::string, Download> m_downloads;
+    // URL of each waiting request
+    std::unordered_map<RequestID, std::string> m_requests;
+    std::unordered_map<std::string, uint32_t> m_hostActive;
+
+    // Reusable container of the queued downloads by priority, sorted on dispatch
+    std::vector<std::pair<double, std::pair<const std::string, Download>*>> m_queue;
+
+    RequestID m_nextRequestId = 1;
+    uint64_t m_nextToken = 1;
+
+    uint32_t m_active = 0;
+    double m_limit;
+
+    // Latency statistics for the adaptive limit
+    double m_latency = 0;
+    double m_minLatency = 0;
+    double m_throughput = 0;
+    uint32_t m_samples = 0;
+    double m_windowStart = 0;
+    size_t m_windowBytes = 0;
+
+    Stats m_stats;
+
+    mutable std::mutex m_mutex;
+};
+
+}
@@ -6,6 +6,7 @@
 #include "platform.h"
 
 #include <SQLiteCpp/Database.h>
+#include <SQLiteCpp/Transaction.h>
 #include "hash-library/md5.cpp"
 
 
@@ -131,6 +132,14 @@ MBTilesDataSource::MBTilesDataSource(std::shared_ptr<Platform> _platform, std::s
 MBTilesDataSource::~MBTilesDataSource() {
 }
 
+std::string MBTilesDataSource::cacheKey(const TileID& _tile) const {
+    // Tiles cached from the next source are keyed by its URLs
+    if (next) { return next->cacheKey(_tile); }
+
+    return m_path + "/" + std::to_string(_tile.z) + "/" +
+        std::to_string(_tile.x) + "/" + std::to_string(_tile.y);
+}
+
 bool MBTilesDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
 
     if (m_offlineMode) {
@@ -150,9 +159,10 @@ bool MBTilesDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb
             TileID tileId = _task->tileId();
 
             auto& task = static_cast<BinaryTileTask&>(*_task);
-            task.rawTileData = std::make_shared<std::vector<char>>();
 
-            getTileData(tileId, *task.rawTileData);
+            std::vector<char> data;
+            getTileData(tileId, data);
+            task.rawTileData = std::make_shared<RawData>(std::move(data));
 
             if (task.hasData()) {
                 LOGW("loaded tile: %s, %d", tileId.toString().c_str(), task.rawTileData->size());
@@ -199,7 +209,7 @@ bool MBTilesDataSource::loadNextSource(std::shared_ptr<TileTask> _task, TileTask
 
                         LOGW("store tile: %s, %d", _task->tileId().toString().c_str(), task.hasData());
 
-                        storeTileData(_task->tileId(), *task.rawTileData);
+                        storeTileData(_task->tileId(), task.rawTileData->data(), task.rawTileData->size());
                     });
             }
 
@@ -211,9 +221,10 @@ bool MBTilesDataSource::loadNextSource(std::shared_ptr<TileTask> _task, TileTask
             m_worker->enqueue([this, _task, _cb](){
 
                 auto& task = static_cast<BinaryTileTask&>(*_task);
-                task.rawTileData = std::make_shared<std::vector<char>>();
 
-                getTileData(_task->tileId(), *task.rawTileData);
+                std::vector<char> data;
+                getTileData(_task->tileId(), data);
+                task.rawTileData = std::make_shared<RawData>(std::move(data));
 
                 LOGW("loaded tile: %s, %d", _task->tileId().toString().c_str(), task.rawTileData->size());
 
@@ -463,12 +474,12 @@ bool MBTilesDataSource::getTileData(const TileID& _tileId, std::vector<char>& _d
     return false;
 }
 
-void MBTilesDataSource::storeTileData(const TileID& _tileId, const std::vector<char>& _data) {
+bool MBTilesDataSource::storeTileData(const TileID& _tileId, const char* _data, size_t _size) {
     int z = _tileId.z;
     int y = (1 << z) - 1 - _tileId.y;
 
-    const char* data = _data.data();
-    size_t size = _data.size();
+    const char* data = _data;
+    size_t size = _size;
 
     /**
      * We create an MD5 of the raw tile data. The MD5 functions as a hash
@@ -490,6 +501,7 @@ void MBTilesDataSource::storeTileData(const TileID& _tileId, const std::vector<c
 
     } catch (std::exception& e) {
         LOGE("MBTiles SQLite put map statement failed: %s", e.what());
+        return false;
     }
 
     try {
@@ -502,7 +514,72 @@ void MBTilesDataSource::storeTileData(const TileID& _tileId, const std::vector<c
 
     } catch (std::exception& e) {
         LOGE("MBTiles SQLite put image statement failed: %s", e.what());
+        return false;
+    }
+    return true;
+}
+
+void MBTilesDataSource::storeTiles(TileBatch _tiles, std::function<void(bool)> _cb) {
+
+    if (!isWritable()) {
+        LOGE("Cannot store tiles: MBTiles database %s is not writable", m_path.c_str());
+        _cb(false);
+        return;
     }
+
+    m_worker->enqueue([this, tiles = std::move(_tiles), _cb](){
+
+        bool ok = true;
+        try {
+            // One transaction per batch instead of one per statement
+            SQLite::Transaction transaction(*m_db);
+
+            for (auto& tile : tiles) {
+                if (!storeTileData(tile.first, tile.second.data(), tile.second.size())) {
+                    ok = false;
+                    break;
+                }
+            }
+            // Roll back the whole batch when a tile could not be stored
+            if (ok) { transaction.commit(); }
+
+        } catch (std::exception& e) {
+            LOGE("MBTiles SQLite transaction failed: %s", e.what());
+            ok = false;
+        }
+        _cb(ok);
+    });
+}
+
+void MBTilesDataSource::getTileIDs(int32_t _minZoom, int32_t _maxZoom,
+                                   std::function<void(std::vector<TileID>)> _cb) {
+
+    if (!m_db) {
+        _cb({});
+        return;
+    }
+
+    m_worker->enqueue([this, _minZoom, _maxZoom, _cb](){
+
+        std::vector<TileID> tiles;
+        try {
+            SQLite::Statement stmt(*m_db, "SELECT zoom_level, tile_column, tile_row FROM tiles"
+                                          " WHERE zoom_level >= ? AND zoom_level <= ?;");
+            stmt.bind(1, _minZoom);
+            stmt.bind(2, _maxZoom);
+
+            while (stmt.executeStep()) {
+                int z = stmt.getColumn(0);
+                int x = stmt.getColumn(1);
+                int row = stmt.getColumn(2);
+                // TMS to WMTS
+                tiles.emplace_back(x, (1 << z) - 1 - row, z);
+            }
+        } catch (std::exception& e) {
+            LOGE("MBTiles SQLite tile query failed: %s", e.what());
+        }
+        _cb(std::move(tiles));
+    });
 }
 
 }
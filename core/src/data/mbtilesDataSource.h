@@ -25,9 +25,26 @@ public:
 
     void clear() override {}
 
+    std::string cacheKey(const TileID& _tile) const override;
+
+    using TileBatch = std::vector<std::pair<TileID, std::vector<char>>>;
+
+    /* Store @_tiles in one transaction on the MBTiles worker thread. Requires
+     * cache mode. Either all tiles are stored or none. @_cb is called on the
+     * worker thread with the result.
+     */
+    void storeTiles(TileBatch _tiles, std::function<void(bool)> _cb);
+
+    /* Collect the IDs of the stored tiles from @_minZoom to @_maxZoom on the
+     * MBTiles worker thread and pass them to @_cb
+     */
+    void getTileIDs(int32_t _minZoom, int32_t _maxZoom, std::function<void(std::vector<TileID>)> _cb);
+
+    bool isWritable() const { return bool(m_db) && m_cacheMode; }
+
 private:
     bool getTileData(const TileID& _tileId, std::vector<char>& _data);
-    void storeTileData(const TileID& _tileId, const std::vector<char>& _data);
+    bool storeTileData(const TileID& _tileId, const char* _data, size_t _size);
     bool loadNextSource(std::shared_ptr<TileTask> _task, TileTaskCb _cb);
 
     void openMBTiles();
@@ -1,103 +1,77 @@
 #include "data/memoryCacheDataSource.h"
 
-#include "tile/tileHash.h"
+#include "data/rawTileCache.h"
 #include "tile/tileID.h"
-#include "log.h"
 
-#include <list>
-#include <mutex>
-#include <unordered_map>
+#include <algorithm>
 
 namespace Tangram {
 
-struct RawCache {
+MemoryCacheDataSource::MemoryCacheDataSource(std::shared_ptr<RawTileCache> _cache) :
+    m_cache(_cache),
+    m_shared(bool(_cache)) {
 
-    // Used to ensure safe access from async loading threads
-    std::mutex m_mutex;
-
-    // LRU in-memory cache for raw tile data
-    using CacheEntry = std::pair<TileID, std::shared_ptr<std::vector<char>>>;
-    using CacheList = std::list<CacheEntry>;
-    using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
-
-    CacheMap m_cacheMap;
-    CacheList m_cacheList;
-    int m_usage = 0;
-    int m_maxUsage = 0;
-
-    bool get(BinaryTileTask& _task) {
-
-        if (m_maxUsage <= 0) { return false; }
+    if (!m_cache) { m_cache = std::make_shared<RawTileCache>(0, 1); }
+}
 
-        std::lock_guard<std::mutex> lock(m_mutex);
-        TileID id(_task.tileId().x, _task.tileId().y, _task.tileId().z);
+MemoryCacheDataSource::~MemoryCacheDataSource() {}
 
-        auto it = m_cacheMap.find(id);
-        if (it != m_cacheMap.end()) {
-            // Move cached entry to start of list
-            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
-            _task.rawTileData = m_cacheList.front().second;
+void MemoryCacheDataSource::setCacheSize(size_t _cacheSize) {
+    m_cache->setMaxUsage(_cacheSize);
+}
 
-            return true;
-        }
+std::string MemoryCacheDataSource::key(const TileID& _tileID) const {
+    std::string key = cacheKey(_tileID);
 
-        return false;
+    // A private cache can fall back to the tile coordinates
+    if (key.empty() && !m_shared) {
+        key = TileID(_tileID.x, _tileID.y, _tileID.z).toString();
     }
-    void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef) {
-
-        if (m_maxUsage <= 0) { return; }
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        TileID id(tileID.x, tileID.y, tileID.z);
-
-        m_cacheList.push_front({id, rawDataRef});
-        m_cacheMap[id] = m_cacheList.begin();
-
-        m_usage += rawDataRef->size();
+    return key;
+}
 
-        while (m_usage > m_maxUsage) {
-            if (m_cacheList.empty()) {
-                LOGE("Error: invalid cache state!");
-                m_usage = 0;
-                break;
-            }
+bool MemoryCacheDataSource::cacheGet(BinaryTileTask& _task) {
+    if (m_cache->maxUsage() == 0) { return false; }
 
-            // LOGE("Limit raw cache tiles:%d, %fMB ", m_cacheList.size(),
-            //        double(m_cacheUsage) / (1024*1024));
+    std::string key = this->key(_task.tileId());
+    if (key.empty()) { return false; }
 
-            auto& entry = m_cacheList.back();
-            m_usage -= entry.second->size();
+    _task.rawTileData = m_cache->get(key);
+    if (!_task.rawTileData) { return false; }
 
-            m_cacheMap.erase(entry.first);
-            m_cacheList.pop_back();
-        }
-    }
+    // The entry may have been put by another source with the same URL
+    addKey(key);
+    return true;
+}
 
-    void clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_cacheMap.clear();
-        m_cacheList.clear();
-        m_usage = 0;
-    }
-};
+void MemoryCacheDataSource::cachePut(const TileID& _tileID, std::shared_ptr<RawData> _rawDataRef) {
+    if (m_cache->maxUsage() == 0) { return; }
 
+    std::string key = this->key(_tileID);
+    if (key.empty()) { return; }
 
-MemoryCacheDataSource::MemoryCacheDataSource() :
-    m_cache(std::make_unique<RawCache>()) {
+    m_cache->put(key, _rawDataRef);
+    addKey(key);
 }
 
-MemoryCacheDataSource::~MemoryCacheDataSource() {}
+void MemoryCacheDataSource::addKey(const std::string& _key) {
+    if (!m_shared) { return; }
 
-void MemoryCacheDataSource::setCacheSize(size_t _cacheSize) {
-    m_cache->m_maxUsage = _cacheSize;
-}
+    std::lock_guard<std::mutex> lock(m_keysMutex);
 
-bool MemoryCacheDataSource::cacheGet(BinaryTileTask& _task) {
-    return m_cache->get(_task);
-}
+    m_keys.insert(_key);
 
-void MemoryCacheDataSource::cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef) {
-    m_cache->put(_tileID, _rawDataRef);
+    // Forget the keys of entries which were evicted meanwhile
+    if (m_keys.size() >= m_pruneSize) {
+        for (auto it = m_keys.begin(); it != m_keys.end(); ) {
+            if (!m_cache->contains(*it)) {
+                it = m_keys.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_pruneSize = std::max(size_t(256), m_keys.size() * 2);
+    }
 }
 
 bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
@@ -133,7 +107,16 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
 }
 
 void MemoryCacheDataSource::clear() {
-    m_cache->clear();
+    if (m_shared) {
+        std::unordered_set<std::string> keys;
+        {
+            std::lock_guard<std::mutex> lock(m_keysMutex);
+            std::swap(keys, m_keys);
+        }
+        for (auto& key : keys) { m_cache->remove(key); }
+    } else {
+        m_cache->clear();
+    }
 
     if (next) { next->clear(); }
 }
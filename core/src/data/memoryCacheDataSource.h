@@ -2,16 +2,26 @@
 
 #include "data/tileSource.h"
 
+#include <mutex>
+#include <unordered_set>
+
 namespace Tangram {
 
+class RawTileCache;
+
 class MemoryCacheDataSource : public TileSource::DataSource {
 public:
 
-    MemoryCacheDataSource();
+    /* @_cache: Cache for the tile data, e.g. RawTileCache::shared() to share
+     * cached data with other sources. Without a cache this source has its own.
+     */
+    MemoryCacheDataSource(std::shared_ptr<RawTileCache> _cache = nullptr);
     ~MemoryCacheDataSource();
 
     bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override;
 
+    /* Remove the cached data of this source. With a shared cache only the
+     * entries this source has put or read are removed. */
     void clear() override;
 
     /* @_cacheSize: Set size of in-memory cache for tile data in bytes.
@@ -20,11 +30,23 @@ public:
     void setCacheSize(size_t _cacheSize);
 
 private:
+    std::string key(const TileID& _tileID) const;
+
     bool cacheGet(BinaryTileTask& _task);
 
-    void cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef);
+    void cachePut(const TileID& _tileID, std::shared_ptr<RawData> _rawDataRef);
+
+    // Remember @_key as used by this source to remove it from a shared cache on clear()
+    void addKey(const std::string& _key);
+
+    std::shared_ptr<RawTileCache> m_cache;
+    bool m_shared;
 
-    std::unique_ptr<RawCache> m_cache;
+    // Keys of the shared cache used by this source
+    std::unordered_set<std::string> m_keys;
+    // Size of m_keys at which keys evicted from the cache are removed
+    size_t m_pruneSize = 256;
+    std::mutex m_keysMutex;
 
 };
 
@@ -1,9 +1,11 @@
 #include "data/mvtSource.h"
 #include "data/tileData.h"
+#include "debug/trace.h"
 #include "tile/tileID.h"
 #include "tile/tile.h"
 #include "tile/tileTask.h"
 #include "util/pbfParser.h"
+#include "util/zlibHelper.h"
 #include "log.h"
 
 namespace Tangram {
@@ -14,7 +16,24 @@ std::shared_ptr<TileData> MVTSource::parse(const TileTask& _task, const MapProje
 
     auto& task = static_cast<const BinaryTileTask&>(_task);
 
-    protobuf::message item(task.rawTileData->data(), task.rawTileData->size());
+    const char* data = task.rawTileData->data();
+    size_t size = task.rawTileData->size();
+
+    // Tiles may be served as gzip files without Content-Encoding
+    std::vector<char> inflated;
+    if (zlib::isGzip(data, size)) {
+        TraceSpan span("zlib::inflate", _task.tileId());
+        if (zlib::inflate(data, size, inflated) != 0) {
+            LOGE("Cannot inflate tile %s", _task.tileId().toString().c_str());
+            return {};
+        }
+        data = inflated.data();
+        size = inflated.size();
+    }
+
+    TraceSpan span("PbfParser", _task.tileId());
+
+    protobuf::message item(data, size);
     PbfParser::ParserContext ctx(m_id);
 
     try {
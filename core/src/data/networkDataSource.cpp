@@ -1,16 +1,28 @@
 #include "data/networkDataSource.h"
 
+#include "debug/trace.h"
 #include "log.h"
 #include "platform.h"
-
-#define MAX_DOWNLOADS 4
+#include "util/asyncWorker.h"
 
 namespace Tangram {
 
-NetworkDataSource::NetworkDataSource(std::shared_ptr<Platform> _platform, const std::string& _urlTemplate) :
+NetworkDataSource::NetworkDataSource(std::shared_ptr<Platform> _platform, const std::string& _urlTemplate,
+                                     std::shared_ptr<DownloadScheduler> _scheduler) :
     m_platform(_platform),
     m_urlTemplate(_urlTemplate),
-    m_maxDownloads(MAX_DOWNLOADS) {}
+    m_scheduler(_scheduler) {
+
+    if (!m_scheduler) {
+        m_scheduler = std::make_shared<DownloadScheduler>(m_platform, DownloadScheduler::Options());
+    }
+
+    if (m_urlTemplate.compare(0, 7, "file://") == 0) {
+        m_worker = std::make_unique<AsyncWorker>();
+    }
+}
+
+NetworkDataSource::~NetworkDataSource() {}
 
 void NetworkDataSource::constructURL(const TileID& _tileCoord, std::string& _url) const {
     _url.assign(m_urlTemplate);
@@ -34,62 +46,115 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb
         return false;
     }
 
-    if (m_pending.size() >= m_maxDownloads) {
-        return false;
+    // Local files are mapped instead of read through the Platform. Opening
+    // and reading small files blocks, so it is done on the worker.
+    if (m_worker) {
+        m_worker->enqueue([this, _task, _cb]() {
+            if (_task->isCanceled()) { return; }
+
+            auto data = RawData::mapFile(constructURL(_task->tileId()).substr(7));
+            if (data) {
+                static_cast<BinaryTileTask&>(*_task).rawTileData = std::move(data);
+                _cb.func(_task);
+            } else {
+                requestTile(_task, _cb);
+            }
+        });
+        return true;
     }
 
+    return requestTile(std::move(_task), std::move(_cb));
+}
+
+bool NetworkDataSource::requestTile(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
+
     auto tileId = _task->tileId();
 
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        if (std::find(m_pending.begin(), m_pending.end(), tileId) != m_pending.end()) {
+        // Reserve the entry, the request ID is set below
+        if (!m_pending.emplace(tileId, 0).second) {
             return false;
         }
-        m_pending.push_back(tileId);
     }
 
-    std::string url(constructURL(_task->tileId()));
+    DownloadScheduler::Request request;
+    request.url = constructURL(tileId);
 
-    bool started = m_platform->startUrlRequest(url,
-        [this, cb = _cb, task = _task](std::vector<char>&& _rawData) mutable {
+    std::weak_ptr<TileTask> weakTask = _task;
 
-            removePending(task->tileId());
+    // Traced from the request until the response, on the thread delivering it
+    int64_t traceStart = Trace::enabled() ? Trace::now() : -1;
 
-            if (task->isCanceled()) {
-                return;
-            }
+    request.priority = [weakTask]() {
+        auto task = weakTask.lock();
+        return task ? task->getPriority() : 0.0;
+    };
 
-            if (!_rawData.empty()) {
-                auto rawDataRef = std::make_shared<std::vector<char>>();
-                std::swap(*rawDataRef, _rawData);
+    request.canceled = [weakTask]() {
+        auto task = weakTask.lock();
+        return !task || task->isCanceled();
+    };
 
-                auto& dlTask = static_cast<BinaryTileTask&>(*task);
-                // NB: Sets hasData() state true
-                dlTask.rawTileData = rawDataRef;
-            }
-            cb.func(task);
-        });
+    request.callback = [this, cb = _cb, task = _task, traceStart](std::vector<char>&& _rawData) mutable {
 
-    if (!started) {
-        removePending(_task->tileId());
+        if (traceStart >= 0) {
+            TileID tileId = task->tileId();
+            Trace::record("NetworkDataSource::loadTileData", traceStart, &tileId);
+        }
+
+        removePending(task->tileId());
+
+        if (task->isCanceled()) {
+            return;
+        }
+
+        if (!_rawData.empty()) {
+            auto& dlTask = static_cast<BinaryTileTask&>(*task);
+            // NB: Sets hasData() state true
+            dlTask.rawTileData = std::make_shared<RawData>(std::move(_rawData));
+        }
+        cb.func(task);
+    };
+
+    request.failed = [this, task = _task]() {
+        removePending(task->tileId());
 
         // Set canceled state, so that tile will not be tried
         // for reloading until sourceGeneration increased.
-        _task->cancel();
+        task->cancel();
+    };
+
+    auto id = m_scheduler->request(std::move(request));
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Not found when the request already finished within request()
+        auto it = m_pending.find(tileId);
+        if (it != m_pending.end()) { it->second = id; }
     }
 
-    return started;
+    return true;
 }
 
 void NetworkDataSource::removePending(const TileID& _tileId) {
     std::unique_lock<std::mutex> lock(m_mutex);
-    auto it = std::find(m_pending.begin(), m_pending.end(), _tileId);
-    if (it != m_pending.end()) { m_pending.erase(it); }
+    m_pending.erase(_tileId);
 }
 
 void NetworkDataSource::cancelLoadingTile(const TileID& _tileId) {
-    removePending(_tileId);
-    m_platform->cancelUrlRequest(constructURL(_tileId));
+
+    DownloadScheduler::RequestID id = 0;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(_tileId);
+        if (it == m_pending.end()) { return; }
+
+        id = it->second;
+        m_pending.erase(it);
+    }
+
+    if (id) { m_scheduler->cancel(id); }
 }
 
 }
@@ -1,21 +1,33 @@
 #pragma once
 
+#include "data/downloadScheduler.h"
 #include "data/tileSource.h"
 
+#include <map>
+
 class Platform;
 
 namespace Tangram {
 
+class AsyncWorker;
+
 class NetworkDataSource : public TileSource::DataSource {
 public:
 
-    NetworkDataSource(std::shared_ptr<Platform> _platform, const std::string& _urlTemplate);
+    // Requests are started through @_scheduler, which may be shared with other sources
+    NetworkDataSource(std::shared_ptr<Platform> _platform, const std::string& _urlTemplate,
+                      std::shared_ptr<DownloadScheduler> _scheduler = nullptr);
+
+    ~NetworkDataSource();
 
     bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override;
 
     void cancelLoadingTile(const TileID& _tile) override;
 
-private:
+    std::string cacheKey(const TileID& _tile) const override { return constructURL(_tile); }
+
+    const std::shared_ptr<DownloadScheduler>& scheduler() const { return m_scheduler; }
+
     /* Constructs the URL of a tile using <m_urlTemplate> */
     void constructURL(const TileID& _tileCoord, std::string& _url) const;
 
@@ -25,6 +37,11 @@ private:
         return url;
     }
 
+private:
+
+    // Request the tile through m_scheduler
+    bool requestTile(std::shared_ptr<TileTask> _task, TileTaskCb _cb);
+
     void removePending(const TileID& _tileId);
 
     std::shared_ptr<Platform> m_platform;
@@ -32,12 +49,16 @@ private:
     // URL template for requesting tiles from a network or filesystem
     std::string m_urlTemplate;
 
-    std::vector<TileID> m_pending;
+    std::shared_ptr<DownloadScheduler> m_scheduler;
 
-    size_t m_maxDownloads;
+    // Scheduler requests of the tiles being loaded
+    std::map<TileID, DownloadScheduler::RequestID> m_pending;
 
     std::mutex m_mutex;
 
+    // Maps local tile files for file:// URL templates, off the thread loading the tiles
+    std::unique_ptr<AsyncWorker> m_worker;
+
 };
 
 }
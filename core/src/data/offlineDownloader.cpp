@@ -0,0 +1,380 @@
+#include "data/offlineDownloader.h"
+
+#include "data/networkDataSource.h"
+#include "data/tileData.h"
+#include "util/geom.h"
+#include "util/rasterize.h"
+#include "view/view.h"
+#include "log.h"
+
+#include "earcut.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Tangram {
+
+// Latitude limit of the web mercator tile grid
+const double maxLatitude = 85.05112878;
+
+// Position of @_lngLat in the tile grid of zoom level 0
+static glm::dvec2 tileCoordinates(const LngLat& _lngLat) {
+    double lat = glm::radians(std::max(-maxLatitude, std::min(maxLatitude, _lngLat.latitude)));
+    double x = (_lngLat.longitude + 180.0) / 360.0;
+    double y = (1.0 - std::log(std::tan(lat) + 1.0 / std::cos(lat)) / PI) / 2.0;
+    return { std::max(0.0, std::min(1.0, x)), y };
+}
+
+OfflineDownloader::Region OfflineDownloader::Region::bounds(LngLat _southWest, LngLat _northEast,
+                                                            int32_t _minZoom, int32_t _maxZoom) {
+    Region region;
+    region.polygon.push_back({
+        _southWest,
+        { _northEast.longitude, _southWest.latitude },
+        _northEast,
+        { _southWest.longitude, _northEast.latitude }
+    });
+    region.minZoom = _minZoom;
+    region.maxZoom = _maxZoom;
+    return region;
+}
+
+OfflineDownloader::OfflineDownloader(std::shared_ptr<NetworkDataSource> _network,
+                                     std::shared_ptr<MBTilesDataSource> _mbtiles,
+                                     Options _options)
+    : m_network(_network),
+      m_mbtiles(_mbtiles),
+      m_options(_options) {
+
+    m_options.maxPending = std::max(m_options.maxPending, 1u);
+    m_options.batchSize = std::max(m_options.batchSize, 1u);
+}
+
+OfflineDownloader::~OfflineDownloader() {
+    for (auto& it : m_pending) {
+        if (it.second) { m_network->scheduler()->cancel(it.second); }
+    }
+}
+
+void OfflineDownloader::getTiles(const Region& _region, int32_t _zoom, std::vector<TileID>& _tiles) {
+
+    if (_region.polygon.empty() || _region.polygon[0].size() < 3) { return; }
+
+    // Triangulate the polygon in tile coordinates of zoom level 0 and
+    // rasterize the triangles into the tile grid of @_zoom.
+    Polygon polygon;
+    std::vector<glm::dvec2> points;
+    for (auto& ring : _region.polygon) {
+        Line line;
+        for (auto& lngLat : ring) {
+            points.push_back(tileCoordinates(lngLat));
+            line.emplace_back(points.back().x, points.back().y, 0.f);
+        }
+        polygon.push_back(std::move(line));
+    }
+
+    mapbox::detail::Earcut<uint32_t> earcut;
+    earcut(polygon);
+
+    int32_t max = 1 << _zoom;
+    double scale = max;
+
+    std::set<TileID> tiles;
+    Rasterize::ScanCallback s = [&](int x, int y) {
+        if (x >= 0 && x < max && y >= 0 && y < max) {
+            tiles.emplace(x, y, _zoom);
+        }
+    };
+
+    for (size_t i = 0; i + 2 < earcut.indices.size(); i += 3) {
+        glm::dvec2 a = points[earcut.indices[i]] * scale;
+        glm::dvec2 b = points[earcut.indices[i + 1]] * scale;
+        glm::dvec2 c = points[earcut.indices[i + 2]] * scale;
+        Rasterize::scanTriangle(a, b, c, 0, max, s);
+    }
+
+    _tiles.insert(_tiles.end(), tiles.begin(), tiles.end());
+}
+
+uint64_t OfflineDownloader::countTiles(const Region& _region) {
+    uint64_t count = 0;
+    std::vector<TileID> tiles;
+    for (int32_t z = _region.minZoom; z <= _region.maxZoom; z++) {
+        tiles.clear();
+        getTiles(_region, z, tiles);
+        count += tiles.size();
+    }
+    return count;
+}
+
+bool OfflineDownloader::start(const Region& _region, ProgressCallback _progress, DoneCallback _done) {
+
+    if (!m_mbtiles->isWritable()) {
+        LOGE("Cannot download region: MBTiles database is not writable");
+        return false;
+    }
+
+    Region region = _region;
+    region.minZoom = std::max(region.minZoom, 0);
+    region.maxZoom = std::min(region.maxZoom, int32_t(View::s_maxZoom));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) { return false; }
+
+        m_running = true;
+        m_canceled = false;
+        m_region = region;
+        m_progressCb = _progress;
+        m_doneCb = _done;
+
+        m_zoom = region.minZoom;
+        m_tiles.clear();
+        m_next = 0;
+        m_stored.clear();
+        m_batch.clear();
+
+        m_progress = Progress();
+        m_downloaded = 0;
+    }
+
+    // Enumerating the tiles of large regions takes a while, count them
+    // without blocking update() and cancel()
+    uint64_t total = countTiles(region);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_progress.total = total;
+        m_progress.estimatedBytes = total * m_options.averageTileSize;
+    }
+
+    // Look up the stored tiles first to resume a previous download
+    std::weak_ptr<OfflineDownloader> weak = shared_from_this();
+    m_mbtiles->getTileIDs(region.minZoom, region.maxZoom, [weak](std::vector<TileID> _stored) {
+        if (auto self = weak.lock()) {
+            self->begin(std::move(_stored));
+        }
+    });
+
+    return true;
+}
+
+void OfflineDownloader::begin(std::vector<TileID> _stored) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running || m_canceled) { return; }
+
+        m_stored.insert(_stored.begin(), _stored.end());
+    }
+
+    fill();
+    update();
+}
+
+void OfflineDownloader::cancel() {
+
+    std::vector<DownloadScheduler::RequestID> requests;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running || m_canceled) { return; }
+
+        m_canceled = true;
+        for (auto& it : m_pending) {
+            if (it.second) { requests.push_back(it.second); }
+        }
+        m_pending.clear();
+    }
+
+    for (auto id : requests) {
+        m_network->scheduler()->cancel(id);
+    }
+
+    update();
+}
+
+bool OfflineDownloader::isRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+OfflineDownloader::Progress OfflineDownloader::progress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_progress;
+}
+
+void OfflineDownloader::nextTiles(std::vector<TileID>& _requests) {
+
+    if (m_canceled) { return; }
+
+    while (m_pending.size() < m_options.maxPending) {
+
+        if (m_next == m_tiles.size()) {
+            if (m_zoom > m_region.maxZoom) { break; }
+
+            // Enumerate the next zoom level
+            m_tiles.clear();
+            m_next = 0;
+            getTiles(m_region, m_zoom++, m_tiles);
+            continue;
+        }
+
+        auto& tile = m_tiles[m_next++];
+        if (m_stored.count(tile)) {
+            m_progress.skipped++;
+            continue;
+        }
+
+        // Reserve the entry, the request ID is set in request()
+        m_pending.emplace(tile, 0);
+        _requests.push_back(tile);
+    }
+}
+
+void OfflineDownloader::fill() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_filling) { return; }
+        m_filling = true;
+    }
+
+    while (true) {
+        std::vector<TileID> requests;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            nextTiles(requests);
+
+            if (requests.empty()) {
+                m_filling = false;
+                break;
+            }
+        }
+
+        for (auto& tile : requests) {
+            request(tile);
+        }
+    }
+}
+
+void OfflineDownloader::request(const TileID& _tile) {
+
+    std::weak_ptr<OfflineDownloader> weak = shared_from_this();
+
+    DownloadScheduler::Request request;
+    request.url = m_network->constructURL(_tile);
+
+    // Yield to the requests of tiles for display
+    request.priority = []() { return std::numeric_limits<double>::max(); };
+
+    request.callback = [weak, _tile](std::vector<char>&& _data) {
+        if (auto self = weak.lock()) {
+            self->onResponse(_tile, std::move(_data));
+        }
+    };
+
+    auto id = m_network->scheduler()->request(std::move(request));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Not found when the request already finished within request()
+    auto it = m_pending.find(_tile);
+    if (it != m_pending.end()) { it->second = id; }
+}
+
+void OfflineDownloader::onResponse(const TileID& _tile, std::vector<char>&& _data) {
+
+    MBTilesDataSource::TileBatch batch;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Canceled meanwhile
+        if (m_pending.erase(_tile) == 0) { return; }
+
+        if (_data.empty()) {
+            LOGW("Could not download tile %s", _tile.toString().c_str());
+            m_progress.failed++;
+        } else {
+            m_progress.bytes += _data.size();
+            m_downloaded++;
+            m_batch.emplace_back(_tile, std::move(_data));
+        }
+
+        if (m_batch.size() >= m_options.batchSize) {
+            batch.swap(m_batch);
+            m_pendingWrites++;
+        }
+    }
+
+    if (!batch.empty()) {
+        flush(std::move(batch));
+    }
+
+    fill();
+    update();
+}
+
+void OfflineDownloader::flush(MBTilesDataSource::TileBatch _batch) {
+
+    uint64_t count = _batch.size();
+    std::weak_ptr<OfflineDownloader> weak = shared_from_this();
+
+    m_mbtiles->storeTiles(std::move(_batch), [weak, count](bool _ok) {
+        auto self = weak.lock();
+        if (!self) { return; }
+        {
+            std::lock_guard<std::mutex> lock(self->m_mutex);
+            self->m_pendingWrites--;
+            if (_ok) {
+                self->m_progress.stored += count;
+            } else {
+                self->m_progress.failed += count;
+            }
+        }
+        self->update();
+    });
+}
+
+void OfflineDownloader::update() {
+
+    MBTilesDataSource::TileBatch batch;
+    Progress progress;
+    bool done = false;
+    bool canceled = false;
+    ProgressCallback progressCb;
+    DoneCallback doneCb;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) { return; }
+
+        bool requested = m_canceled || (m_zoom > m_region.maxZoom && m_next == m_tiles.size());
+
+        // Write the remaining tiles once all responses arrived
+        if (requested && m_pending.empty() && !m_batch.empty()) {
+            batch.swap(m_batch);
+            m_pendingWrites++;
+        }
+
+        if (m_downloaded > 0) {
+            double average = double(m_progress.bytes) / m_downloaded;
+            m_progress.estimatedBytes = average * m_progress.total;
+        }
+
+        if (requested && m_pending.empty() && batch.empty() && m_pendingWrites == 0) {
+            m_running = false;
+            done = true;
+            canceled = m_canceled;
+        }
+
+        progress = m_progress;
+        progressCb = m_progressCb;
+        doneCb = m_doneCb;
+    }
+
+    if (!batch.empty()) {
+        // Reports progress again when written
+        flush(std::move(batch));
+    }
+
+    if (progressCb) { progressCb(progress); }
+
+    if (done && doneCb) { doneCb(progress, canceled); }
+}
+
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "data/downloadScheduler.h"
+#include "data/mbtilesDataSource.h"
+#include "tile/tileID.h"
+#include "util/types.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Tangram {
+
+class NetworkDataSource;
+
+/*
+ * Downloads the tiles of a region into an MBTiles file for offline use
+ *
+ * - The tiles of a polygon (or bounding box) and zoom range are enumerated
+ *   one zoom level at a time by rasterizing the polygon into the tile grid.
+ * - Tiles are requested with the URLs and the DownloadScheduler of a
+ *   NetworkDataSource. At most 'maxPending' requests are queued at a time so
+ *   that a large region does not crowd out the requests for visible tiles.
+ * - Downloaded tiles are written in batches, one transaction each, through
+ *   MBTilesDataSource::storeTiles.
+ * - Tiles which are already stored are skipped, so that starting the same
+ *   region again resumes an interrupted or partially failed download.
+ *
+ * Callbacks are called on the network or MBTiles worker threads.
+ */
+class OfflineDownloader : public std::enable_shared_from_this<OfflineDownloader> {
+
+public:
+
+    struct Region {
+        // Outer ring followed by optional holes, in degrees
+        std::vector<std::vector<LngLat>> polygon;
+        int32_t minZoom = 0;
+        int32_t maxZoom = 0;
+
+        // Region of the bounding box from @_southWest to @_northEast
+        static Region bounds(LngLat _southWest, LngLat _northEast, int32_t _minZoom, int32_t _maxZoom);
+    };
+
+    struct Options {
+        // Requests queued at the DownloadScheduler at a time
+        uint32_t maxPending = 16;
+        // Tiles written per transaction
+        uint32_t batchSize = 64;
+        // Tile size assumed for the estimate until tiles were downloaded
+        uint64_t averageTileSize = 20 * 1024;
+    };
+
+    struct Progress {
+        // Tiles of the region
+        uint64_t total = 0;
+        // Tiles downloaded and stored by this run
+        uint64_t stored = 0;
+        // Tiles which were stored before
+        uint64_t skipped = 0;
+        // Tiles which could not be downloaded or stored
+        uint64_t failed = 0;
+        // Bytes downloaded by this run
+        uint64_t bytes = 0;
+        // Estimated size of all tiles of the region
+        uint64_t estimatedBytes = 0;
+
+        uint64_t finished() const { return stored + skipped + failed; }
+    };
+
+    using ProgressCallback = std::function<void(const Progress&)>;
+    using DoneCallback = std::function<void(const Progress&, bool _canceled)>;
+
+    OfflineDownloader(std::shared_ptr<NetworkDataSource> _network,
+                      std::shared_ptr<MBTilesDataSource> _mbtiles,
+                      Options _options = Options());
+
+    ~OfflineDownloader();
+
+    // Append the tiles of @_region at @_zoom to @_tiles, sorted by TileID
+    static void getTiles(const Region& _region, int32_t _zoom, std::vector<TileID>& _tiles);
+
+    // Number of tiles of @_region
+    static uint64_t countTiles(const Region& _region);
+
+    // Estimated download size of @_region
+    static uint64_t estimateSize(const Region& _region, uint64_t _averageTileSize) {
+        return countTiles(_region) * _averageTileSize;
+    }
+
+    // Start downloading @_region. Returns false when a download is running
+    // or the MBTiles file is not writable.
+    bool start(const Region& _region, ProgressCallback _progress, DoneCallback _done);
+
+    // Stop the running download. Tiles downloaded so far are still stored.
+    void cancel();
+
+    bool isRunning() const;
+
+    Progress progress() const;
+
+private:
+
+    void begin(std::vector<TileID> _stored);
+
+    // Request tiles while fewer than 'maxPending' requests are pending
+    void fill();
+
+    // Take the next tiles to request, must be called with m_mutex held
+    void nextTiles(std::vector<TileID>& _requests);
+
+    void request(const TileID& _tile);
+    void onResponse(const TileID& _tile, std::vector<char>&& _data);
+    void flush(MBTilesDataSource::TileBatch _batch);
+
+    // Report progress and check for completion
+    void update();
+
+    std::shared_ptr<NetworkDataSource> m_network;
+    std::shared_ptr<MBTilesDataSource> m_mbtiles;
+    Options m_options;
+
+    Region m_region;
+    ProgressCallback m_progressCb;
+    DoneCallback m_doneCb;
+
+    bool m_running = false;
+    bool m_canceled = false;
+
+    // Tiles of the current zoom level and the next one to request
+    int32_t m_zoom = 0;
+    std::vector<TileID> m_tiles;
+    size_t m_next = 0;
+
+    std::set<TileID> m_stored;
+
+    // Pending requests; the request ID is 0 until the request is queued
+    std::map<TileID, DownloadScheduler::RequestID> m_pending;
+
+    MBTilesDataSource::TileBatch m_batch;
+    uint32_t m_pendingWrites = 0;
+
+    // Guard against recursion when responses arrive within request()
+    bool m_filling = false;
+
+    Progress m_progress;
+    uint64_t m_downloaded = 0;
+
+    mutable std::mutex m_mutex;
+};
+
+}
@@ -11,6 +11,7 @@ Properties::~Properties() {}
 Properties& Properties::operator=(Properties&& _other) {
     props = std::move(_other.props);
     sourceId = _other.sourceId;
+    featureId = _other.featureId;
     return *this;
 }
 
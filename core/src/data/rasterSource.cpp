@@ -79,12 +79,13 @@ RasterSource::RasterSource(const std::string& _name, std::unique_ptr<DataSource>
     m_emptyTexture = std::make_shared<Texture>(data, m_texOptions, m_genMipmap);
 }
 
-std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _rawTileData) {
-    if (_rawTileData.size() == 0) {
+std::shared_ptr<Texture> RasterSource::createTexture(const RawData& _rawTileData) {
+    if (_rawTileData.empty()) {
         return m_emptyTexture;
     }
 
-    auto texture = std::make_shared<Texture>(_rawTileData, m_texOptions, m_genMipmap);
+    auto texture = std::make_shared<Texture>(0u, 0u, m_texOptions, m_genMipmap);
+    texture->loadImageFromMemory(_rawTileData.data(), _rawTileData.size());
 
     return texture;
 }
@@ -43,7 +43,7 @@ public:
     virtual void clearRaster(const TileID& id) override;
     virtual bool isRaster() const override { return true; }
 
-    std::shared_ptr<Texture> createTexture(const std::vector<char>& _rawTileData);
+    std::shared_ptr<Texture> createTexture(const RawData& _rawTileData);
 
     Raster getRaster(const TileTask& _task);
 
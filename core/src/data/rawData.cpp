@@ -0,0 +1,60 @@
+#include "data/rawData.h"
+
+#include "log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Tangram {
+
+// Files below this size are cheaper to read than to map
+const size_t minMappedSize = 16 * 1024;
+
+std::shared_ptr<RawData> RawData::mapFile(const std::string& _path) {
+
+    int fd = open(_path.c_str(), O_RDONLY);
+    if (fd < 0) { return nullptr; }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t size = st.st_size;
+
+    if (size < minMappedSize) {
+        std::vector<char> buffer(size);
+        size_t offset = 0;
+        while (offset < size) {
+            ssize_t n = read(fd, buffer.data() + offset, size - offset);
+            if (n <= 0) { break; }
+            offset += n;
+        }
+        close(fd);
+
+        if (offset != size) {
+            LOGW("Could not read file %s", _path.c_str());
+            return nullptr;
+        }
+        return std::make_shared<RawData>(std::move(buffer));
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        LOGW("Could not map file %s", _path.c_str());
+        return nullptr;
+    }
+
+    std::shared_ptr<const void> mapping(addr, [size](const void* _addr) {
+        munmap(const_cast<void*>(_addr), size);
+    });
+
+    return std::make_shared<RawData>(static_cast<const char*>(addr), size, std::move(mapping));
+}
+
+}
@@ -0,0 +1,153 @@
+#include "data/rawTileCache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Tangram {
+
+// Budget of the process-wide cache
+const size_t sharedCacheSize = 32 * 1024 * 1024;
+
+RawTileCache::RawTileCache(size_t _maxUsage, uint32_t _shards)
+    : m_maxUsage(_maxUsage) {
+
+    _shards = std::max(_shards, 1u);
+    for (uint32_t i = 0; i < _shards; i++) {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+const std::shared_ptr<RawTileCache>& RawTileCache::shared() {
+    static std::shared_ptr<RawTileCache> cache = std::make_shared<RawTileCache>(sharedCacheSize);
+    return cache;
+}
+
+RawTileCache::Shard& RawTileCache::shard(const std::string& _key) {
+    return *m_shards[std::hash<std::string>()(_key) % m_shards.size()];
+}
+
+void RawTileCache::Shard::erase(size_t _slot) {
+    auto& entry = entries[_slot];
+    usage -= entry.data->size();
+    index.erase(entry.key);
+    entry = Entry();
+    freeSlots.push_back(_slot);
+}
+
+void RawTileCache::Shard::evict(size_t _maxUsage) {
+    // Every entry is passed at most twice: once to clear its reference bit
+    // and once to evict it
+    while (usage > _maxUsage && !index.empty()) {
+        if (hand >= entries.size()) { hand = 0; }
+
+        auto& entry = entries[hand];
+        if (entry.data) {
+            if (entry.referenced) {
+                entry.referenced = false;
+            } else {
+                erase(hand);
+                evictions++;
+            }
+        }
+        hand++;
+    }
+}
+
+void RawTileCache::setMaxUsage(size_t _maxUsage) {
+    m_maxUsage = _maxUsage;
+
+    size_t shardUsage = _maxUsage / m_shards.size();
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->evict(shardUsage);
+    }
+}
+
+RawTileCache::Data RawTileCache::get(const std::string& _key) {
+    auto& s = shard(_key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.index.find(_key);
+    if (it == s.index.end()) {
+        s.misses++;
+        return nullptr;
+    }
+    s.hits++;
+
+    auto& entry = s.entries[it->second];
+    entry.referenced = true;
+    return entry.data;
+}
+
+bool RawTileCache::contains(const std::string& _key) {
+    auto& s = shard(_key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    return s.index.find(_key) != s.index.end();
+}
+
+void RawTileCache::put(const std::string& _key, Data _data) {
+    if (!_data || _data->isView()) { return; }
+
+    size_t shardUsage = m_maxUsage / m_shards.size();
+    if (_data->size() > shardUsage) { return; }
+
+    auto& s = shard(_key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.index.find(_key);
+    if (it != s.index.end()) {
+        auto& entry = s.entries[it->second];
+        s.usage -= entry.data->size();
+        entry.data = _data;
+    } else {
+        size_t slot;
+        if (!s.freeSlots.empty()) {
+            slot = s.freeSlots.back();
+            s.freeSlots.pop_back();
+        } else {
+            slot = s.entries.size();
+            s.entries.emplace_back();
+        }
+        s.entries[slot].key = _key;
+        s.entries[slot].data = _data;
+        s.index.emplace(_key, slot);
+    }
+    s.usage += _data->size();
+
+    s.evict(shardUsage);
+}
+
+void RawTileCache::remove(const std::string& _key) {
+    auto& s = shard(_key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.index.find(_key);
+    if (it != s.index.end()) { s.erase(it->second); }
+}
+
+void RawTileCache::clear() {
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+        shard->freeSlots.clear();
+        shard->hand = 0;
+        shard->usage = 0;
+    }
+}
+
+RawTileCache::Stats RawTileCache::stats() const {
+    Stats stats;
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.usage += shard->usage;
+        stats.entries += shard->index.size();
+    }
+    return stats;
+}
+
+}
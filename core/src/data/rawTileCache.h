@@ -0,0 +1,99 @@
+#pragma once
+
+#include "data/rawData.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * Cache for raw tile data, keyed by the URL (or another unique key) of the data
+ *
+ * - A process-wide instance is shared by the MemoryCacheDataSources of all
+ *   scenes and Map instances, so that sources with the same URL template
+ *   share their cached data and one memory budget.
+ * - Entries are distributed over shards by key hash. Each shard has its own
+ *   lock and an equal part of the budget, so that lookups from the loading
+ *   threads of several sources do not contend on one mutex.
+ * - Entries are evicted with the CLOCK policy: hits only set a reference
+ *   bit, which is cheaper than reordering a LRU list under the lock. The
+ *   clock hand skips (and clears) referenced entries.
+ * - The budget counts heap memory only. Views of memory-mapped files are not
+ *   cached: mapping a file again is cheap and its pages are cached by the OS.
+ */
+class RawTileCache {
+
+public:
+
+    using Data = std::shared_ptr<RawData>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t usage = 0;
+        size_t entries = 0;
+    };
+
+    RawTileCache(size_t _maxUsage, uint32_t _shards = 16);
+
+    // The process-wide instance
+    static const std::shared_ptr<RawTileCache>& shared();
+
+    // Set the memory budget in bytes, evicting entries when shrinking
+    void setMaxUsage(size_t _maxUsage);
+    size_t maxUsage() const { return m_maxUsage; }
+
+    // Cached data of @_key or nullptr
+    Data get(const std::string& _key);
+
+    // Whether @_key is cached, without counting a hit or miss
+    bool contains(const std::string& _key);
+
+    // Add or replace the data of @_key. Data larger than the budget of a
+    // shard and views of mapped files are not cached.
+    void put(const std::string& _key, Data _data);
+
+    void remove(const std::string& _key);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+
+    struct Entry {
+        std::string key;
+        Data data;
+        bool referenced = false;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        // Entry slot by key
+        std::unordered_map<std::string, size_t> index;
+        std::vector<Entry> entries;
+        std::vector<size_t> freeSlots;
+        size_t hand = 0;
+        size_t usage = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+
+        void erase(size_t _slot);
+        void evict(size_t _maxUsage);
+    };
+
+    Shard& shard(const std::string& _key);
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<size_t> m_maxUsage;
+};
+
+}
@@ -7,11 +7,15 @@
 #include "platform.h"
 #include "log.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 
 namespace Tangram {
 
+// Parsed data tiles kept for overzoomed tiles, enough for the tiles in view
+const size_t maxParsedTiles = 8;
+
 TileSource::TileSource(const std::string& _name, std::unique_ptr<DataSource> _sources,
                        int32_t _minDisplayZoom, int32_t _maxDisplayZoom, int32_t _maxZoom) :
     m_name(_name),
@@ -52,10 +56,47 @@ void TileSource::createSubTasks(std::shared_ptr<TileTask> _task) {
     }
 }
 
+std::shared_ptr<TileData> TileSource::parseTile(const TileTask& _task, const MapProjection& _projection) {
+
+    const TileID& id = _task.tileId();
+    if (id.z != m_maxZoom || isRaster()) {
+        return parse(_task, _projection);
+    }
+
+    TileID dataID(id.x, id.y, id.z);
+    int64_t generation = _task.sourceGeneration();
+    {
+        std::lock_guard<std::mutex> lock(m_parsedTilesMutex);
+        for (auto it = m_parsedTiles.begin(); it != m_parsedTiles.end(); ++it) {
+            if (it->tileID == dataID && it->generation == generation) {
+                auto data = it->data;
+                std::rotate(it, it + 1, m_parsedTiles.end());
+                return data;
+            }
+        }
+    }
+
+    auto data = parse(_task, _projection);
+    if (!data) { return data; }
+
+    std::lock_guard<std::mutex> lock(m_parsedTilesMutex);
+    if (m_parsedTiles.size() == maxParsedTiles) {
+        m_parsedTiles.erase(m_parsedTiles.begin());
+    }
+    m_parsedTiles.push_back({ dataID, generation, data });
+
+    return data;
+}
+
 void TileSource::clearData() {
 
     if (m_sources) { m_sources->clear(); }
 
+    {
+        std::lock_guard<std::mutex> lock(m_parsedTilesMutex);
+        m_parsedTiles.clear();
+    }
+
     m_generation++;
 }
 
@@ -10,10 +10,10 @@
 #include "gl.h"
 #include "gl/error.h"
 
+#include <chrono>
 #include <deque>
-#include <ctime>
 
-#define TIME_TO_MS(start, end) (float(end - start) / CLOCKS_PER_SEC * 1000.0f)
+#define TIME_TO_MS(start, end) (std::chrono::duration<float, std::milli>(end - start).count())
 
 #define DEBUG_STATS_MAX_SIZE 128
 
@@ -21,15 +21,17 @@ namespace Tangram {
 
 static float s_lastUpdateTime = 0.0;
 
-static clock_t s_startFrameTime = 0,
-    s_endFrameTime = 0,
-    s_startUpdateTime = 0,
-    s_endUpdateTime = 0;
+using Clock = std::chrono::steady_clock;
+
+static Clock::time_point s_startFrameTime,
+    s_endFrameTime,
+    s_startUpdateTime,
+    s_endUpdateTime;
 
 void FrameInfo::beginUpdate() {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
-        s_startUpdateTime = clock();
+        s_startUpdateTime = Clock::now();
     }
 
 }
@@ -37,7 +39,7 @@ void FrameInfo::beginUpdate() {
 void FrameInfo::endUpdate() {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
-        s_endUpdateTime = clock();
+        s_endUpdateTime = Clock::now();
         s_lastUpdateTime = TIME_TO_MS(s_startUpdateTime, s_endUpdateTime);
     }
 
@@ -46,7 +48,7 @@ void FrameInfo::endUpdate() {
 void FrameInfo::beginFrame() {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
-        s_startFrameTime = clock();
+        s_startFrameTime = Clock::now();
     }
 
 }
@@ -60,7 +62,7 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
         static std::deque<float> updatetime;
         static std::deque<float> rendertime;
 
-        clock_t endCpu = clock();
+        auto endCpu = Clock::now();
         static float timeCpu[60] = { 0 };
         static float timeUpdate[60] = { 0 };
         static float timeRender[60] = { 0 };
@@ -79,7 +81,7 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
         // Force opengl to finish commands (for accurate frame time)
         GL::finish();
 
-        s_endFrameTime = clock();
+        s_endFrameTime = Clock::now();
         timeRender[cpt] = TIME_TO_MS(s_startFrameTime, s_endFrameTime);
 
         if (++cpt == 60) { cpt = 0; }
@@ -104,7 +106,7 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
         size_t features = 0;
         for (const auto& tile : _tileManager.getVisibleTiles()) {
             memused += tile->getMemoryUsage();
-            features += tile->getSelectionFeatures().size();
+            features += tile->getSelectionFeatureCount();
         }
 
         if (getDebugFlag(DebugFlags::tangram_infos)) {
@@ -117,6 +119,9 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
             debuginfos.push_back("tile cache size:"
                                  + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
             debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            const auto& prefetch = _tileManager.prefetchStats();
+            debuginfos.push_back("prefetch requested/hit/wasted:" + std::to_string(prefetch.requested) + "/"
+                                 + std::to_string(prefetch.hits) + "/" + std::to_string(prefetch.wasted));
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
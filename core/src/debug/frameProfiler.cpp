@@ -0,0 +1,212 @@
+#include "debug/frameProfiler.h"
+
+#include "gl/hardware.h"
+#include "style/style.h"
+
+namespace Tangram {
+
+FrameProfiler::~FrameProfiler() {
+    deleteQueries();
+}
+
+void FrameProfiler::setEnabled(bool _enabled) {
+    m_enabled = _enabled;
+
+    if (!_enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasPublished = false;
+    }
+}
+
+void FrameProfiler::beginUpdate() {
+    if (!m_enabled) { return; }
+
+    m_updateStart = Clock::now();
+    m_labelTime = 0;
+}
+
+void FrameProfiler::endUpdate() {
+    if (!m_enabled) { return; }
+
+    m_updateTime = elapsed(m_updateStart);
+}
+
+void FrameProfiler::beginLabels() {
+    if (!m_enabled) { return; }
+
+    m_labelStart = Clock::now();
+}
+
+void FrameProfiler::endLabels() {
+    if (!m_enabled) { return; }
+
+    m_labelTime += elapsed(m_labelStart);
+}
+
+void FrameProfiler::beginFrame(RenderState& _rs) {
+
+    m_current = nullptr;
+
+    if (!m_enabled) {
+        // Release the queries of a previous session
+        if (m_useTimers) {
+            deleteQueries();
+            m_useTimers = false;
+        }
+        return;
+    }
+
+    m_disposer = Disposer(_rs);
+
+    if (m_useTimers) {
+        collectResults();
+    }
+    m_useTimers = Hardware::supportsTimerQuery;
+    m_checkDisjoint = m_useTimers && Hardware::isAvailable("disjoint_timer_query");
+
+    // Reuse the slot of the oldest frame; its stats are dropped if its
+    // queries are still not available
+    m_current = &m_frames[m_frameCount % maxFrames];
+
+    auto& stats = m_current->stats;
+    stats = FrameStats();
+    stats.frame = ++m_frameCount;
+    stats.updateTime = m_updateTime;
+    stats.labelTime = m_labelTime;
+    m_current->pending = false;
+
+    _rs.counters = RenderState::Counters();
+    m_frameStart = Clock::now();
+}
+
+void FrameProfiler::beginStyle(RenderState& _rs, const Style& _style) {
+    if (!m_current) { return; }
+
+    auto& frame = *m_current;
+    size_t index = frame.stats.styles.size();
+
+    FrameStats::StyleStats style;
+    style.name = _style.getName();
+    frame.stats.styles.push_back(std::move(style));
+
+    if (m_useTimers) {
+        if (frame.queries.size() <= index) {
+            GLuint query = 0;
+            GL::genQueries(1, &query);
+            frame.queries.push_back(query);
+        }
+        GL::beginQuery(GL_TIME_ELAPSED, frame.queries[index]);
+    }
+
+    m_styleCounters = _rs.counters;
+    m_styleStart = Clock::now();
+}
+
+void FrameProfiler::endStyle(RenderState& _rs) {
+    if (!m_current || m_current->stats.styles.empty()) { return; }
+
+    if (m_useTimers) {
+        GL::endQuery(GL_TIME_ELAPSED);
+    }
+
+    auto& style = m_current->stats.styles.back();
+    style.cpuTime = elapsed(m_styleStart);
+    style.drawCalls = _rs.counters.drawCalls - m_styleCounters.drawCalls;
+    style.vertices = _rs.counters.vertices - m_styleCounters.vertices;
+}
+
+void FrameProfiler::endFrame(RenderState& _rs, uint32_t _tilesDrawn) {
+    if (!m_current) { return; }
+
+    auto& stats = m_current->stats;
+    stats.renderTime = elapsed(m_frameStart);
+    stats.tilesDrawn = _tilesDrawn;
+    stats.drawCalls = _rs.counters.drawCalls;
+    stats.vertices = _rs.counters.vertices;
+    stats.uploadBytes = _rs.counters.uploadBytes;
+
+    if (m_useTimers && !stats.styles.empty()) {
+        m_current->pending = true;
+    } else {
+        publish(stats);
+    }
+    m_current = nullptr;
+}
+
+void FrameProfiler::collectResults() {
+
+    // Frames in the order they were drawn
+    for (size_t i = 0; i < maxFrames; i++) {
+        auto& frame = m_frames[(m_frameCount + i) % maxFrames];
+        if (!frame.pending) { continue; }
+
+        // Queries complete in order, so the last one is available last
+        GLuint available = 0;
+        GL::getQueryObjectuiv(frame.queries[frame.stats.styles.size() - 1],
+                              GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) { break; }
+
+        // The results are undefined after a disjoint operation, e.g. a power state change
+        GLint disjoint = 0;
+        if (m_checkDisjoint) {
+            GL::getIntegerv(GL_GPU_DISJOINT, &disjoint);
+        }
+
+        if (!disjoint) {
+            frame.stats.gpuTime = 0;
+            for (size_t s = 0; s < frame.stats.styles.size(); s++) {
+                uint64_t nanoseconds = 0;
+                GL::getQueryObjectui64v(frame.queries[s], GL_QUERY_RESULT, &nanoseconds);
+                frame.stats.styles[s].gpuTime = nanoseconds / 1e6f;
+                frame.stats.gpuTime += frame.stats.styles[s].gpuTime;
+            }
+        }
+
+        frame.pending = false;
+        publish(frame.stats);
+    }
+}
+
+void FrameProfiler::publish(const FrameStats& _stats) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_enabled) { return; }
+
+    m_published = _stats;
+    m_hasPublished = true;
+}
+
+bool FrameProfiler::getStats(FrameStats& _stats) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_hasPublished) { return false; }
+
+    _stats = m_published;
+    return true;
+}
+
+void FrameProfiler::deleteQueries() {
+
+    std::vector<GLuint> queries;
+    for (auto& frame : m_frames) {
+        queries.insert(queries.end(), frame.queries.begin(), frame.queries.end());
+        frame.queries.clear();
+        frame.pending = false;
+    }
+
+    if (queries.empty()) { return; }
+
+    m_disposer([=](RenderState& rs) {
+        GL::deleteQueries(queries.size(), queries.data());
+    });
+}
+
+void FrameProfiler::invalidate() {
+    for (auto& frame : m_frames) {
+        frame.queries.clear();
+        frame.pending = false;
+    }
+    m_current = nullptr;
+}
+
+}
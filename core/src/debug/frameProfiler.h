@@ -0,0 +1,104 @@
+#pragma once
+
+#include "gl/disposer.h"
+#include "gl/renderState.h"
+#include "tangram.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class Style;
+
+/*
+ * Collects the FrameStats of Map::update and Map::render
+ *
+ * Times are taken from a steady wall clock. The GPU time of each style is measured
+ * with a GL_TIME_ELAPSED query where Hardware::supportsTimerQuery is set. Query
+ * results are polled without waiting for the GPU, so the stats of a frame are
+ * published once all of its queries are available, usually a few frames later.
+ * Without timer queries the stats are published at the end of the frame.
+ *
+ * All methods but setEnabled() and getStats() must be called on the GL thread.
+ */
+class FrameProfiler {
+
+public:
+
+    ~FrameProfiler();
+
+    void setEnabled(bool _enabled);
+    bool enabled() const { return m_enabled; }
+
+    void beginUpdate();
+    void endUpdate();
+
+    void beginLabels();
+    void endLabels();
+
+    void beginFrame(RenderState& _rs);
+    void endFrame(RenderState& _rs, uint32_t _tilesDrawn);
+
+    // Measure the draw calls between beginStyle and endStyle as the draw of @_style
+    void beginStyle(RenderState& _rs, const Style& _style);
+    void endStyle(RenderState& _rs);
+
+    // Copy the latest published stats, returns false when there are none
+    bool getStats(FrameStats& _stats) const;
+
+    // Drop the queries of a lost GL context without deleting them
+    void invalidate();
+
+private:
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        FrameStats stats;
+        // Timer query of each entry of stats.styles
+        std::vector<GLuint> queries;
+        // Waiting for the results of its queries
+        bool pending = false;
+    };
+
+    static float elapsed(Clock::time_point _start) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - _start).count();
+    }
+
+    // Publish the pending frames whose query results are available, oldest first
+    void collectResults();
+
+    void publish(const FrameStats& _stats);
+
+    void deleteQueries();
+
+    std::atomic<bool> m_enabled{false};
+
+    // Frames in flight, reused round robin
+    static constexpr size_t maxFrames = 4;
+    std::array<Frame, maxFrames> m_frames;
+    Frame* m_current = nullptr;
+    uint64_t m_frameCount = 0;
+    bool m_useTimers = false;
+    bool m_checkDisjoint = false;
+
+    Clock::time_point m_updateStart;
+    Clock::time_point m_labelStart;
+    Clock::time_point m_frameStart;
+    Clock::time_point m_styleStart;
+    RenderState::Counters m_styleCounters;
+    float m_updateTime = 0;
+    float m_labelTime = 0;
+
+    FrameStats m_published;
+    bool m_hasPublished = false;
+    mutable std::mutex m_mutex;
+
+    Disposer m_disposer;
+};
+
+}
@@ -0,0 +1,142 @@
+#include "debug/trace.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace Tangram {
+namespace Trace {
+
+std::atomic<bool> s_enabled{false};
+
+// Spans kept per thread
+constexpr size_t bufferSize = 4096;
+
+struct Span {
+    const char* name;
+    int64_t start;
+    int64_t duration;
+    int32_t x, y;
+    int8_t z;
+    bool hasTile;
+};
+
+// Written only by its thread. A span is published by incrementing head after
+// writing its slot, readers skip the slot that may be written concurrently.
+struct ThreadBuffer {
+    std::array<Span, bufferSize> spans;
+    std::atomic<uint64_t> head{0};
+    // Index of the first span recorded after the last clear()
+    std::atomic<uint64_t> cleared{0};
+    uint32_t threadId = 0;
+};
+
+static std::mutex s_buffersMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+
+static ThreadBuffer& threadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+
+        // Buffers outlive their threads, so that their spans can still be written out
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffer->threadId = s_buffers.size() + 1;
+        s_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void setEnabled(bool _enabled) {
+    s_enabled = _enabled;
+}
+
+int64_t now() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char* _name, int64_t _start, const TileID* _tileID) {
+
+    auto& buffer = threadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+
+    auto& span = buffer.spans[head % bufferSize];
+    span.name = _name;
+    span.start = _start;
+    span.duration = now() - _start;
+    span.hasTile = _tileID != nullptr;
+    if (_tileID) {
+        span.x = _tileID->x;
+        span.y = _tileID->y;
+        span.z = _tileID->z;
+    }
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::string json() {
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffers = s_buffers;
+    }
+
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+
+    std::vector<Span> spans;
+
+    for (auto& buffer : buffers) {
+        uint64_t end = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = std::max(end > bufferSize ? end - bufferSize : 0, buffer->cleared.load());
+
+        spans.clear();
+        for (uint64_t i = begin; i < end; i++) {
+            spans.push_back(buffer->spans[i % bufferSize]);
+        }
+
+        // Drop the spans that were overwritten while copying, including the one being written
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t valid = head >= bufferSize ? head - bufferSize + 1 : 0;
+
+        for (uint64_t i = std::max(begin, valid); i < end; i++) {
+            const auto& span = spans[i - begin];
+
+            if (!first) { out << ","; }
+            first = false;
+
+            out << "{\"name\":\"" << span.name << "\",\"ph\":\"X\",\"pid\":1"
+                << ",\"tid\":" << buffer->threadId
+                << ",\"ts\":" << span.start
+                << ",\"dur\":" << span.duration;
+
+            if (span.hasTile) {
+                out << ",\"args\":{\"tile\":\"" << int(span.z) << "/" << span.x << "/" << span.y << "\"}";
+            }
+            out << "}";
+        }
+    }
+
+    out << "],\"displayTimeUnit\":\"ms\"}";
+
+    return out.str();
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+
+    for (auto& buffer : s_buffers) {
+        buffer->cleared = buffer->head.load();
+    }
+}
+
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "tile/tileID.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+/*
+ * Spans of the tile pipeline for Chrome trace-event export
+ *
+ * Each thread records its spans into its own fixed size ring buffer without
+ * locking; the oldest spans of a thread are overwritten when its buffer is full.
+ * Recording is a single atomic load while tracing is disabled. Span names must
+ * be string literals, they are stored by pointer.
+ */
+namespace Trace {
+
+extern std::atomic<bool> s_enabled;
+
+inline bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+void setEnabled(bool _enabled);
+
+// Microseconds of a steady clock
+int64_t now();
+
+// Record the span @_name from @_start to now on the calling thread, with the
+// tile @_tileID when not null
+void record(const char* _name, int64_t _start, const TileID* _tileID = nullptr);
+
+// Spans recorded by all threads as a Chrome trace-event JSON document,
+// as loaded by chrome://tracing
+std::string json();
+
+// Drop the recorded spans
+void clear();
+
+}
+
+// Records a span over the scope of the object
+class TraceSpan {
+
+public:
+
+    explicit TraceSpan(const char* _name) :
+        m_name(_name), m_start(Trace::enabled() ? Trace::now() : -1), m_tileID(0, 0, 0), m_hasTile(false) {}
+
+    TraceSpan(const char* _name, const TileID& _tileID) :
+        m_name(_name), m_start(Trace::enabled() ? Trace::now() : -1), m_tileID(_tileID), m_hasTile(true) {}
+
+    ~TraceSpan() {
+        if (m_start >= 0) { Trace::record(m_name, m_start, m_hasTile ? &m_tileID : nullptr); }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_start;
+    TileID m_tileID;
+    bool m_hasTile;
+};
+
+}
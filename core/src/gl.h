@@ -53,6 +53,7 @@ typedef float           GLclampf;   /*single precision float in [0,1] */
 typedef double          GLdouble;   /* double precision float */
 typedef double          GLclampd;   /* double precision float in [0,1] */
 typedef char            GLchar;
+typedef struct __GLsync *GLsync;
 
 /* Utility */
 #define GL_VENDOR                       0x1F00
@@ -273,9 +274,30 @@ typedef char            GLchar;
 #define GL_WRITE_ONLY                   0x88B9
 #define GL_READ_WRITE                   0x88BA
 
+// scissor
+#define GL_SCISSOR_TEST                 0x0C11
+
+// pixel buffer objects and sync objects (OpenGL 3.2, OpenGL ES 3.0)
+#define GL_PIXEL_PACK_BUFFER            0x88EB
+#define GL_STREAM_READ                  0x88E1
+#define GL_MAP_READ_BIT                 0x0001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE   0x9117
+#define GL_ALREADY_SIGNALED             0x911A
+#define GL_TIMEOUT_EXPIRED              0x911B
+#define GL_CONDITION_SATISFIED          0x911C
+#define GL_WAIT_FAILED                  0x911D
+
+// timer queries (ARB_timer_query, EXT_disjoint_timer_query)
+#define GL_TIME_ELAPSED                 0x88BF
+#define GL_QUERY_RESULT                 0x8866
+#define GL_QUERY_RESULT_AVAILABLE       0x8867
+#define GL_GPU_DISJOINT                 0x8FBB
+
 #define GL_MAX_TEXTURE_SIZE             0x0D33
 #define GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS 0x8B4D
 
+#include <cstdint>
+
 namespace Tangram {
 struct GL {
     static GLenum getError(void);
@@ -284,6 +306,7 @@ struct GL {
     static void clear(GLbitfield mask);
     static void lineWidth(GLfloat width);
     static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
 
     static void enable(GLenum);
     static void disable(GLenum);
@@ -407,6 +430,20 @@ struct GL {
     // mapbuffer
     static void *mapBuffer(GLenum target, GLenum access);
     static GLboolean unmapBuffer(GLenum target);
+    static void *mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+
+    // sync objects
+    static GLsync fenceSync(GLenum condition, GLbitfield flags);
+    static GLenum clientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout);
+    static void deleteSync(GLsync sync);
+
+    // timer queries
+    static void genQueries(GLsizei n, GLuint *ids);
+    static void deleteQueries(GLsizei n, const GLuint *ids);
+    static void beginQuery(GLenum target, GLuint id);
+    static void endQuery(GLenum target);
+    static void getQueryObjectuiv(GLuint id, GLenum pname, GLuint *params);
+    static void getQueryObjectui64v(GLuint id, GLenum pname, uint64_t *params);
 
     static void finish(void);
 
@@ -145,6 +145,8 @@ bool DynamicQuadMesh<T>::draw(RenderState& rs, ShaderProgram& shader, int textur
         size_t byteOffset = verticesDrawn * m_vertexLayout->getStride();
         m_vertexLayout->enable(rs, shader, byteOffset);
         GL::drawElements(m_drawMode, elementsInBatch, GL_UNSIGNED_SHORT, 0);
+        rs.counters.drawCalls++;
+        rs.counters.vertices += elementsInBatch;
 
         // Update counters.
         verticesDrawn += verticesInBatch;
@@ -8,8 +8,14 @@
 #include "log.h"
 #include "glm/vec2.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace Tangram {
 
+// Pixel buffers for selection reads in flight
+const size_t maxAsyncReads = 4;
+
 FrameBuffer::FrameBuffer(int _width, int _height, bool _colorRenderBuffer) :
     m_glFrameBufferHandle(0),
     m_valid(false),
@@ -71,7 +77,7 @@ GLuint FrameBuffer::readAt(float _normalizedX, float _normalizedY) const {
     return pixel;
 }
 
-FrameBuffer::PixelRect FrameBuffer::readRect(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) const {
+FrameBuffer::PixelRect FrameBuffer::pixelRect(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) const {
 
     PixelRect rect;
     rect.left = fminf(fmaxf(floorf(_normalizedX * m_width), 0.f), m_width);
@@ -79,6 +85,15 @@ FrameBuffer::PixelRect FrameBuffer::readRect(float _normalizedX, float _normaliz
     rect.width = fminf(fmaxf(ceilf(_normalizedW * m_width), 0.f), m_width - rect.left);
     rect.height = fminf(fmaxf(ceilf(_normalizedH * m_height), 0.f), m_height - rect.bottom);
 
+    return rect;
+}
+
+FrameBuffer::PixelRect FrameBuffer::readRect(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) const {
+
+    PixelRect rect = pixelRect(_normalizedX, _normalizedY, _normalizedW, _normalizedH);
+
+    if (rect.width == 0 || rect.height == 0) { return rect; }
+
     rect.pixels.resize(rect.width * rect.height);
 
     GL::readPixels(rect.left, rect.bottom, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, rect.pixels.data());
@@ -86,6 +101,109 @@ FrameBuffer::PixelRect FrameBuffer::readRect(float _normalizedX, float _normaliz
     return rect;
 }
 
+int FrameBuffer::readRectAsync(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) {
+
+    if (!Hardware::supportsPixelBufferObjects || !m_valid) { return 0; }
+
+    PixelRect rect = pixelRect(_normalizedX, _normalizedY, _normalizedW, _normalizedH);
+
+    // Nothing to read, readRect() returns the empty rect without a GL call
+    if (rect.width == 0 || rect.height == 0) { return 0; }
+
+    auto it = std::find_if(m_asyncReads.begin(), m_asyncReads.end(),
+                           [](const auto& _read) { return _read.id == 0; });
+
+    if (it == m_asyncReads.end()) {
+        if (m_asyncReads.size() == maxAsyncReads) { return 0; }
+        it = m_asyncReads.emplace(m_asyncReads.end());
+    }
+
+    AsyncRead& read = *it;
+    read.rect = rect;
+
+    if (!read.buffer) {
+        GL::genBuffers(1, &read.buffer);
+    }
+
+    GL::bindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+    GL::bufferData(GL_PIXEL_PACK_BUFFER, read.rect.width * read.rect.height * sizeof(GLuint),
+                   nullptr, GL_STREAM_READ);
+
+    // Reads into the bound pixel buffer at offset 0
+    GL::readPixels(read.rect.left, read.rect.bottom, read.rect.width, read.rect.height,
+                   GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    GL::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    read.fence = GL::fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!read.fence) { return 0; }
+
+    // IDs are unique across framebuffers, such that reads of a replaced framebuffer are not
+    // confused with the reads of its replacement.
+    static int s_asyncReadId = 0;
+    read.id = ++s_asyncReadId;
+
+    return read.id;
+}
+
+bool FrameBuffer::readRectAsyncResult(int _id, PixelRect& _rect) {
+
+    auto it = std::find_if(m_asyncReads.begin(), m_asyncReads.end(),
+                           [&](const auto& _read) { return _read.id == _id; });
+
+    if (it == m_asyncReads.end()) {
+        _rect = PixelRect();
+        return true;
+    }
+
+    AsyncRead& read = *it;
+
+    GLenum status = GL::clientWaitSync(read.fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) { return false; }
+
+    GL::deleteSync(read.fence);
+    read.fence = nullptr;
+    read.id = 0;
+
+    _rect = read.rect;
+
+    if (status == GL_WAIT_FAILED) {
+        LOGW("Could not wait for the selection buffer read");
+        _rect.width = _rect.height = 0;
+        return true;
+    }
+
+    size_t size = _rect.width * _rect.height;
+    _rect.pixels.resize(size);
+
+    GL::bindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+
+    auto* pixels = GL::mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size * sizeof(GLuint), GL_MAP_READ_BIT);
+    if (pixels) {
+        std::memcpy(_rect.pixels.data(), pixels, size * sizeof(GLuint));
+        GL::unmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        std::fill(_rect.pixels.begin(), _rect.pixels.end(), 0);
+    }
+
+    GL::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    return true;
+}
+
+void FrameBuffer::scissor(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) {
+
+    if (_normalizedW <= 0 || _normalizedH <= 0) {
+        GL::disable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    PixelRect rect = pixelRect(_normalizedX, _normalizedY, _normalizedW, _normalizedH);
+
+    GL::enable(GL_SCISSOR_TEST);
+    GL::scissor(rect.left, rect.bottom, rect.width, rect.height);
+}
+
 void FrameBuffer::init(RenderState& _rs) {
 
     if (!Hardware::supportsGLRGBA8OES && m_colorRenderBuffer) {
@@ -165,11 +283,17 @@ void FrameBuffer::init(RenderState& _rs) {
 FrameBuffer::~FrameBuffer() {
 
     GLuint glHandle = m_glFrameBufferHandle;
+    auto asyncReads = std::move(m_asyncReads);
 
     m_disposer([=](RenderState& rs) {
         rs.framebufferUnset(glHandle);
 
         GL::deleteFramebuffers(1, &glHandle);
+
+        for (auto& read : asyncReads) {
+            if (read.fence) { GL::deleteSync(read.fence); }
+            GL::deleteBuffers(1, &read.buffer);
+        }
     });
 }
 
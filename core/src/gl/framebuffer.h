@@ -41,12 +41,35 @@ public:
 
     PixelRect readRect(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) const;
 
+    // Start reading a rect into a pixel buffer object without waiting for the GPU. Returns an ID
+    // for readRectAsyncResult(), or 0 when pixel buffer objects are not supported, all of the
+    // pixel buffers are in use or the rect is empty.
+    int readRectAsync(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH);
+
+    // Get the pixels of the read @_id; returns false while the GPU has not finished the read.
+    // Unknown reads, e.g. of a previous framebuffer, return an empty rect.
+    bool readRectAsyncResult(int _id, PixelRect& _rect);
+
+    // Restrict drawing to a rect, or to the whole framebuffer with an empty rect
+    void scissor(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH);
+
     void drawDebug(RenderState& _rs, glm::vec2 _dim);
 
 private:
 
     void init(RenderState& _rs);
 
+    PixelRect pixelRect(float _normalizedX, float _normalizedY, float _normalizedW, float _normalizedH) const;
+
+    struct AsyncRead {
+        int id = 0;
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        PixelRect rect;
+    };
+
+    std::vector<AsyncRead> m_asyncReads;
+
     std::unique_ptr<Texture> m_texture;
 
     Disposer m_disposer;
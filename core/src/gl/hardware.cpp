@@ -14,6 +14,8 @@ namespace Tangram {
 namespace Hardware {
 
 bool supportsMapBuffer = false;
+bool supportsPixelBufferObjects = false;
+bool supportsTimerQuery = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
 bool supportsGLRGBA8OES = false;
@@ -65,6 +67,9 @@ void loadExtensions() {
 
     // find extension symbols if needed
     initGLExtensions();
+
+    LOG("Driver supports pixel buffer objects: %d", supportsPixelBufferObjects);
+    LOG("Driver supports timer queries: %d", supportsTimerQuery);
 }
 
 void loadCapabilities() {
@@ -6,6 +6,8 @@ namespace Tangram {
 namespace Hardware {
 
 extern bool supportsMapBuffer;
+extern bool supportsPixelBufferObjects;
+extern bool supportsTimerQuery;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
 extern bool supportsGLRGBA8OES;
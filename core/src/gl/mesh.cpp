@@ -1,4 +1,5 @@
 #include "gl/mesh.h"
+#include "debug/trace.h"
 #include "gl/shaderProgram.h"
 #include "gl/renderState.h"
 #include "gl/hardware.h"
@@ -117,11 +118,15 @@ void MeshBase::subDataUpload(RenderState& rs, GLbyte* _data) {
         GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, data, m_hint);
     }
 
+    rs.counters.uploadBytes += vertexBytes;
+
     m_dirty = false;
 }
 
 void MeshBase::upload(RenderState& rs) {
 
+    TraceSpan span("MeshBase::upload");
+
     // Generate vertex buffer, if needed
     if (m_glVertexBuffer == 0) {
         GL::genBuffers(1, &m_glVertexBuffer);
@@ -132,6 +137,7 @@ void MeshBase::upload(RenderState& rs) {
 
     rs.vertexBuffer(m_glVertexBuffer);
     GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, m_glVertexData, m_hint);
+    rs.counters.uploadBytes += vertexBytes;
 
     delete[] m_glVertexData;
     m_glVertexData = nullptr;
@@ -146,6 +152,7 @@ void MeshBase::upload(RenderState& rs) {
         rs.indexBuffer(m_glIndexBuffer);
 
         GL::bufferData(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * sizeof(GLushort), m_glIndexData, m_hint);
+        rs.counters.uploadBytes += m_nIndices * sizeof(GLushort);
 
         delete[] m_glIndexData;
         m_glIndexData = nullptr;
@@ -209,8 +216,12 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
         if (nIndices > 0) {
             GL::drawElements(m_drawMode, nIndices, GL_UNSIGNED_SHORT,
                              (void*)(indiceOffset * sizeof(GLushort)));
+            rs.counters.drawCalls++;
+            rs.counters.vertices += nIndices;
         } else if (nVertices > 0) {
             GL::drawArrays(m_drawMode, 0, nVertices);
+            rs.counters.drawCalls++;
+            rs.counters.vertices += nVertices;
         }
 
         vertexOffset += nVertices;
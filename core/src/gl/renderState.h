@@ -106,6 +106,14 @@ public:
 
     std::array<GLuint, MAX_ATTRIBUTES> attributeBindings = { { 0 } };
 
+    // Work submitted to the GPU, accumulated until reset by the owner of the RenderState
+    struct Counters {
+        uint32_t drawCalls = 0;
+        uint32_t vertices = 0;
+        size_t uploadBytes = 0;
+    };
+    Counters counters;
+
     JobQueue jobQueue;
 
     std::unordered_map<std::string, GLuint> fragmentShaders;
@@ -18,9 +18,45 @@
 #include "stb_image.h"
 
 #include <cstring> // for memset
+#include <mutex>
 
 namespace Tangram {
 
+// Pixel buffers are returned to a pool after upload and reused for decoding
+// the next images, e.g. raster tiles, instead of being reallocated each time
+const size_t maxPooledBuffers = 4;
+const size_t maxPooledPixels = 1024 * 1024;
+
+static std::mutex s_poolMutex;
+static std::vector<std::vector<GLuint>> s_pixelPool;
+
+static std::vector<GLuint> acquirePixels(size_t _pixels) {
+    std::lock_guard<std::mutex> lock(s_poolMutex);
+
+    for (auto it = s_pixelPool.begin(); it != s_pixelPool.end(); ++it) {
+        if (it->capacity() >= _pixels) {
+            std::vector<GLuint> buffer = std::move(*it);
+            s_pixelPool.erase(it);
+            buffer.resize(_pixels);
+            return buffer;
+        }
+    }
+    return std::vector<GLuint>(_pixels);
+}
+
+static void releasePixels(std::vector<GLuint>& _buffer) {
+    std::vector<GLuint> buffer;
+    buffer.swap(_buffer);
+
+    if (buffer.capacity() == 0 || buffer.capacity() > maxPooledPixels) { return; }
+
+    std::lock_guard<std::mutex> lock(s_poolMutex);
+    if (s_pixelPool.size() < maxPooledBuffers) {
+        buffer.clear();
+        s_pixelPool.push_back(std::move(buffer));
+    }
+}
+
 Texture::Texture(unsigned int _width, unsigned int _height, TextureOptions _options, bool _generateMipmaps)
     : m_options(_options), m_generateMipmaps(_generateMipmaps) {
 
@@ -51,27 +87,36 @@ Texture::~Texture() {
 }
 
 bool Texture::loadImageFromMemory(const std::vector<char>& _data) {
+    return loadImageFromMemory(_data.data(), _data.size());
+}
+
+bool Texture::loadImageFromMemory(const char* _data, size_t _size) {
     unsigned char* pixels = nullptr;
     int width, height, comp;
 
-    if (_data.size() != 0) {
-        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(_data.data()), _data.size(), &width, &height, &comp, STBI_rgb_alpha);
+    if (_size != 0) {
+        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(_data), _size, &width, &height, &comp, STBI_rgb_alpha);
     }
 
     if (pixels) {
+        resize(width, height);
+
         // stbi_load_from_memory loads the image as a series of scanlines starting from
-        // the top-left corner of the image. This call flips the output such that the data
-        // begins at the bottom-left corner, as required for our OpenGL texture coordinates.
+        // the top-left corner of the image. The rows are copied in reverse order such
+        // that the data begins at the bottom-left corner, as required for our OpenGL
+        // texture coordinates.
         auto* rgbaPixels = reinterpret_cast<GLuint*>(pixels);
 
-        Texture::flipImageData(rgbaPixels, width, height);
-
-        resize(width, height);
-
-        setData(rgbaPixels, width * height);
+        m_data = acquirePixels(width * height);
+        for (int row = 0; row < height; row++) {
+            std::memcpy(&m_data[row * width], &rgbaPixels[(height - row - 1) * width],
+                        width * sizeof(GLuint));
+        }
 
         stbi_image_free(pixels);
 
+        setDirty(0, m_height);
+
         return true;
     }
     // Default inconsistent texture data is set to a 1*1 pixel texture
@@ -122,7 +167,8 @@ void Texture::setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
 
     // Init m_data if update() was not called after resize()
     if (m_data.size() != (m_width * m_height) / divisor) {
-        m_data.resize((m_width * m_height) / divisor);
+        releasePixels(m_data);
+        m_data = acquirePixels((m_width * m_height) / divisor);
     }
 
     // update m_data with subdata
@@ -210,7 +256,7 @@ void Texture::update(RenderState& rs, GLuint _textureUnit) {
     if (m_glHandle == 0) {
         if (m_data.size() == 0) {
             size_t divisor = sizeof(GLuint) / bytesPerPixel();
-            m_data.resize((m_width * m_height) / divisor, 0);
+            m_data = acquirePixels((m_width * m_height) / divisor);
         }
     }
 
@@ -218,7 +264,8 @@ void Texture::update(RenderState& rs, GLuint _textureUnit) {
 
     update(rs, _textureUnit, data);
 
-    m_data.clear();
+    // The data is not needed after upload, free it
+    releasePixels(m_data);
 }
 
 void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
@@ -244,6 +291,10 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
                        m_width, m_height, 0, m_options.format,
                        GL_UNSIGNED_BYTE, data);
 
+        if (data) {
+            rs.counters.uploadBytes += m_width * m_height * bytesPerPixel();
+        }
+
         if (data && m_generateMipmaps) {
             // generate the mipmaps for this texture
             GL::generateMipmap(m_target);
@@ -260,6 +311,7 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
         GL::texSubImage2D(m_target, 0, 0, range.min, m_width, range.max - range.min,
                           m_options.format, GL_UNSIGNED_BYTE,
                           data + offset);
+        rs.counters.uploadBytes += m_width * (range.max - range.min) * bpp;
     }
     m_dirtyRanges.clear();
 }
@@ -285,7 +337,13 @@ bool Texture::isRepeatWrapping(TextureWrapping _wrapping) {
     return _wrapping.wraps == GL_REPEAT || _wrapping.wrapt == GL_REPEAT;
 }
 
-size_t Texture::bytesPerPixel() {
+size_t Texture::bufferSize() const {
+    size_t size = m_width * m_height * bytesPerPixel();
+    // Mipmaps add a third
+    return m_generateMipmaps ? size + size / 3 : size;
+}
+
+size_t Texture::bytesPerPixel() const {
     switch (m_options.internalFormat) {
         case GL_ALPHA:
         case GL_LUMINANCE:
@@ -78,6 +78,9 @@ public:
     void setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
                     uint16_t _width, uint16_t _height, uint16_t _stride);
 
+    /* Size of the texture on the GPU in bytes */
+    size_t bufferSize() const;
+
     /* Checks whether the texture has valid data and has been successfully uploaded to GPU */
     bool isValid() const;
 
@@ -88,6 +91,7 @@ public:
     static bool isRepeatWrapping(TextureWrapping _wrapping);
 
     bool loadImageFromMemory(const std::vector<char>& _data);
+    bool loadImageFromMemory(const char* _data, size_t _size);
 
     static void flipImageData(unsigned char *result, int w, int h, int depth);
     static void flipImageData(GLuint *result, int w, int h);
@@ -117,7 +121,7 @@ protected:
 
 private:
 
-    size_t bytesPerPixel();
+    size_t bytesPerPixel() const;
 
     bool m_generateMipmaps;
 };
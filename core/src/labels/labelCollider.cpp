@@ -1,5 +1,6 @@
 #include "labels/labelCollider.h"
 
+#include "debug/trace.h"
 #include "labels/curvedLabel.h"
 #include "labels/labelSet.h"
 #include "labels/obbBuffer.h"
@@ -53,6 +54,8 @@ void LabelCollider::handleRepeatGroup(size_t startPos) {
 
 void LabelCollider::process(TileID _tileID, float _tileInverseScale, float _tileSize) {
 
+    TraceSpan span("LabelCollider::process", _tileID);
+
     // Sort labels so that all labels of one repeat group are next to each other
     std::sort(m_labels.begin(), m_labels.end(),
               [](auto& e1, auto& e2) {
@@ -1,5 +1,6 @@
 #include "labels/labels.h"
 
+#include "debug/trace.h"
 #include "gl/primitives.h"
 #include "gl/shaderProgram.h"
 #include "labels/curvedLabel.h"
@@ -14,12 +15,14 @@
 #include "tangram.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
+#include "util/geom.h"
 #include "view/view.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/rotate_vector.hpp"
 #include "glm/gtx/norm.hpp"
+#include <limits>
 
 namespace Tangram {
 
@@ -98,6 +101,56 @@ std::pair<Label*, Tile*> Labels::getLabel(uint32_t _selectionColor) const {
     return {nullptr, nullptr};
 }
 
+// Distance from @_position to the quad of @_obb, 0 when inside
+static float obbDistance(const isect2d::OBB<glm::vec2>& _obb, glm::vec2 _position) {
+    const auto& quad = _obb.getQuad();
+
+    bool inside = true;
+    float sign = 0;
+    float minDistance = std::numeric_limits<float>::max();
+
+    for (int i = 0, j = 3; i < 4; j = i++) {
+        float side = crossProduct(quad[i] - quad[j], _position - quad[j]);
+        if (sign == 0) { sign = side; }
+        if (side * sign < 0) { inside = false; }
+
+        minDistance = std::min(minDistance, pointSegmentDistance(_position, quad[j], quad[i]));
+    }
+
+    return inside ? 0 : minDistance;
+}
+
+std::pair<Label*, Tile*> Labels::getLabelAt(glm::vec2 _position, float _radius) {
+
+    LabelEntry* hit = nullptr;
+    float hitDistance = _radius;
+
+    for (auto& entry : m_selectionLabels) {
+
+        if (!entry.label->visibleState()) { continue; }
+
+        Range obbsRange;
+        m_pickObbs.clear();
+
+        ScreenTransform transform { m_transforms, entry.transformRange };
+        OBBBuffer obbs { m_pickObbs, obbsRange };
+
+        entry.label->obbs(transform, obbs);
+
+        for (auto& obb : obbs) {
+            float distance = obbDistance(obb, _position);
+            if (distance <= hitDistance) {
+                hit = &entry;
+                hitDistance = distance;
+            }
+        }
+    }
+
+    if (!hit) { return {nullptr, nullptr}; }
+
+    return { hit->label, hit->tile };
+}
+
 void Labels::updateLabels(const ViewState& _viewState, float _dt,
                           const std::vector<std::unique_ptr<Style>>& _styles,
                           const std::vector<std::shared_ptr<Tile>>& _tiles,
@@ -134,17 +187,18 @@ void Labels::updateLabels(const ViewState& _viewState, float _dt,
         }
     }
 
+    // The labels of all point markers of a style are drawn with the style's
+    // quad mesh. Each marker mesh is processed once; hidden markers add no
+    // vertices and cannot be selected. Style IDs are the indices of _styles.
     for (const auto& marker : _markers) {
-        for (const auto& style : _styles) {
 
-            if (marker->styleId() != style->getID()) { continue; }
+        if (!marker->isVisible() || !marker->mesh()) { continue; }
 
-            const auto& mesh = marker->mesh();
+        if (marker->styleId() >= _styles.size()) { continue; }
 
-            processLabelUpdate(_viewState, mesh, nullptr,
-                               marker->modelViewProjectionMatrix(),
-                               _dt, drawAllLabels, _onlyTransitions, false);
-        }
+        processLabelUpdate(_viewState, marker->mesh(), nullptr,
+                           marker->modelViewProjectionMatrix(),
+                           _dt, drawAllLabels, _onlyTransitions, false);
     }
 }
 
@@ -413,6 +467,8 @@ void Labels::updateLabelSet(const ViewState& _viewState, float _dt,
                             const std::vector<std::unique_ptr<Marker>>& _markers,
                             TileCache& _cache) {
 
+    TraceSpan span("Labels::updateLabelSet");
+
     m_transforms.clear();
     m_obbs.clear();
 
@@ -51,6 +51,10 @@ public:
 
     std::pair<Label*, Tile*> getLabel(uint32_t _selectionColor) const;
 
+    // Find the interactive label nearest to the screen position @_position within @_radius,
+    // using the label bounds of the last update instead of the selection buffer
+    std::pair<Label*, Tile*> getLabelAt(glm::vec2 _position, float _radius);
+
 protected:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -99,6 +103,8 @@ protected:
     static bool labelComparator(const LabelEntry& _a, const LabelEntry& _b);
 
     std::vector<OBB> m_obbs;
+    // Bounds of a label, reused by getLabelAt()
+    std::vector<OBB> m_pickObbs;
     ScreenTransform::Buffer m_transforms;
 
     std::vector<LabelEntry> m_labels;
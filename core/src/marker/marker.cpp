@@ -36,7 +36,7 @@ bool Marker::evaluateRuleForContext(StyleContext& ctx) {
     return m_ruleSet->evaluateRuleForContext(*m_drawRule, ctx);
 }
 
-void Marker::setDrawRule(std::unique_ptr<DrawRuleData> drawRuleData) {
+void Marker::setDrawRule(std::shared_ptr<const DrawRuleData> drawRuleData) {
     m_drawRuleData = std::move(drawRuleData);
     m_drawRule = std::make_unique<DrawRule>(*m_drawRuleData, "", 0);
 }
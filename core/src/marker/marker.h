@@ -43,8 +43,9 @@ public:
     // Set the string of YAML that will be used to style the marker.
     void setStylingString(std::string stylingString);
 
-    // Set the draw rule that will be used to build the marker.
-    void setDrawRule(std::unique_ptr<DrawRuleData> drawRuleData);
+    // Set the draw rule that will be used to build the marker; the rule data may be shared
+    // with other markers that use the same styling string.
+    void setDrawRule(std::shared_ptr<const DrawRuleData> drawRuleData);
 
     // Set the styled mesh for this marker with the associated style id and zoom level.
     void setMesh(uint32_t styleId, uint32_t zoom, std::unique_ptr<StyledMesh> mesh);
@@ -116,7 +117,7 @@ protected:
 
     std::unique_ptr<Feature> m_feature;
     std::unique_ptr<StyledMesh> m_mesh;
-    std::unique_ptr<DrawRuleData> m_drawRuleData;
+    std::shared_ptr<const DrawRuleData> m_drawRuleData;
     std::unique_ptr<DrawRule> m_drawRule;
     std::unique_ptr<DrawRuleMergeSet> m_ruleSet;
     std::unique_ptr<Texture> m_texture;
@@ -11,6 +11,9 @@
 
 namespace Tangram {
 
+// Number of cached styling strings above which unused entries are dropped
+const size_t maxCachedStylings = 256;
+
 void MarkerManager::setScene(std::shared_ptr<Scene> scene) {
 
     m_scene = scene;
@@ -18,6 +21,8 @@ void MarkerManager::setScene(std::shared_ptr<Scene> scene) {
     m_styleContext.initFunctions(*scene);
     m_jsFnIndex = scene->functions().size();
 
+    // Draw rules parsed for the previous scene must not be reused.
+    m_stylingCache.clear();
 
     // Initialize StyleBuilders.
     for (auto& style : scene->styles()) {
@@ -32,6 +37,7 @@ MarkerID MarkerManager::add() {
     // Add a new empty marker object to the list of markers.
     auto id = ++m_idCounter;
     m_markers.push_back(std::make_unique<Marker>(id));
+    m_markersById[id] = m_markers.back().get();
 
     // Sort the marker list by draw order.
     std::stable_sort(m_markers.begin(), m_markers.end(), Marker::compareByDrawOrder);
@@ -41,7 +47,51 @@ MarkerID MarkerManager::add() {
 
 }
 
+std::vector<MarkerID> MarkerManager::addPoints(const char* styling, const LngLat* coordinates, int count) {
+
+    std::vector<MarkerID> ids;
+
+    if (!m_scene || !styling || !coordinates || count < 1) { return ids; }
+
+    std::string stylingString(styling);
+
+    // Parse the styling once for all markers.
+    auto drawRuleData = getDrawRuleData(stylingString);
+    if (!drawRuleData) { return ids; }
+
+    ids.reserve(count);
+    m_markers.reserve(m_markers.size() + count);
+    m_markersById.reserve(m_markersById.size() + count);
+
+    for (int i = 0; i < count; ++i) {
+        auto id = ++m_idCounter;
+        auto marker = std::make_unique<Marker>(id);
+        marker->setStylingString(stylingString);
+        marker->setDrawRule(drawRuleData);
+
+        auto feature = std::make_unique<Feature>();
+        feature->geometryType = GeometryType::points;
+        feature->points.emplace_back();
+        marker->setFeature(std::move(feature));
+        buildGeometry(*marker, m_zoom);
+
+        auto origin = m_mapProjection->LonLatToMeters({ coordinates[i].longitude, coordinates[i].latitude });
+        marker->setBounds({ origin, origin });
+
+        m_markersById[id] = marker.get();
+        m_markers.push_back(std::move(marker));
+        ids.push_back(id);
+    }
+
+    // Sort the marker list by draw order.
+    std::stable_sort(m_markers.begin(), m_markers.end(), Marker::compareByDrawOrder);
+
+    return ids;
+}
+
 bool MarkerManager::remove(MarkerID markerID) {
+    if (m_markersById.erase(markerID) == 0) { return false; }
+
     for (auto it = m_markers.begin(), end = m_markers.end(); it != end; ++it) {
         if (it->get()->id() == markerID) {
             m_markers.erase(it);
@@ -257,29 +307,53 @@ bool MarkerManager::setPolygon(MarkerID markerID, LngLat* coordinates, int* coun
 
 bool MarkerManager::update(int zoom) {
 
-    if (zoom == m_zoom) {
-         return false;
+    if (zoom != m_zoom) {
+        m_zoom = zoom;
+        m_buildQueue.clear();
+
+        // Queue in reverse order such that markers are rebuilt in draw order.
+        for (auto it = m_markers.rbegin(); it != m_markers.rend(); ++it) {
+            if (zoom != (*it)->builtZoomLevel()) {
+                m_buildQueue.push_back((*it)->id());
+            }
+        }
     }
+
+    if (m_buildQueue.empty()) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
     bool rebuilt = false;
-    for (auto& marker : m_markers) {
-        if (zoom != marker->builtZoomLevel()) {
-            buildGeometry(*marker, zoom);
-            setVisible(marker->id(), marker->isVisible());
-            rebuilt = true;
-        }
+
+    while (!m_buildQueue.empty()) {
+        // Markers may have been removed or rebuilt since they were queued.
+        Marker* marker = getMarkerOrNull(m_buildQueue.back());
+        m_buildQueue.pop_back();
+
+        if (!marker || marker->builtZoomLevel() == m_zoom) { continue; }
+
+        buildGeometry(*marker, m_zoom);
+        setVisible(marker->id(), marker->isVisible());
+        rebuilt = true;
+
+        if (std::chrono::steady_clock::now() - start > m_buildTimeBudget) { break; }
     }
-    m_zoom = zoom;
     return rebuilt;
 }
 
 void MarkerManager::removeAll() {
 
     m_markers.clear();
+    m_markersById.clear();
+    m_buildQueue.clear();
 
 }
 
 void MarkerManager::rebuildAll() {
 
+    m_buildQueue.clear();
+
     for (auto& entry : m_markers) {
         buildStyling(*entry);
         buildGeometry(*entry, m_zoom);
@@ -296,15 +370,27 @@ bool MarkerManager::buildStyling(Marker& marker) {
 
     if (!m_scene) { return false; }
 
+    auto drawRuleData = getDrawRuleData(marker.stylingString());
+    if (!drawRuleData) { return false; }
+
+    marker.setDrawRule(drawRuleData);
+
+    return true;
+}
+
+std::shared_ptr<const DrawRuleData> MarkerManager::getDrawRuleData(const std::string& styling) {
+
+    auto it = m_stylingCache.find(styling);
+    if (it != m_stylingCache.end()) { return it->second; }
+
     std::vector<StyleParam> params;
     try {
-        // Update the draw rule for the marker.
-        YAML::Node node = YAML::Load(marker.stylingString());
+        // Parse the draw rule for the styling string.
+        YAML::Node node = YAML::Load(styling);
         SceneLoader::parseStyleParams(node, m_scene, "", params);
     } catch (YAML::Exception e) {
-        LOG("Invalid marker styling '%s', %s",
-            marker.stylingString().c_str(), e.what());
-        return false;
+        LOG("Invalid marker styling '%s', %s", styling.c_str(), e.what());
+        return nullptr;
     }
     // Compile any new JS functions used for styling.
     const auto& sceneJsFnList = m_scene->functions();
@@ -313,9 +399,21 @@ bool MarkerManager::buildStyling(Marker& marker) {
     }
     m_jsFnIndex = sceneJsFnList.size();
 
-    marker.setDrawRule(std::make_unique<DrawRuleData>("", 0, std::move(params)));
+    // Drop the draw rules that are no longer used by any marker.
+    if (m_stylingCache.size() >= maxCachedStylings) {
+        for (auto entry = m_stylingCache.begin(); entry != m_stylingCache.end(); ) {
+            if (entry->second.use_count() == 1) {
+                entry = m_stylingCache.erase(entry);
+            } else {
+                ++entry;
+            }
+        }
+    }
 
-    return true;
+    auto drawRuleData = std::make_shared<const DrawRuleData>("", 0, std::move(params));
+    m_stylingCache.emplace(styling, drawRuleData);
+
+    return drawRuleData;
 }
 
 bool MarkerManager::buildGeometry(Marker& marker, int zoom) {
@@ -374,11 +472,9 @@ const Marker* MarkerManager::getMarkerOrNullBySelectionColor(uint32_t selectionC
 }
 
 Marker* MarkerManager::getMarkerOrNull(MarkerID markerID) {
-    if (!markerID) { return nullptr; }
-    for (const auto& entry : m_markers) {
-        if (entry->id() == markerID) { return entry.get(); }
-    }
-    return nullptr;
+    auto it = m_markersById.find(markerID);
+    if (it == m_markersById.end()) { return nullptr; }
+    return it->second;
 }
 
 } // namespace Tangram
@@ -6,7 +6,10 @@
 #include "util/fastmap.h"
 #include "util/types.h"
 
+#include <chrono>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Tangram {
@@ -26,6 +29,11 @@ public:
     // Create a new, empty marker and return its ID. An ID of 0 indicates an invalid marker.
     MarkerID add();
 
+    // Create a point marker with the styling string for each of the count coordinates and return their IDs in the
+    // same order; the styling is parsed once and shared by all of the new markers. Returns no IDs if the styling
+    // is invalid.
+    std::vector<MarkerID> addPoints(const char* styling, const LngLat* coordinates, int count);
+
     // Try to remove the marker with the given ID; returns true if the marker was found and removed.
     bool remove(MarkerID markerID);
 
@@ -55,9 +63,18 @@ public:
     bool setPolygon(MarkerID markerID, LngLat* coordinates, int* counts, int rings);
 
     // Update the zoom level for all markers; markers are built for one zoom level at a time so when the current zoom
-    // changes, all marker meshes are rebuilt.
+    // changes, all marker meshes are rebuilt. The rebuilds are spread over several updates with a time budget for
+    // each; until a marker is rebuilt it is drawn with its mesh for the previous zoom. Returns true if any marker
+    // was rebuilt.
     bool update(int zoom);
 
+    // Whether markers remain to be rebuilt for the current zoom level.
+    bool hasPendingBuilds() const { return !m_buildQueue.empty(); }
+
+    // Set the time budget for rebuilding markers in one update (4ms by default); at least one marker is rebuilt in
+    // each update.
+    void setBuildTimeBudget(std::chrono::steady_clock::duration budget) { m_buildTimeBudget = budget; }
+
     // Remove and destroy all markers.
     void removeAll();
 
@@ -73,11 +90,21 @@ private:
     Marker* getMarkerOrNull(MarkerID markerID);
 
     bool buildStyling(Marker& marker);
+
+    // Get the draw rule data for a styling string, parsing it only when it is not cached.
+    std::shared_ptr<const DrawRuleData> getDrawRuleData(const std::string& styling);
     bool buildGeometry(Marker& marker, int zoom);
 
     StyleContext m_styleContext;
     std::shared_ptr<Scene> m_scene;
     std::vector<std::unique_ptr<Marker>> m_markers;
+    // Markers by ID, for constant time lookups.
+    std::unordered_map<MarkerID, Marker*> m_markersById;
+    // Markers to rebuild for the current zoom, the next one last.
+    std::vector<MarkerID> m_buildQueue;
+    std::chrono::steady_clock::duration m_buildTimeBudget = std::chrono::milliseconds(4);
+    // Parsed draw rules by styling string, shared by the markers with the same styling.
+    std::unordered_map<std::string, std::shared_ptr<const DrawRuleData>> m_stylingCache;
     std::vector<std::string> m_jsFnList;
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilders;
     MapProjection* m_mapProjection = nullptr;
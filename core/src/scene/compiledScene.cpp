@@ -0,0 +1,621 @@
+#include "scene/compiledScene.h"
+
+#include "log.h"
+#include "scene/dataLayer.h"
+#include "scene/filters.h"
+#include "scene/scene.h"
+#include "scene/stops.h"
+#include "scene/styleParam.h"
+
+#include <cstring>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace Tangram {
+
+// 'TGSC' in little-endian byte order
+constexpr uint32_t MAGIC = 0x43534754;
+
+enum class FilterType : uint8_t {
+    none,
+    all,
+    none_of,
+    any,
+    equality_set,
+    equality,
+    range,
+    existence,
+    function,
+};
+
+enum class ValueType : uint8_t {
+    none,
+    number,
+    string,
+};
+
+enum class ParamType : uint8_t {
+    undefined,
+    none,
+    boolean,
+    number,
+    uint,
+    string,
+    vec2,
+    width,
+    placement,
+    anchors,
+};
+
+enum class StopType : uint8_t {
+    none,
+    number,
+    color,
+    vec2,
+};
+
+struct Writer {
+    std::vector<char>& out;
+
+    template<typename T>
+    void put(T _value) {
+        const char* bytes = reinterpret_cast<const char*>(&_value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(const std::string& _str) {
+        put<uint32_t>(_str.size());
+        out.insert(out.end(), _str.begin(), _str.end());
+    }
+};
+
+struct Reader {
+    const char* pos;
+    const char* end;
+    bool ok = true;
+
+    template<typename T>
+    T get() {
+        T value{};
+        if (size_t(end - pos) < sizeof(T)) {
+            ok = false;
+            pos = end;
+            return value;
+        }
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        auto size = get<uint32_t>();
+        if (!ok || size_t(end - pos) < size) {
+            ok = false;
+            pos = end;
+            return {};
+        }
+        std::string str(pos, size);
+        pos += size;
+        return str;
+    }
+
+    // Element counts are bounded by the remaining data, so that a corrupted
+    // count cannot trigger huge allocations or endless loops.
+    uint32_t getCount() {
+        auto count = get<uint32_t>();
+        if (count > size_t(end - pos)) {
+            ok = false;
+            pos = end;
+            return 0;
+        }
+        return count;
+    }
+};
+
+using StopsIndex = std::unordered_map<const Stops*, int32_t>;
+
+// 64-bit FNV-1a, stable across platforms and runs
+static void fnv(uint64_t& _hash, const void* _data, size_t _size) {
+    auto bytes = static_cast<const uint8_t*>(_data);
+    for (size_t i = 0; i < _size; i++) {
+        _hash = (_hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+}
+
+static void fnv(uint64_t& _hash, const std::string& _str) {
+    fnv(_hash, _str.data(), _str.size() + 1);
+}
+
+template<typename T>
+static void fnv(uint64_t& _hash, T _value) {
+    fnv(_hash, &_value, sizeof(T));
+}
+
+uint64_t CompiledScene::layoutHash() {
+    static const uint64_t hash = [] {
+        uint64_t h = 0xcbf29ce484222325ULL;
+
+        // StyleParamKeys and Units are written by their values
+        fnv(h, uint32_t(StyleParamKeySize));
+        for (size_t i = 0; i < StyleParamKeySize; i++) {
+            fnv(h, StyleParam::keyName(static_cast<StyleParamKey>(i)));
+        }
+        for (auto unit : { Unit::pixel, Unit::milliseconds, Unit::meter, Unit::seconds }) {
+            fnv(h, uint32_t(unit));
+            fnv(h, unitString(unit));
+        }
+        fnv(h, uint32_t(LabelProperty::centroid));
+        fnv(h, uint32_t(LabelProperty::bottom_right));
+        fnv(h, uint32_t(LabelProperty::max_anchors));
+
+        // Values are written with host sizes and byte order
+        fnv(h, uint32_t(sizeof(float)));
+        fnv(h, uint32_t(sizeof(double)));
+        fnv(h, uint32_t(sizeof(Color)));
+        fnv(h, uint16_t(1));
+        return h;
+    }();
+    return hash;
+}
+
+/*
+ * Writing
+ */
+
+static void writeValue(Writer& _w, const Value& _value) {
+    if (_value.is<double>()) {
+        _w.put(ValueType::number);
+        _w.put(_value.get<double>());
+    } else if (_value.is<std::string>()) {
+        _w.put(ValueType::string);
+        _w.putString(_value.get<std::string>());
+    } else {
+        _w.put(ValueType::none);
+    }
+}
+
+static void writeFilter(Writer& _w, const Filter& _filter);
+
+static void writeOperands(Writer& _w, FilterType _type, const std::vector<Filter>& _operands) {
+    _w.put(_type);
+    _w.put<uint32_t>(_operands.size());
+    for (const auto& operand : _operands) {
+        writeFilter(_w, operand);
+    }
+}
+
+static void writeFilter(Writer& _w, const Filter& _filter) {
+    const auto& data = _filter.data;
+
+    if (data.is<Filter::OperatorAll>()) {
+        writeOperands(_w, FilterType::all, data.get<Filter::OperatorAll>().operands);
+
+    } else if (data.is<Filter::OperatorNone>()) {
+        writeOperands(_w, FilterType::none_of, data.get<Filter::OperatorNone>().operands);
+
+    } else if (data.is<Filter::OperatorAny>()) {
+        writeOperands(_w, FilterType::any, data.get<Filter::OperatorAny>().operands);
+
+    } else if (data.is<Filter::EqualitySet>()) {
+        auto& f = data.get<Filter::EqualitySet>();
+        _w.put(FilterType::equality_set);
+        _w.putString(f.key);
+        _w.put<uint32_t>(f.values.size());
+        for (const auto& value : f.values) { writeValue(_w, value); }
+
+    } else if (data.is<Filter::Equality>()) {
+        auto& f = data.get<Filter::Equality>();
+        _w.put(FilterType::equality);
+        _w.putString(f.key);
+        writeValue(_w, f.value);
+
+    } else if (data.is<Filter::Range>()) {
+        auto& f = data.get<Filter::Range>();
+        _w.put(FilterType::range);
+        _w.putString(f.key);
+        _w.put(f.min);
+        _w.put(f.max);
+        _w.put<uint8_t>(f.hasPixelArea);
+
+    } else if (data.is<Filter::Existence>()) {
+        auto& f = data.get<Filter::Existence>();
+        _w.put(FilterType::existence);
+        _w.putString(f.key);
+        _w.put<uint8_t>(f.exists);
+
+    } else if (data.is<Filter::Function>()) {
+        _w.put(FilterType::function);
+        _w.put(data.get<Filter::Function>().id);
+
+    } else {
+        _w.put(FilterType::none);
+    }
+}
+
+static void writeParamValue(Writer& _w, const StyleParam::Value& _value) {
+    if (_value.is<Undefined>()) {
+        _w.put(ParamType::undefined);
+    } else if (_value.is<bool>()) {
+        _w.put(ParamType::boolean);
+        _w.put<uint8_t>(_value.get<bool>());
+    } else if (_value.is<float>()) {
+        _w.put(ParamType::number);
+        _w.put(_value.get<float>());
+    } else if (_value.is<uint32_t>()) {
+        _w.put(ParamType::uint);
+        _w.put(_value.get<uint32_t>());
+    } else if (_value.is<std::string>()) {
+        _w.put(ParamType::string);
+        _w.putString(_value.get<std::string>());
+    } else if (_value.is<glm::vec2>()) {
+        auto& v = _value.get<glm::vec2>();
+        _w.put(ParamType::vec2);
+        _w.put(v.x);
+        _w.put(v.y);
+    } else if (_value.is<StyleParam::Width>()) {
+        auto& width = _value.get<StyleParam::Width>();
+        _w.put(ParamType::width);
+        _w.put(width.value);
+        _w.put<uint8_t>(static_cast<uint8_t>(width.unit));
+    } else if (_value.is<LabelProperty::Placement>()) {
+        _w.put(ParamType::placement);
+        _w.put<uint8_t>(_value.get<LabelProperty::Placement>());
+    } else if (_value.is<LabelProperty::Anchors>()) {
+        auto& anchors = _value.get<LabelProperty::Anchors>();
+        _w.put(ParamType::anchors);
+        _w.put<uint8_t>(anchors.count);
+        for (int i = 0; i < anchors.count; i++) {
+            _w.put<uint8_t>(anchors.anchor[i]);
+        }
+    } else {
+        _w.put(ParamType::none);
+    }
+}
+
+static void writeLayer(Writer& _w, const SceneLayer& _layer, const StopsIndex& _stops) {
+    _w.putString(_layer.name());
+    _w.put<uint8_t>(_layer.visible());
+
+    writeFilter(_w, _layer.filter());
+
+    _w.put<uint32_t>(_layer.rules().size());
+    for (const auto& rule : _layer.rules()) {
+        _w.putString(rule.name);
+        _w.put<int32_t>(rule.id);
+
+        _w.put<uint32_t>(rule.parameters.size());
+        for (const auto& param : rule.parameters) {
+            _w.put(param.key);
+            _w.put(param.function);
+
+            int32_t stops = -1;
+            if (param.stops) {
+                auto it = _stops.find(param.stops);
+                if (it != _stops.end()) { stops = it->second; }
+            }
+            _w.put(stops);
+
+            writeParamValue(_w, param.value);
+        }
+    }
+
+    _w.put<uint32_t>(_layer.sublayers().size());
+    for (const auto& sublayer : _layer.sublayers()) {
+        writeLayer(_w, sublayer, _stops);
+    }
+}
+
+bool CompiledScene::write(const Scene& _scene, std::vector<char>& _out) {
+
+    if (_scene.sourceHash().empty()) {
+        LOGE("Cannot compile scene without source hash");
+        return false;
+    }
+
+    Writer w{_out};
+
+    w.put(MAGIC);
+    w.put(version);
+    w.put(layoutHash());
+    w.putString(_scene.sourceHash());
+
+    w.put<uint32_t>(_scene.names().size());
+    for (const auto& name : _scene.names()) { w.putString(name); }
+
+    w.put<uint32_t>(_scene.functions().size());
+    for (const auto& function : _scene.functions()) { w.putString(function); }
+
+    StopsIndex stopsIndex;
+    w.put<uint32_t>(_scene.stops().size());
+    for (const auto& stops : _scene.stops()) {
+        stopsIndex.emplace(&stops, stopsIndex.size());
+
+        w.put<uint32_t>(stops.frames.size());
+        for (const auto& frame : stops.frames) {
+            w.put(frame.key);
+            if (frame.value.is<float>()) {
+                w.put(StopType::number);
+                w.put(frame.value.get<float>());
+            } else if (frame.value.is<Color>()) {
+                w.put(StopType::color);
+                w.put(frame.value.get<Color>().abgr);
+            } else if (frame.value.is<glm::vec2>()) {
+                auto& v = frame.value.get<glm::vec2>();
+                w.put(StopType::vec2);
+                w.put(v.x);
+                w.put(v.y);
+            } else {
+                w.put(StopType::none);
+            }
+        }
+    }
+
+    w.put<uint32_t>(_scene.layers().size());
+    for (const auto& layer : _scene.layers()) {
+        w.putString(layer.source());
+        w.put<uint32_t>(layer.collections().size());
+        for (const auto& collection : layer.collections()) { w.putString(collection); }
+
+        writeLayer(w, layer, stopsIndex);
+    }
+
+    return true;
+}
+
+/*
+ * Reading
+ */
+
+static Value readValue(Reader& _r) {
+    switch (_r.get<ValueType>()) {
+    case ValueType::number:
+        return Value(_r.get<double>());
+    case ValueType::string:
+        return Value(_r.getString());
+    case ValueType::none:
+        return Value(none_type{});
+    default:
+        _r.ok = false;
+        return Value(none_type{});
+    }
+}
+
+static Filter readFilter(Reader& _r);
+
+static std::vector<Filter> readOperands(Reader& _r) {
+    std::vector<Filter> operands;
+    uint32_t count = _r.getCount();
+    for (uint32_t i = 0; i < count && _r.ok; i++) {
+        operands.push_back(readFilter(_r));
+    }
+    return operands;
+}
+
+static Filter readFilter(Reader& _r) {
+    switch (_r.get<FilterType>()) {
+    case FilterType::none:
+        return Filter();
+    case FilterType::all:
+        return { Filter::OperatorAll{ readOperands(_r) }};
+    case FilterType::none_of:
+        return { Filter::OperatorNone{ readOperands(_r) }};
+    case FilterType::any:
+        return { Filter::OperatorAny{ readOperands(_r) }};
+    case FilterType::equality_set: {
+        auto key = _r.getString();
+        std::vector<Value> values;
+        uint32_t count = _r.getCount();
+        for (uint32_t i = 0; i < count && _r.ok; i++) {
+            values.push_back(readValue(_r));
+        }
+        auto keyword = Filter::keywordType(key);
+        return { Filter::EqualitySet{ std::move(key), std::move(values), keyword }};
+    }
+    case FilterType::equality: {
+        auto key = _r.getString();
+        auto value = readValue(_r);
+        auto keyword = Filter::keywordType(key);
+        return { Filter::Equality{ std::move(key), std::move(value), keyword }};
+    }
+    case FilterType::range: {
+        auto key = _r.getString();
+        float min = _r.get<float>();
+        float max = _r.get<float>();
+        bool hasPixelArea = _r.get<uint8_t>();
+        auto keyword = Filter::keywordType(key);
+        return { Filter::Range{ std::move(key), min, max, keyword, hasPixelArea }};
+    }
+    case FilterType::existence: {
+        auto key = _r.getString();
+        bool exists = _r.get<uint8_t>();
+        return { Filter::Existence{ std::move(key), exists }};
+    }
+    case FilterType::function:
+        return { Filter::Function{ _r.get<uint32_t>() }};
+    default:
+        _r.ok = false;
+        return Filter();
+    }
+}
+
+static StyleParam::Value readParamValue(Reader& _r) {
+    switch (_r.get<ParamType>()) {
+    case ParamType::undefined:
+        return Undefined();
+    case ParamType::none:
+        return none_type{};
+    case ParamType::boolean:
+        return bool(_r.get<uint8_t>());
+    case ParamType::number:
+        return _r.get<float>();
+    case ParamType::uint:
+        return _r.get<uint32_t>();
+    case ParamType::string:
+        return _r.getString();
+    case ParamType::vec2: {
+        float x = _r.get<float>();
+        float y = _r.get<float>();
+        return glm::vec2(x, y);
+    }
+    case ParamType::width: {
+        float value = _r.get<float>();
+        auto unit = static_cast<Unit>(_r.get<uint8_t>());
+        return StyleParam::Width{ value, unit };
+    }
+    case ParamType::placement:
+        return static_cast<LabelProperty::Placement>(_r.get<uint8_t>());
+    case ParamType::anchors: {
+        LabelProperty::Anchors anchors;
+        anchors.count = _r.get<uint8_t>();
+        if (anchors.count > LabelProperty::max_anchors) {
+            _r.ok = false;
+            return none_type{};
+        }
+        for (int i = 0; i < anchors.count; i++) {
+            anchors.anchor[i] = static_cast<LabelProperty::Anchor>(_r.get<uint8_t>());
+        }
+        return anchors;
+    }
+    default:
+        _r.ok = false;
+        return none_type{};
+    }
+}
+
+static SceneLayer readLayer(Reader& _r, const std::vector<Stops*>& _stops) {
+    auto name = _r.getString();
+    bool visible = _r.get<uint8_t>();
+
+    Filter filter = readFilter(_r);
+
+    std::vector<DrawRuleData> rules;
+    uint32_t ruleCount = _r.getCount();
+    for (uint32_t i = 0; i < ruleCount && _r.ok; i++) {
+        auto ruleName = _r.getString();
+        int32_t ruleId = _r.get<int32_t>();
+
+        std::vector<StyleParam> params;
+        uint32_t paramCount = _r.getCount();
+        for (uint32_t j = 0; j < paramCount && _r.ok; j++) {
+            StyleParam param;
+            param.key = _r.get<StyleParamKey>();
+            param.function = _r.get<int32_t>();
+
+            int32_t stops = _r.get<int32_t>();
+            if (stops >= 0) {
+                if (size_t(stops) < _stops.size()) {
+                    param.stops = _stops[stops];
+                } else {
+                    _r.ok = false;
+                }
+            }
+            param.value = readParamValue(_r);
+
+            params.push_back(std::move(param));
+        }
+        rules.emplace_back(std::move(ruleName), ruleId, std::move(params));
+    }
+
+    std::vector<SceneLayer> sublayers;
+    uint32_t sublayerCount = _r.getCount();
+    for (uint32_t i = 0; i < sublayerCount && _r.ok; i++) {
+        sublayers.push_back(readLayer(_r, _stops));
+    }
+
+    return { std::move(name), std::move(filter), std::move(rules), std::move(sublayers), visible };
+}
+
+bool CompiledScene::read(const std::vector<char>& _data, Scene& _scene) {
+
+    if (!_scene.layers().empty() || !_scene.names().empty() || !_scene.functions().empty()) {
+        LOGE("Compiled scene can only be loaded into a scene without layers");
+        return false;
+    }
+
+    Reader r{_data.data(), _data.data() + _data.size()};
+
+    if (r.get<uint32_t>() != MAGIC || r.get<uint32_t>() != version) { return false; }
+
+    if (r.get<uint64_t>() != layoutHash()) { return false; }
+
+    if (r.getString() != _scene.sourceHash() || !r.ok) { return false; }
+
+    std::vector<std::string> names;
+    uint32_t nameCount = r.getCount();
+    for (uint32_t i = 0; i < nameCount && r.ok; i++) {
+        names.push_back(r.getString());
+    }
+
+    std::vector<std::string> functions;
+    uint32_t functionCount = r.getCount();
+    for (uint32_t i = 0; i < functionCount && r.ok; i++) {
+        functions.push_back(r.getString());
+    }
+
+    // Use a list for stable Stops pointers; entries are spliced into the
+    // scene's list once everything was read successfully.
+    std::list<Stops> stopsList;
+    std::vector<Stops*> stopsIndex;
+    uint32_t stopsCount = r.getCount();
+    for (uint32_t i = 0; i < stopsCount && r.ok; i++) {
+        stopsList.emplace_back();
+        auto& stops = stopsList.back();
+        stopsIndex.push_back(&stops);
+
+        uint32_t frameCount = r.getCount();
+        for (uint32_t j = 0; j < frameCount && r.ok; j++) {
+            float key = r.get<float>();
+            switch (r.get<StopType>()) {
+            case StopType::number:
+                stops.frames.emplace_back(key, r.get<float>());
+                break;
+            case StopType::color:
+                stops.frames.emplace_back(key, Color(r.get<uint32_t>()));
+                break;
+            case StopType::vec2: {
+                float x = r.get<float>();
+                float y = r.get<float>();
+                stops.frames.emplace_back(key, glm::vec2(x, y));
+                break;
+            }
+            case StopType::none:
+                stops.frames.emplace_back(key, 0.f);
+                stops.frames.back().value = none_type{};
+                break;
+            default:
+                r.ok = false;
+                break;
+            }
+        }
+    }
+
+    std::vector<DataLayer> layers;
+    uint32_t layerCount = r.getCount();
+    for (uint32_t i = 0; i < layerCount && r.ok; i++) {
+        auto source = r.getString();
+
+        std::vector<std::string> collections;
+        uint32_t collectionCount = r.getCount();
+        for (uint32_t j = 0; j < collectionCount && r.ok; j++) {
+            collections.push_back(r.getString());
+        }
+
+        auto layer = readLayer(r, stopsIndex);
+        layers.emplace_back(std::move(layer), source, collections);
+    }
+
+    if (!r.ok || r.pos != r.end) {
+        LOGW("Invalid compiled scene data");
+        return false;
+    }
+
+    _scene.names() = std::move(names);
+    _scene.functions() = std::move(functions);
+    _scene.stops().splice(_scene.stops().end(), stopsList);
+    _scene.layers() = std::move(layers);
+
+    return true;
+}
+
+}
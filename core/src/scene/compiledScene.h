@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Tangram {
+
+class Scene;
+
+/*
+ * CompiledScene is a binary snapshot of the parts of a Scene which are most
+ * expensive to build from YAML: the layer tree with its filters and parsed
+ * draw rules, the Stops referenced by those rules, the draw-rule names and
+ * the JS function sources.
+ *
+ * A compiled scene is only valid for the exact scene sources it was built
+ * from: 'read' rejects data whose source hash does not match the hash of the
+ * scene that is being loaded (see Scene::sourceHash).
+ */
+struct CompiledScene {
+
+    // Increment whenever the binary layout changes
+    static constexpr uint32_t version = 2;
+
+    // Fingerprint of the enums and value types which are written as raw
+    // values, like StyleParamKey and Unit. Compiled data is rejected when it
+    // was written by a build in which these differ, so that adding or
+    // reordering keys does not depend on a version bump.
+    static uint64_t layoutHash();
+
+    // Serialize layers, names, stops and functions of a loaded @_scene into @_out
+    static bool write(const Scene& _scene, std::vector<char>& _out);
+
+    // Restore layers, names, stops and functions into @_scene, which must not
+    // have any layers loaded yet. Returns false when @_data is invalid or was
+    // compiled from other scene sources; @_scene is left unchanged in that case.
+    static bool read(const std::vector<char>& _data, Scene& _scene);
+};
+
+}
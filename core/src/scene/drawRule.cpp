@@ -1,5 +1,6 @@
 #include "scene/drawRule.h"
 
+#include "data/tileData.h"
 #include "drawRuleWarnings.h"
 #include "log.h"
 #include "platform.h"
@@ -146,6 +147,11 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
                 continue;
             }
 
+            // Skip subtrees which can not match this geometry type and zoom
+            if (!sublayer.canMatch(_feature.geometryType, _ctx.getKeywordZoom())) {
+                continue;
+            }
+
             if (sublayer.filter().eval(_feature, _ctx)) {
                 m_queuedLayers.push_back(&sublayer);
             }
@@ -188,6 +194,14 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& ctx)
                     }
                 }
             } else if (param->stops) {
+                // Use the value precomputed for the current zoom
+                int32_t index = param->stops->zoomIndex;
+                if (m_zoomParams && index >= 0 && size_t(index) < m_zoomParams->size() &&
+                    (*m_zoomParams)[index].key == param->key) {
+                    param = &(*m_zoomParams)[index];
+                    continue;
+                }
+
                 m_evaluated[i] = *param;
                 param = &m_evaluated[i];
 
@@ -129,6 +129,9 @@ public:
 
     auto& matchedRules() { return m_matchedRules; }
 
+    // Set the table of Scene::zoomParams evaluated for the current zoom, or nullptr
+    void setZoomParams(const std::vector<StyleParam>* _zoomParams) { m_zoomParams = _zoomParams; }
+
 private:
     // Reusable containers 'matchedRules' and 'queuedLayers'
     std::vector<DrawRule> m_matchedRules;
@@ -137,6 +140,8 @@ private:
     // Container for dynamically-evaluated parameters
     StyleParam m_evaluated[StyleParamKeySize];
 
+    const std::vector<StyleParam>* m_zoomParams = nullptr;
+
 };
 
 }
@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "scene/styleContext.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace Tangram {
@@ -168,6 +169,108 @@ const std::vector<Filter>& Filter::operands() const {
     return empty;
 }
 
+static uint8_t geometryBit(const Value& _value) {
+    if (!_value.is<std::string>()) { return 0; }
+
+    auto& type = _value.get<std::string>();
+    if (type == "point") { return 1 << GeometryType::points; }
+    if (type == "line") { return 1 << GeometryType::lines; }
+    if (type == "polygon") { return 1 << GeometryType::polygons; }
+    return 0;
+}
+
+uint8_t Filter::geometryMask() const {
+    static const uint8_t all = 0xff;
+
+    switch (data.which()) {
+    case Data::type<OperatorAll>::value: {
+        uint8_t mask = all;
+        for (const auto& filt : data.get<OperatorAll>().operands) { mask &= filt.geometryMask(); }
+        return mask;
+    }
+    case Data::type<OperatorAny>::value: {
+        uint8_t mask = 0;
+        for (const auto& filt : data.get<OperatorAny>().operands) { mask |= filt.geometryMask(); }
+        return mask;
+    }
+    case Data::type<Equality>::value: {
+        auto& f = data.get<Equality>();
+        if (f.keyword != FilterKeyword::geometry) { return all; }
+        return geometryBit(f.value);
+    }
+    case Data::type<EqualitySet>::value: {
+        auto& f = data.get<EqualitySet>();
+        if (f.keyword != FilterKeyword::geometry) { return all; }
+        uint8_t mask = 0;
+        for (const auto& value : f.values) { mask |= geometryBit(value); }
+        return mask;
+    }
+    default:
+        // 'none' operators are not analyzed
+        return all;
+    }
+}
+
+void Filter::zoomRange(float& _min, float& _max) const {
+    _min = -INFINITY;
+    _max = INFINITY;
+
+    switch (data.which()) {
+    case Data::type<OperatorAll>::value: {
+        for (const auto& filt : data.get<OperatorAll>().operands) {
+            float min, max;
+            filt.zoomRange(min, max);
+            _min = std::max(_min, min);
+            _max = std::min(_max, max);
+        }
+        break;
+    }
+    case Data::type<OperatorAny>::value: {
+        auto& operands = data.get<OperatorAny>().operands;
+        if (operands.empty()) { break; }
+        _min = INFINITY;
+        _max = -INFINITY;
+        for (const auto& filt : operands) {
+            float min, max;
+            filt.zoomRange(min, max);
+            _min = std::min(_min, min);
+            _max = std::max(_max, max);
+        }
+        break;
+    }
+    case Data::type<Range>::value: {
+        auto& f = data.get<Range>();
+        if (f.keyword == FilterKeyword::zoom && !f.hasPixelArea) {
+            _min = f.min;
+            _max = f.max;
+        }
+        break;
+    }
+    case Data::type<Equality>::value: {
+        auto& f = data.get<Equality>();
+        if (f.keyword == FilterKeyword::zoom && f.value.is<double>()) {
+            _min = f.value.get<double>();
+            _max = _min + 1;
+        }
+        break;
+    }
+    case Data::type<EqualitySet>::value: {
+        auto& f = data.get<EqualitySet>();
+        if (f.keyword != FilterKeyword::zoom) { break; }
+        _min = INFINITY;
+        _max = -INFINITY;
+        for (const auto& value : f.values) {
+            if (!value.is<double>()) { continue; }
+            _min = std::min(_min, float(value.get<double>()));
+            _max = std::max(_max, float(value.get<double>() + 1));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 const bool Filter::isOperator() const {
 
     switch (data.which()) {
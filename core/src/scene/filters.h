@@ -67,6 +67,12 @@ struct Filter {
 
     bool eval(const Feature& feat, StyleContext& ctx) const;
 
+    // Bitmask of the GeometryTypes (1 << type) which this filter can match
+    uint8_t geometryMask() const;
+
+    // Range of zoom levels (min <= zoom < max) which this filter can match
+    void zoomRange(float& _min, float& _max) const;
+
     // Create an 'any', 'all', or 'none' filter
     inline static Filter MatchAny(std::vector<Filter> filters) {
         sort(filters);
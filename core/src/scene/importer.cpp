@@ -4,6 +4,8 @@
 #include "platform.h"
 #include "scene/sceneLoader.h"
 
+#include "hash-library/md5.h"
+#include <algorithm>
 #include <regex>
 #include "yaml-cpp/yaml.h"
 
@@ -76,6 +78,33 @@ Node Importer::applySceneImports(const std::shared_ptr<Platform>& platform, cons
     return root;
 }
 
+std::string Importer::sourceHash(const std::vector<SceneUpdate>& updates) const {
+
+    std::vector<std::string> hashes;
+    for (const auto& entry : m_sceneHashes) {
+        hashes.push_back(entry.second);
+    }
+    // Scenes are loaded in arbitrary order
+    std::sort(hashes.begin(), hashes.end());
+
+    MD5 md5;
+    for (const auto& hash : hashes) {
+        md5.add(hash.data(), hash.size());
+    }
+    // Prefix each field with its length, so that fields moving from one
+    // to the other ('a.b', 'c' and 'a.bc', '') give different hashes
+    auto addField = [&](const std::string& field) {
+        uint64_t length = field.size();
+        md5.add(&length, sizeof(length));
+        md5.add(field.data(), field.size());
+    };
+    for (const auto& update : updates) {
+        addField(update.path);
+        addField(update.value);
+    }
+    return md5.getHash();
+}
+
 void Importer::processScene(const Url& scenePath, const std::string &sceneString) {
 
     LOGD("Process: '%s'", scenePath.string().c_str());
@@ -85,6 +114,9 @@ void Importer::processScene(const Url& scenePath, const std::string &sceneString
         return;
     }
 
+    MD5 md5;
+    m_sceneHashes[scenePath] = md5(sceneString);
+
     try {
         auto sceneNode = YAML::Load(sceneString);
 
@@ -206,6 +238,18 @@ void Importer::resolveSceneUrls(Node& root, const Url& base) {
         }
     }
 
+    // Resolve compiled scene URL.
+
+    if (Node scene = root["scene"]) {
+        if (scene.IsMap()) {
+            if (Node compiled = scene["compiled"]) {
+                if (nodeIsPotentialUrl(compiled)) {
+                    compiled = Url(compiled.Scalar()).resolved(base).string();
+                }
+            }
+        }
+    }
+
     // Resolve font URLs.
 
     if (Node fonts = root["fonts"]) {
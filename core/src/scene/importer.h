@@ -16,6 +16,8 @@ class Platform;
 
 namespace Tangram {
 
+struct SceneUpdate;
+
 class Importer {
 
 public:
@@ -25,6 +27,10 @@ public:
     // Loads the main scene with deep merging dependent imported scenes.
     Node applySceneImports(const std::shared_ptr<Platform>& platform, const Url& scenePath, const Url& resourceRoot = Url());
 
+    // Returns a hash over the contents of all loaded scene files and the given updates.
+    // The hash is independent of scene locations so that it matches on other hosts.
+    std::string sourceHash(const std::vector<SceneUpdate>& updates) const;
+
 // protected for testing purposes, else could be private
 protected:
     virtual std::string getSceneString(const std::shared_ptr<Platform>& platform, const Url& scenePath);
@@ -46,6 +52,9 @@ private:
     // import scene to respective root nodes
     std::unordered_map<Url, Node> m_scenes;
 
+    // MD5 of the source string of each imported scene
+    std::unordered_map<Url, std::string> m_sceneHashes;
+
     std::vector<Url> m_sceneQueue;
     static std::atomic_uint progressCounter;
     std::mutex sceneMutex;
@@ -0,0 +1,41 @@
+#include "scene/layerIndex.h"
+
+#include "scene/dataLayer.h"
+
+namespace Tangram {
+
+void LayerIndex::build(const std::vector<DataLayer>& _layers) {
+
+    m_sources.clear();
+
+    for (const auto& layer : _layers) {
+        auto& source = m_sources[layer.source()];
+
+        source.all.push_back(&layer);
+
+        for (const auto& collection : layer.collections()) {
+            auto& layers = source.collections[collection];
+            // A layer may list a collection more than once
+            if (layers.empty() || layers.back() != &layer) {
+                layers.push_back(&layer);
+            }
+        }
+    }
+}
+
+const std::vector<const DataLayer*>& LayerIndex::layers(const std::string& _source,
+                                                        const std::string& _collection) const {
+    static const std::vector<const DataLayer*> empty;
+
+    auto source = m_sources.find(_source);
+    if (source == m_sources.end()) { return empty; }
+
+    if (_collection.empty()) { return source->second.all; }
+
+    auto collection = source->second.collections.find(_collection);
+    if (collection == source->second.collections.end()) { return empty; }
+
+    return collection->second;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+class DataLayer;
+
+/*
+ * LayerIndex maps the source and collection names of tile data to the
+ * DataLayers of a Scene which style them, so that TileBuilder does not need
+ * to compare every layer with every collection of a tile.
+ */
+class LayerIndex {
+
+public:
+
+    // Index @_layers, which must stay in place while the index is used
+    void build(const std::vector<DataLayer>& _layers);
+
+    void clear() { m_sources.clear(); }
+
+    // DataLayers (in scene order) of @_source which apply to @_collection. All
+    // layers of the source apply to an unnamed collection.
+    const std::vector<const DataLayer*>& layers(const std::string& _source,
+                                                const std::string& _collection) const;
+
+private:
+
+    struct SourceLayers {
+        std::vector<const DataLayer*> all;
+        std::unordered_map<std::string, std::vector<const DataLayer*>> collections;
+    };
+
+    std::unordered_map<std::string, SourceLayers> m_sources;
+};
+
+}
@@ -0,0 +1,473 @@
+#include "scene/nativeFunction.h"
+
+#include "data/tileData.h"
+#include "scene/filters.h"
+#include "scene/styleContext.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+namespace Tangram {
+
+using Result = NativeFunction::Result;
+
+bool Result::truthy() const {
+    switch (type) {
+    case Type::boolean:
+    case Type::number:
+        return number != 0 && !std::isnan(number);
+    case Type::string:
+        return !string->empty();
+    default:
+        return false;
+    }
+}
+
+/*
+ * Recursive descent parser for the supported subset of JS expressions,
+ * appending nodes to the function. Each parse method returns the index of
+ * the parsed node or -1 on failure.
+ */
+class NativeFunction::Parser {
+
+public:
+    Parser(const std::string& _source, NativeFunction& _function)
+        : m_src(_source), m_nodes(_function.m_nodes) {}
+
+    // function() { return <expression>; }
+    int32_t parseFunction() {
+        if (!word("function") || !token("(") || !token(")") || !token("{") || !word("return")) {
+            return -1;
+        }
+        int32_t root = conditional();
+        if (root < 0) { return -1; }
+
+        token(";");
+        if (!token("}")) { return -1; }
+
+        skipSpace();
+        return m_pos == m_src.size() ? root : -1;
+    }
+
+private:
+
+    void skipSpace() {
+        while (m_pos < m_src.size() && std::isspace(static_cast<unsigned char>(m_src[m_pos]))) { m_pos++; }
+    }
+
+    bool peek(const char* _token) {
+        skipSpace();
+        return m_src.compare(m_pos, std::strlen(_token), _token) == 0;
+    }
+
+    bool token(const char* _token) {
+        if (!peek(_token)) { return false; }
+        m_pos += std::strlen(_token);
+        return true;
+    }
+
+    static bool isIdentifierChar(char _c) {
+        return std::isalnum(static_cast<unsigned char>(_c)) || _c == '_' || _c == '$';
+    }
+
+    bool identifier(std::string& _name) {
+        skipSpace();
+        size_t start = m_pos;
+        while (m_pos < m_src.size() && isIdentifierChar(m_src[m_pos])) { m_pos++; }
+        if (m_pos == start || std::isdigit(static_cast<unsigned char>(m_src[start]))) {
+            m_pos = start;
+            return false;
+        }
+        _name = m_src.substr(start, m_pos - start);
+        return true;
+    }
+
+    bool word(const char* _word) {
+        size_t start = m_pos;
+        std::string name;
+        if (identifier(name) && name == _word) { return true; }
+        m_pos = start;
+        return false;
+    }
+
+    int32_t add(Op _op, int32_t _a = -1, int32_t _b = -1, int32_t _c = -1) {
+        m_nodes.emplace_back();
+        auto& node = m_nodes.back();
+        node.op = _op;
+        node.operands[0] = _a;
+        node.operands[1] = _b;
+        node.operands[2] = _c;
+        return m_nodes.size() - 1;
+    }
+
+    int32_t literal(Result::Type _type, double _number = 0) {
+        int32_t id = add(Op::literal);
+        m_nodes[id].value.type = _type;
+        m_nodes[id].value.number = _number;
+        return id;
+    }
+
+    // Binary operators of one precedence level, left associative
+    template<typename Next>
+    int32_t binary(Next _next, std::initializer_list<std::pair<const char*, Op>> _ops) {
+        int32_t lhs = (this->*_next)();
+        while (lhs >= 0) {
+            bool found = false;
+            for (auto& op : _ops) {
+                if (!token(op.first)) { continue; }
+                int32_t rhs = (this->*_next)();
+                if (rhs < 0) { return -1; }
+                lhs = add(op.second, lhs, rhs);
+                found = true;
+                break;
+            }
+            if (!found) { break; }
+        }
+        return lhs;
+    }
+
+    int32_t conditional() {
+        int32_t test = logicalOr();
+        if (test < 0 || !token("?")) { return test; }
+
+        int32_t consequent = conditional();
+        if (consequent < 0 || !token(":")) { return -1; }
+        int32_t alternate = conditional();
+        if (alternate < 0) { return -1; }
+
+        return add(Op::conditional, test, consequent, alternate);
+    }
+
+    int32_t logicalOr() { return binary(&Parser::logicalAnd, {{ "||", Op::logicalOr }}); }
+
+    int32_t logicalAnd() { return binary(&Parser::equality, {{ "&&", Op::logicalAnd }}); }
+
+    int32_t equality() {
+        return binary(&Parser::relational, {{ "===", Op::strictEqual }, { "!==", Op::strictNotEqual },
+                                            { "==", Op::equal }, { "!=", Op::notEqual }});
+    }
+
+    int32_t relational() {
+        return binary(&Parser::additive, {{ "<=", Op::lessEqual }, { ">=", Op::greaterEqual },
+                                          { "<", Op::less }, { ">", Op::greater }});
+    }
+
+    int32_t additive() {
+        return binary(&Parser::multiplicative, {{ "+", Op::add }, { "-", Op::subtract }});
+    }
+
+    int32_t multiplicative() {
+        return binary(&Parser::unary, {{ "*", Op::multiply }, { "/", Op::divide }, { "%", Op::modulo }});
+    }
+
+    int32_t unary() {
+        // Exclude '!=' and '--'
+        if (peek("!") && !peek("!=")) {
+            token("!");
+            int32_t operand = unary();
+            return operand < 0 ? -1 : add(Op::logicalNot, operand);
+        }
+        if (peek("-") && !peek("--")) {
+            token("-");
+            int32_t operand = unary();
+            return operand < 0 ? -1 : add(Op::negate, operand);
+        }
+        return primary();
+    }
+
+    int32_t primary() {
+        skipSpace();
+        if (m_pos >= m_src.size()) { return -1; }
+
+        char c = m_src[m_pos];
+
+        if (c == '(') {
+            m_pos++;
+            int32_t expr = conditional();
+            if (expr < 0 || !token(")")) { return -1; }
+            return expr;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            return number();
+        }
+
+        if (c == '\'' || c == '"') {
+            std::string value;
+            if (!string(value)) { return -1; }
+            int32_t id = literal(Result::Type::string);
+            m_nodes[id].string = std::move(value);
+            return id;
+        }
+
+        std::string name;
+        if (!identifier(name)) { return -1; }
+
+        if (name == "true") { return literal(Result::Type::boolean, 1); }
+        if (name == "false") { return literal(Result::Type::boolean, 0); }
+        if (name == "null") { return literal(Result::Type::null); }
+        if (name == "undefined") { return literal(Result::Type::undefined); }
+
+        if (name[0] == '$') {
+            auto keyword = Filter::keywordType(name);
+            if (keyword == FilterKeyword::undefined) { return -1; }
+            int32_t id = add(Op::keyword);
+            m_nodes[id].keyword = keyword;
+            return id;
+        }
+
+        if (name != "feature") { return -1; }
+
+        std::string key;
+        if (token(".")) {
+            if (!identifier(key)) { return -1; }
+        } else if (token("[")) {
+            if (!peek("'") && !peek("\"")) { return -1; }
+            if (!string(key) || !token("]")) { return -1; }
+        } else {
+            return -1;
+        }
+
+        int32_t id = add(Op::property);
+        m_nodes[id].string = std::move(key);
+        return id;
+    }
+
+    int32_t number() {
+        size_t start = m_pos;
+        while (m_pos < m_src.size() && std::isdigit(static_cast<unsigned char>(m_src[m_pos]))) { m_pos++; }
+        if (m_pos < m_src.size() && m_src[m_pos] == '.') {
+            m_pos++;
+            while (m_pos < m_src.size() && std::isdigit(static_cast<unsigned char>(m_src[m_pos]))) { m_pos++; }
+        }
+        if (m_pos < m_src.size() && (m_src[m_pos] == 'e' || m_src[m_pos] == 'E')) {
+            m_pos++;
+            if (m_pos < m_src.size() && (m_src[m_pos] == '+' || m_src[m_pos] == '-')) { m_pos++; }
+            while (m_pos < m_src.size() && std::isdigit(static_cast<unsigned char>(m_src[m_pos]))) { m_pos++; }
+        }
+        // Reject '.', hex and octal literals and numbers followed by identifiers
+        if (m_pos == start || (m_pos - start == 1 && m_src[start] == '.') ||
+            (m_src[start] == '0' && m_pos - start > 1 && m_src[start + 1] != '.') ||
+            (m_pos < m_src.size() && isIdentifierChar(m_src[m_pos]))) {
+            return -1;
+        }
+        std::string literalValue = m_src.substr(start, m_pos - start);
+        return literal(Result::Type::number, std::strtod(literalValue.c_str(), nullptr));
+    }
+
+    bool string(std::string& _value) {
+        char quote = m_src[m_pos++];
+        for (; m_pos < m_src.size(); m_pos++) {
+            char c = m_src[m_pos];
+            if (c == quote) {
+                m_pos++;
+                return true;
+            }
+            if (c == '\n') { return false; }
+            if (c == '\\') {
+                if (++m_pos >= m_src.size()) { return false; }
+                switch (m_src[m_pos]) {
+                case '\\': case '\'': case '"': _value += m_src[m_pos]; break;
+                case 'n': _value += '\n'; break;
+                case 't': _value += '\t'; break;
+                default: return false;
+                }
+                continue;
+            }
+            _value += c;
+        }
+        return false;
+    }
+
+    const std::string& m_src;
+    std::vector<Node>& m_nodes;
+    size_t m_pos = 0;
+};
+
+std::unique_ptr<NativeFunction> NativeFunction::compile(const std::string& _source) {
+
+    std::unique_ptr<NativeFunction> function(new NativeFunction());
+
+    Parser parser(_source, *function);
+    function->m_root = parser.parseFunction();
+
+    if (function->m_root < 0) { return nullptr; }
+
+    return function;
+}
+
+bool NativeFunction::eval(const StyleContext& _ctx, Result& _result) const {
+    return eval(_ctx, m_root, _result);
+}
+
+// ToNumber for all but strings, which are left to Duktape
+static bool toNumber(const Result& _value, double& _number) {
+    switch (_value.type) {
+    case Result::Type::undefined: _number = NAN; return true;
+    case Result::Type::null: _number = 0; return true;
+    case Result::Type::boolean:
+    case Result::Type::number: _number = _value.number; return true;
+    default: return false;
+    }
+}
+
+static bool strictEqual(const Result& _a, const Result& _b) {
+    if (_a.type != _b.type) { return false; }
+    switch (_a.type) {
+    case Result::Type::boolean:
+    case Result::Type::number: return _a.number == _b.number;
+    case Result::Type::string: return *_a.string == *_b.string;
+    default: return true;
+    }
+}
+
+// Abstract equality, returns false when coercion is needed
+static bool looseEqual(const Result& _a, const Result& _b, bool& _equal) {
+    bool aNull = _a.type == Result::Type::undefined || _a.type == Result::Type::null;
+    bool bNull = _b.type == Result::Type::undefined || _b.type == Result::Type::null;
+
+    if (_a.type == _b.type || aNull || bNull) {
+        _equal = (aNull && bNull) || strictEqual(_a, _b);
+        return true;
+    }
+    return false;
+}
+
+bool NativeFunction::eval(const StyleContext& _ctx, int32_t _id, Result& _result) const {
+
+    auto& node = m_nodes[_id];
+
+    switch (node.op) {
+    case Op::literal:
+        _result = node.value;
+        if (_result.type == Result::Type::string) { _result.string = &node.string; }
+        return true;
+
+    case Op::property: {
+        auto* feature = _ctx.feature();
+        const Value& value = feature ? feature->props.get(node.string) : NOT_A_VALUE;
+        if (value.is<double>()) {
+            _result.type = Result::Type::number;
+            _result.number = value.get<double>();
+        } else if (value.is<std::string>()) {
+            _result.type = Result::Type::string;
+            _result.string = &value.get<std::string>();
+        } else {
+            _result.type = Result::Type::undefined;
+        }
+        return true;
+    }
+    case Op::keyword: {
+        const Value& value = _ctx.getKeyword(node.keyword);
+        if (value.is<double>()) {
+            _result.type = Result::Type::number;
+            _result.number = value.get<double>();
+        } else if (value.is<std::string>()) {
+            _result.type = Result::Type::string;
+            _result.string = &value.get<std::string>();
+        } else {
+            // Not defined in the JS context: leave the ReferenceError to Duktape
+            return false;
+        }
+        return true;
+    }
+    case Op::conditional: {
+        Result test;
+        if (!eval(_ctx, node.operands[0], test)) { return false; }
+        return eval(_ctx, node.operands[test.truthy() ? 1 : 2], _result);
+    }
+    case Op::logicalAnd:
+    case Op::logicalOr: {
+        if (!eval(_ctx, node.operands[0], _result)) { return false; }
+        if (_result.truthy() == (node.op == Op::logicalOr)) { return true; }
+        return eval(_ctx, node.operands[1], _result);
+    }
+    case Op::logicalNot: {
+        Result operand;
+        if (!eval(_ctx, node.operands[0], operand)) { return false; }
+        _result.type = Result::Type::boolean;
+        _result.number = operand.truthy() ? 0 : 1;
+        return true;
+    }
+    case Op::negate: {
+        Result operand;
+        double value;
+        if (!eval(_ctx, node.operands[0], operand) || !toNumber(operand, value)) { return false; }
+        _result.type = Result::Type::number;
+        _result.number = -value;
+        return true;
+    }
+    default:
+        break;
+    }
+
+    // Binary operators
+    Result a, b;
+    if (!eval(_ctx, node.operands[0], a) || !eval(_ctx, node.operands[1], b)) { return false; }
+
+    _result.type = Result::Type::boolean;
+
+    switch (node.op) {
+    case Op::strictEqual:
+        _result.number = strictEqual(a, b);
+        return true;
+    case Op::strictNotEqual:
+        _result.number = !strictEqual(a, b);
+        return true;
+    case Op::equal:
+    case Op::notEqual: {
+        bool equal;
+        if (!looseEqual(a, b, equal)) { return false; }
+        _result.number = (equal == (node.op == Op::equal));
+        return true;
+    }
+    case Op::less:
+    case Op::lessEqual:
+    case Op::greater:
+    case Op::greaterEqual: {
+        int cmp;
+        if (a.type == Result::Type::string && b.type == Result::Type::string) {
+            cmp = a.string->compare(*b.string);
+        } else {
+            double x, y;
+            if (!toNumber(a, x) || !toNumber(b, y)) { return false; }
+            if (std::isnan(x) || std::isnan(y)) {
+                _result.number = 0;
+                return true;
+            }
+            cmp = (x < y) ? -1 : (x > y ? 1 : 0);
+        }
+        switch (node.op) {
+        case Op::less: _result.number = cmp < 0; break;
+        case Op::lessEqual: _result.number = cmp <= 0; break;
+        case Op::greater: _result.number = cmp > 0; break;
+        default: _result.number = cmp >= 0; break;
+        }
+        return true;
+    }
+    default:
+        break;
+    }
+
+    // Arithmetic
+    double x, y;
+    if (!toNumber(a, x) || !toNumber(b, y)) { return false; }
+
+    _result.type = Result::Type::number;
+
+    switch (node.op) {
+    case Op::add: _result.number = x + y; break;
+    case Op::subtract: _result.number = x - y; break;
+    case Op::multiply: _result.number = x * y; break;
+    case Op::divide: _result.number = x / y; break;
+    case Op::modulo: _result.number = std::fmod(x, y); break;
+    default: return false;
+    }
+    return true;
+}
+
+}
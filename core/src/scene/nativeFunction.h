@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+class StyleContext;
+
+enum class FilterKeyword : uint8_t;
+
+/*
+ * NativeFunction evaluates simple JS style functions without calling into
+ * Duktape. A function is compiled when its body is a single return statement
+ * with an expression of:
+ *  - feature.key, feature['key'] and keywords like $zoom
+ *  - number, string, boolean, null and undefined literals
+ *  - ?:, ||, &&, ==, !=, ===, !==, <, <=, >, >=, +, -, *, /, % and unary !, -
+ *
+ * Evaluation fails for operand types which would need further JS type
+ * coercion (e.g. string concatenation). The caller must then evaluate the
+ * function with Duktape instead.
+ */
+class NativeFunction {
+
+public:
+
+    struct Result {
+        enum class Type : uint8_t { undefined, null, boolean, number, string };
+
+        Type type = Type::undefined;
+        double number = 0;
+        // Points into the function, the current feature or a keyword
+        const std::string* string = nullptr;
+
+        bool truthy() const;
+    };
+
+    // Returns nullptr when @_source is not in the supported subset
+    static std::unique_ptr<NativeFunction> compile(const std::string& _source);
+
+    bool eval(const StyleContext& _ctx, Result& _result) const;
+
+private:
+
+    enum class Op : uint8_t {
+        literal, property, keyword,
+        negate, logicalNot,
+        logicalAnd, logicalOr, conditional,
+        equal, notEqual, strictEqual, strictNotEqual,
+        less, lessEqual, greater, greaterEqual,
+        add, subtract, multiply, divide, modulo,
+    };
+
+    struct Node {
+        Op op;
+        int32_t operands[3] = { -1, -1, -1 };
+        // Literal value; strings are kept in 'string'
+        Result value;
+        // String literal or property name
+        std::string string;
+        FilterKeyword keyword{};
+    };
+
+    class Parser;
+
+    bool eval(const StyleContext& _ctx, int32_t _node, Result& _result) const;
+
+    std::vector<Node> m_nodes;
+    int32_t m_root = -1;
+};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "scene/layerIndex.h"
 #include "util/color.h"
 #include "view/view.h"
 
@@ -20,6 +21,7 @@ class Platform;
 namespace Tangram {
 
 class DataLayer;
+class DownloadScheduler;
 class FeatureSelection;
 class FontContext;
 class Light;
@@ -28,6 +30,8 @@ class SpriteAtlas;
 class Style;
 class Texture;
 class TileSource;
+struct CompiledFunctions;
+struct StyleParam;
 struct Stops;
 
 
@@ -70,17 +74,23 @@ public:
     auto& config() { return m_config; }
     auto& tileSources() { return m_tileSources; };
     auto& layers() { return m_layers; };
+    auto& layerIndex() { return m_layerIndex; }
     auto& styles() { return m_styles; };
     auto& lights() { return m_lights; };
     auto& lightBlocks() { return m_lightShaderBlocks; };
     auto& textures() { return m_textures; };
     auto& functions() { return m_jsFunctions; };
+    auto& compiledFunctions() { return m_compiledFunctions; }
+    auto& downloadScheduler() { return m_downloadScheduler; }
     auto& spriteAtlases() { return m_spriteAtlases; };
     auto& stops() { return m_stops; }
+    auto& zoomParams() { return m_zoomParams; }
     auto& background() { return m_background; }
     auto& fontContext() { return m_fontContext; }
     auto& globalRefs() { return m_globalRefs; }
     auto& featureSelection() { return m_featureSelection; }
+    auto& names() { return m_names; }
+    auto& sourceHash() { return m_sourceHash; }
     Style* findStyle(const std::string& _name);
 
     const auto& path() const { return m_path; }
@@ -88,14 +98,20 @@ public:
     const auto& config() const { return m_config; }
     const auto& tileSources() const { return m_tileSources; };
     const auto& layers() const { return m_layers; };
+    const auto& layerIndex() const { return m_layerIndex; }
     const auto& styles() const { return m_styles; };
     const auto& lights() const { return m_lights; };
     const auto& lightBlocks() const { return m_lightShaderBlocks; };
     const auto& functions() const { return m_jsFunctions; };
+    const auto& compiledFunctions() const { return m_compiledFunctions; }
     const auto& mapProjection() const { return m_mapProjection; };
     const auto& fontContext() const { return m_fontContext; }
     const auto& globalRefs() const { return m_globalRefs; }
     const auto& featureSelection() const { return m_featureSelection; }
+    const auto& stops() const { return m_stops; }
+    const auto& zoomParams() const { return m_zoomParams; }
+    const auto& names() const { return m_names; }
+    const auto& sourceHash() const { return m_sourceHash; }
 
     const Style* findStyle(const std::string& _name) const;
     const Light* findLight(const std::string& _name) const;
@@ -114,6 +130,9 @@ public:
     glm::dvec2 startPosition = { 0, 0 };
     float startZoom = 0;
 
+    // Whether tiles index the geometry of interactive features for picking
+    std::atomic<bool> featureIndex{false};
+
     void animated(bool animated) { m_animated = animated ? yes : no; }
     animate animated() const { return m_animated; }
 
@@ -134,13 +153,22 @@ private:
 
     std::string m_resourceRoot;
 
+    // Hash of the scene sources and updates this scene was loaded from;
+    // empty when the scene was derived from another one. A CompiledScene
+    // is only used when it was generated for the same hash.
+    std::string m_sourceHash;
+
     // The root node of the YAML scene configuration
     YAML::Node m_config;
 
     std::unique_ptr<MapProjection> m_mapProjection;
 
     std::vector<DataLayer> m_layers;
+    LayerIndex m_layerIndex;
     std::vector<std::shared_ptr<TileSource>> m_tileSources;
+
+    // Shared by the NetworkDataSources of m_tileSources
+    std::shared_ptr<DownloadScheduler> m_downloadScheduler;
     std::vector<std::unique_ptr<Style>> m_styles;
 
     std::vector<std::unique_ptr<Light>> m_lights;
@@ -159,8 +187,16 @@ private:
     std::vector<std::string> m_names;
 
     std::vector<std::string> m_jsFunctions;
+
+    // Bytecode of m_jsFunctions, compiled once when the scene is loaded
+    std::shared_ptr<CompiledFunctions> m_compiledFunctions;
+
     std::list<Stops> m_stops;
 
+    // Layer style parameters with Stops, i.e. which only depend on the zoom
+    // level. Indexed by Stops::zoomIndex.
+    std::vector<const StyleParam*> m_zoomParams;
+
     Color m_background;
 
     std::shared_ptr<FontContext> m_fontContext;
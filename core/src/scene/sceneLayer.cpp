@@ -14,6 +14,9 @@ SceneLayer::SceneLayer(std::string _name, Filter _filter,
     m_sublayers(std::move(_sublayers)),
     m_visible(_visible) {
 
+    m_geometryMask = m_filter.geometryMask();
+    m_filter.zoomRange(m_minZoom, m_maxZoom);
+
     setDepth(1);
 
 }
@@ -20,6 +20,11 @@ class SceneLayer {
     size_t m_depth = 0;
     bool m_visible;
 
+    // Geometry types and zoom range which m_filter can match
+    uint8_t m_geometryMask;
+    float m_minZoom;
+    float m_maxZoom;
+
 public:
 
     SceneLayer(std::string _name, Filter _filter,
@@ -34,6 +39,11 @@ public:
     const auto& depth() const { return m_depth; }
     const auto& visible() const { return m_visible; }
 
+    // Returns false when the filter can not match any feature of @_geometryType at @_zoom
+    bool canMatch(int _geometryType, float _zoom) const {
+        return (m_geometryMask & (1 << _geometryType)) && _zoom >= m_minZoom && _zoom < m_maxZoom;
+    }
+
     void setDepth(size_t _d);
 };
 
@@ -6,6 +6,7 @@
 #include "data/mbtilesDataSource.h"
 #include "data/mvtSource.h"
 #include "data/networkDataSource.h"
+#include "data/rawTileCache.h"
 #include "data/rasterSource.h"
 #include "data/topoJsonSource.h"
 #include "gl/shaderSource.h"
@@ -19,6 +20,7 @@
 #include "style/textStyle.h"
 #include "style/pointStyle.h"
 #include "style/rasterStyle.h"
+#include "scene/compiledScene.h"
 #include "scene/dataLayer.h"
 #include "scene/filters.h"
 #include "scene/importer.h"
@@ -27,6 +29,7 @@
 #include "scene/spriteAtlas.h"
 #include "scene/lights.h"
 #include "scene/stops.h"
+#include "scene/styleContext.h"
 #include "scene/styleMixer.h"
 #include "scene/styleParam.h"
 #include "util/base64.h"
@@ -48,8 +51,6 @@ using YAML::BadConversion;
 namespace Tangram {
 
 const std::string DELIMITER = ":";
-// TODO: make this configurable: 16MB default in-memory DataSource cache:
-constexpr size_t CACHE_SIZE = 16 * (1024 * 1024);
 
 static const std::string GLOBAL_PREFIX = "global.";
 
@@ -63,6 +64,8 @@ bool SceneLoader::loadScene(const std::shared_ptr<Platform>& _platform, std::sha
 
     if (_scene->config()) {
 
+        _scene->sourceHash() = sceneImporter.sourceHash(_updates);
+
         applyUpdates(*_scene, _updates);
 
         // Load font resources
@@ -157,6 +160,21 @@ void SceneLoader::applyGlobals(Node root, Scene& scene) {
     }
 }
 
+// Index the Stops of layer style parameters, to evaluate them once per tile zoom
+static void collectZoomParams(const SceneLayer& _layer, Scene& _scene) {
+    for (const auto& rule : _layer.rules()) {
+        for (const auto& param : rule.parameters) {
+            if (!param.stops || param.function >= 0 || param.stops->zoomIndex >= 0) { continue; }
+
+            param.stops->zoomIndex = _scene.zoomParams().size();
+            _scene.zoomParams().push_back(&param);
+        }
+    }
+    for (const auto& sublayer : _layer.sublayers()) {
+        collectZoomParams(sublayer, _scene);
+    }
+}
+
 bool SceneLoader::applyConfig(const std::shared_ptr<Platform>& _platform, const std::shared_ptr<Scene>& _scene) {
 
     Node& config = _scene->config();
@@ -237,15 +255,22 @@ bool SceneLoader::applyConfig(const std::shared_ptr<Platform>& _platform, const
         styles[i]->setID(i);
     }
 
-    if (Node layers = config["layers"]) {
-        for (const auto& layer : layers) {
-            try { loadLayer(layer, _scene); }
-            catch (YAML::RepresentationException e) {
-                LOGNode("Parsing layer: '%s'", layer, e.what());
+    if (!loadCompiledScene(_platform, _scene)) {
+        if (Node layers = config["layers"]) {
+            for (const auto& layer : layers) {
+                try { loadLayer(layer, _scene); }
+                catch (YAML::RepresentationException e) {
+                    LOGNode("Parsing layer: '%s'", layer, e.what());
+                }
             }
         }
     }
 
+    for (const auto& layer : _scene->layers()) {
+        collectZoomParams(layer, *_scene);
+    }
+    _scene->layerIndex().build(_scene->layers());
+
     if (Node lights = config["lights"]) {
         for (const auto& light : lights) {
             try { loadLight(light, _scene); }
@@ -288,6 +313,46 @@ bool SceneLoader::applyConfig(const std::shared_ptr<Platform>& _platform, const
         style->build(*_scene);
     }
 
+    // Compile JS functions once here rather than in each StyleContext
+    _scene->compiledFunctions() = StyleContext::compileFunctions(*_scene);
+
+    return true;
+}
+
+bool SceneLoader::loadCompiledScene(const std::shared_ptr<Platform>& _platform, const std::shared_ptr<Scene>& _scene) {
+
+    Node compiled = _scene->config()["scene"]["compiled"];
+    if (!compiled || !compiled.IsScalar()) { return false; }
+
+    // Scenes derived by scene updates have no source hash
+    if (_scene->sourceHash().empty()) { return false; }
+
+    Url url(compiled.Scalar());
+    if (url.hasHttpScheme()) {
+        LOGW("Compiled scene must be a local file: '%s'", url.string().c_str());
+        return false;
+    }
+
+    auto data = _platform->bytesFromFile(url.string().c_str());
+    if (data.empty()) { return false; }
+
+    if (!CompiledScene::read(data, *_scene)) {
+        LOGW("Compiled scene '%s' does not match the scene sources", url.string().c_str());
+        return false;
+    }
+
+    for (const auto& layer : _scene->layers()) {
+        if (layer.source().empty()) { continue; }
+
+        if (auto dataSource = _scene->getTileSource(layer.source())) {
+            dataSource->generateGeometry(true);
+        } else {
+            LOGW("Can't find data source %s for layer %s", layer.source().c_str(), layer.name().c_str());
+        }
+    }
+
+    LOGD("Loaded %zu layers from compiled scene '%s'", _scene->layers().size(), url.string().c_str());
+
     return true;
 }
 
@@ -907,6 +972,34 @@ bool SceneLoader::loadStyle(const std::shared_ptr<Platform>& platform, const std
     return true;
 }
 
+// Options of the DownloadScheduler shared by the network sources of a scene
+static DownloadScheduler::Options loadDownloadOptions(const Node& _downloads) {
+
+    DownloadScheduler::Options options;
+
+    if (!_downloads) { return options; }
+    if (!_downloads.IsMap()) {
+        LOGNode("Expected a map for 'downloads'", _downloads);
+        return options;
+    }
+
+    double value;
+    if (Node max = _downloads["max"]) {
+        if (getDouble(max, value, "max") && value >= 1) { options.maxDownloads = value; }
+    }
+    if (Node min = _downloads["min"]) {
+        if (getDouble(min, value, "min") && value >= 1) { options.minDownloads = value; }
+    }
+    if (Node perHost = _downloads["max_per_host"]) {
+        if (getDouble(perHost, value, "max_per_host") && value >= 1) { options.maxDownloadsPerHost = value; }
+    }
+    if (Node adaptive = _downloads["adaptive"]) {
+        getBool(adaptive, options.adaptive, "adaptive");
+    }
+
+    return options;
+}
+
 void SceneLoader::loadSource(const std::shared_ptr<Platform>& platform, const std::string& name,
                              const Node& source, const Node& sources, const std::shared_ptr<Scene>& _scene) {
     if (_scene->getTileSource(name)) {
@@ -992,8 +1085,8 @@ void SceneLoader::loadSource(const std::shared_ptr<Platform>& platform, const st
 
     std::shared_ptr<TileSource> sourcePtr;
 
-    auto rawSources = std::make_unique<MemoryCacheDataSource>();
-    rawSources->setCacheSize(CACHE_SIZE);
+    // Sources with the same URLs share their cached data
+    auto rawSources = std::make_unique<MemoryCacheDataSource>(RawTileCache::shared());
 
     if (isMBTilesFile) {
         // If we have MBTiles, we know the source is tiled.
@@ -1001,7 +1094,11 @@ void SceneLoader::loadSource(const std::shared_ptr<Platform>& platform, const st
         // Create an MBTiles data source from the file at the url and add it to the source chain.
         rawSources->setNext(std::make_unique<MBTilesDataSource>(platform, name, url, mime));
     } else if (tiled) {
-        rawSources->setNext(std::make_unique<NetworkDataSource>(platform, url));
+        if (!_scene->downloadScheduler()) {
+            _scene->downloadScheduler() = std::make_shared<DownloadScheduler>(
+                platform, loadDownloadOptions(_scene->config()["scene"]["downloads"]));
+        }
+        rawSources->setNext(std::make_unique<NetworkDataSource>(platform, url, _scene->downloadScheduler()));
     }
 
     if (type == "GeoJSON") {
@@ -46,6 +46,10 @@ struct SceneLoader {
     static void applyUpdates(Scene& scene, const std::vector<SceneUpdate>& updates);
     static void applyGlobals(Node root, Scene& scene);
 
+    /* Loads layers, filters and draw rules from the compiled scene referenced by
+     * 'scene.compiled', if it was generated from the same scene sources */
+    static bool loadCompiledScene(const std::shared_ptr<Platform>& platform, const std::shared_ptr<Scene>& scene);
+
     /*** all public for testing ***/
 
     static void loadBackground(Node background, const std::shared_ptr<Scene>& scene);
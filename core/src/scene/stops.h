@@ -27,6 +27,11 @@ struct Stops {
     };
 
     std::vector<Frame> frames;
+
+    // Index into the per-zoom StyleParam table of a TileBuilder (see Scene::zoomParams),
+    // -1 when the stops are evaluated per feature
+    int32_t zoomIndex = -1;
+
     static Stops Colors(const YAML::Node& _node);
     static Stops Widths(const YAML::Node& _node, const MapProjection& _projection, const std::vector<Unit>& _units);
     static Stops FontSize(const YAML::Node& _node);
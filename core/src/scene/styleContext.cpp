@@ -11,6 +11,11 @@
 
 #include "duktape.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
 #define DUMP(...) // do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 #define DBG(...) do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 
@@ -19,6 +24,8 @@ namespace Tangram {
 
 const static char INSTANCE_ID[] = "\xff""\xff""obj";
 const static char FUNC_ID[] = "\xff""\xff""fns";
+const static char PROXY_ID[] = "\xff""\xff""prx";
+const static char OBJECT_ID[] = "\xff""\xff""ftr";
 
 static const std::string key_geom("$geometry");
 static const std::string key_zoom("$zoom");
@@ -68,6 +75,10 @@ StyleContext::StyleContext() {
     // Call proxy constructor
     // [cons, feature, handler ] -> [obj|error]
     if (duk_pnew(m_ctx, 2) == 0) {
+        // keep a reference to switch back from the plain feature object
+        duk_dup(m_ctx, -1);
+        duk_put_global_string(m_ctx, PROXY_ID);
+
         // put feature proxy object in global scope
         if (!duk_put_global_string(m_ctx, "feature")) {
             LOGE("Initialization failed");
@@ -77,6 +88,10 @@ StyleContext::StyleContext() {
         duk_pop(m_ctx);
     }
 
+    // Plain feature object for functions with statically known property keys
+    duk_push_object(m_ctx);
+    duk_put_global_string(m_ctx, OBJECT_ID);
+
     DUMP("init\n");
 }
 
@@ -148,8 +163,32 @@ void StyleContext::parseSceneGlobals(const YAML::Node& node) {
     }
 }
 
+// Whether any function in the scene globals references the 'feature' object
+static bool globalsReadFeature(const YAML::Node& node) {
+    switch(node.Type()) {
+    case YAML::NodeType::Scalar: {
+        auto& scalar = node.Scalar();
+        return scalar.compare(0, 8, "function") == 0 && scalar.find("feature") != std::string::npos;
+    }
+    case YAML::NodeType::Sequence:
+        for (const auto& entry : node) {
+            if (globalsReadFeature(entry)) { return true; }
+        }
+        return false;
+    case YAML::NodeType::Map:
+        for (const auto& entry : node) {
+            if (globalsReadFeature(entry.second)) { return true; }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
 void StyleContext::setSceneGlobals(const YAML::Node& sceneGlobals) {
 
+    m_globalsReadFeature = sceneGlobals && globalsReadFeature(sceneGlobals);
+
     if (!sceneGlobals) { return; }
 
     //[ "ctx" ]
@@ -169,7 +208,19 @@ void StyleContext::initFunctions(const Scene& _scene) {
     m_sceneId = _scene.id;
 
     setSceneGlobals(_scene.config()["global"]);
-    setFunctions(_scene.functions());
+
+    auto& compiled = _scene.compiledFunctions();
+    if (!compiled) {
+        setFunctions(_scene.functions());
+        return;
+    }
+
+    loadFunctions(*compiled);
+
+    // Functions added after the scene was loaded, i.e. by marker styling
+    for (size_t i = compiled->functions.size(); i < _scene.functions().size(); i++) {
+        addFunction(_scene.functions()[i]);
+    }
 }
 
 bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
@@ -179,6 +230,11 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
 
     bool ok = true;
 
+    m_functionKeys.clear();
+    m_nativeFunctions.clear();
+    m_functionStats.clear();
+    std::vector<std::string> keys;
+
     for (auto& function : _functions) {
         duk_push_string(m_ctx, function.c_str());
         duk_push_string(m_ctx, "");
@@ -192,6 +248,11 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
             duk_pop(m_ctx);
             ok = false;
         }
+
+        keys.clear();
+        bool staticKeys = scanFeatureKeys(function, m_globalsReadFeature, keys);
+        addFunctionInfo(id, internKeys(staticKeys, keys), NativeFunction::compile(function));
+
         id++;
     }
 
@@ -205,6 +266,58 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
     return ok;
 }
 
+static duk_ret_t loadBytecode(duk_context* _ctx, void* _udata) {
+    auto& bytecode = *static_cast<const std::vector<char>*>(_udata);
+
+    void* buffer = duk_push_fixed_buffer(_ctx, bytecode.size());
+    std::memcpy(buffer, bytecode.data(), bytecode.size());
+
+    // [buffer] -> [function]
+    duk_load_function(_ctx);
+    return 1;
+}
+
+bool StyleContext::loadFunctions(const CompiledFunctions& _functions) {
+
+    auto arr_idx = duk_push_array(m_ctx);
+    int id = 0;
+
+    bool ok = true;
+
+    m_functionKeys.clear();
+    m_nativeFunctions.clear();
+    m_functionStats.clear();
+
+    for (auto& function : _functions.functions) {
+        if (function.bytecode.empty()) {
+            // Compile error was reported by compileFunctions
+            ok = false;
+
+        } else if (duk_safe_call(m_ctx, loadBytecode, const_cast<std::vector<char>*>(&function.bytecode),
+                                 0, 1) == 0) {
+            duk_put_prop_index(m_ctx, arr_idx, id);
+
+        } else {
+            LOGW("Loading function %d failed: %s", id, duk_safe_to_string(m_ctx, -1));
+            duk_pop(m_ctx);
+            ok = false;
+        }
+
+        addFunctionInfo(id, internKeys(function.staticKeys, function.keys), function.native);
+
+        id++;
+    }
+
+    if (!duk_put_global_string(m_ctx, FUNC_ID)) {
+        LOGE("'fns' object not set");
+    }
+
+    m_functionCount = id;
+
+    DUMP("loadFunctions\n");
+    return ok;
+}
+
 bool StyleContext::addFunction(const std::string& _function) {
     // Get all functions (array) in context
     if (!duk_get_global_string(m_ctx, FUNC_ID)) {
@@ -232,12 +345,282 @@ bool StyleContext::addFunction(const std::string& _function) {
     // Pop the functions array off the stack
     duk_pop(m_ctx);
 
+    std::vector<std::string> keys;
+    bool staticKeys = scanFeatureKeys(_function, m_globalsReadFeature, keys);
+    addFunctionInfo(id, internKeys(staticKeys, keys), NativeFunction::compile(_function));
+
     return ok;
 }
 
+std::shared_ptr<CompiledFunctions> StyleContext::compileFunctions(const Scene& _scene) {
+
+    auto compiled = std::make_shared<CompiledFunctions>();
+
+    bool readFeature = globalsReadFeature(_scene.config()["global"]);
+
+    duk_context* ctx = duk_create_heap_default();
+
+    for (auto& source : _scene.functions()) {
+        compiled->functions.emplace_back();
+        auto& function = compiled->functions.back();
+
+        function.staticKeys = scanFeatureKeys(source, readFeature, function.keys);
+        function.native = NativeFunction::compile(source);
+
+        duk_push_string(ctx, source.c_str());
+        duk_push_string(ctx, "");
+
+        if (duk_pcompile(ctx, DUK_COMPILE_FUNCTION) != 0) {
+            LOGW("Compile failed: %s\n%s\n---", duk_safe_to_string(ctx, -1), source.c_str());
+            duk_pop(ctx);
+            continue;
+        }
+
+        // [function] -> [buffer]
+        duk_dump_function(ctx);
+
+        duk_size_t size = 0;
+        auto* data = static_cast<const char*>(duk_get_buffer_data(ctx, -1, &size));
+        function.bytecode.assign(data, data + size);
+
+        duk_pop(ctx);
+    }
+
+    duk_destroy_heap(ctx);
+
+    LOGD("Compiled %d JS functions, %d of them native", compiled->functions.size(),
+         std::count_if(compiled->functions.begin(), compiled->functions.end(),
+                       [](auto& function) { return bool(function.native); }));
+
+    return compiled;
+}
+
+static bool isIdentifierChar(char _c) {
+    return std::isalnum(static_cast<unsigned char>(_c)) || _c == '_' || _c == '$';
+}
+
+bool StyleContext::scanFeatureKeys(const std::string& _function, bool _globalsReadFeature,
+                                   std::vector<std::string>& _keys) {
+
+    const char* src = _function.c_str();
+    const size_t length = _function.size();
+
+    auto skipSpace = [&](size_t _pos) {
+        while (_pos < length && std::isspace(static_cast<unsigned char>(src[_pos]))) { _pos++; }
+        return _pos;
+    };
+
+    // Skip over a string or regular expression literal starting at @_pos,
+    // returns the position after the closing delimiter or 0 when unterminated.
+    auto skipLiteral = [&](size_t _pos) -> size_t {
+        char delimiter = src[_pos++];
+        bool charClass = false;
+        for (; _pos < length; _pos++) {
+            char c = src[_pos];
+            if (c == '\n') { return 0; }
+            if (c == '\\') { _pos++; continue; }
+            if (delimiter == '/') {
+                if (c == '[') { charClass = true; }
+                else if (c == ']') { charClass = false; }
+                else if (c == '/' && !charClass) { return _pos + 1; }
+            } else if (c == delimiter) {
+                return _pos + 1;
+            }
+        }
+        return 0;
+    };
+
+    auto addKey = [&](std::string _key) {
+        if (std::find(_keys.begin(), _keys.end(), _key) == _keys.end()) {
+            _keys.push_back(std::move(_key));
+        }
+    };
+
+    // Last significant character and word, to tell regular expressions from
+    // divisions and property names from identifiers.
+    char last = 0;
+    std::string word;
+
+    size_t pos = 0;
+    while (pos < length) {
+        char c = src[pos];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pos++;
+            continue;
+        }
+
+        if (c == '/' && pos + 1 < length && src[pos + 1] == '/') {
+            while (pos < length && src[pos] != '\n') { pos++; }
+            continue;
+        }
+        if (c == '/' && pos + 1 < length && src[pos + 1] == '*') {
+            pos = _function.find("*/", pos + 2);
+            if (pos == std::string::npos) { return false; }
+            pos += 2;
+            continue;
+        }
+
+        if (c == '"' || c == '\'' ||
+            (c == '/' && (last == 0 || std::strchr("(,=:[!&|?{};+-*%<>~^", last) ||
+                          (last == 'a' && (word == "return" || word == "typeof"))))) {
+            pos = skipLiteral(pos);
+            if (pos == 0) { return false; }
+            last = '"';
+            continue;
+        }
+
+        // Template literals may contain arbitrary expressions
+        if (c == '`') { return false; }
+
+        if (!isIdentifierChar(c)) {
+            last = c;
+            pos++;
+            continue;
+        }
+
+        size_t start = pos;
+        while (pos < length && isIdentifierChar(src[pos])) { pos++; }
+
+        bool property = (last == '.');
+        std::string prevWord = std::move(word);
+        word.assign(src + start, pos - start);
+        last = 'a';
+
+        if (property) { continue; }
+
+        if (word == "this" || word == "eval" || word == "Function") { return false; }
+        if (word == "global" && _globalsReadFeature) { return false; }
+        if (word != "feature") { continue; }
+
+        // Writes to the feature object are only seen by the Proxy target
+        if (prevWord == "delete") { return false; }
+
+        size_t next = skipSpace(pos);
+        if (next < length && src[next] == '.') {
+            size_t keyStart = skipSpace(next + 1);
+            size_t keyEnd = keyStart;
+            while (keyEnd < length && isIdentifierChar(src[keyEnd])) { keyEnd++; }
+            if (keyEnd == keyStart) { return false; }
+
+            addKey(_function.substr(keyStart, keyEnd - keyStart));
+            pos = keyEnd;
+
+        } else if (next < length && src[next] == '[') {
+            size_t keyStart = skipSpace(next + 1);
+            if (keyStart >= length || (src[keyStart] != '"' && src[keyStart] != '\'')) { return false; }
+            size_t keyEnd = skipLiteral(keyStart);
+            if (keyEnd == 0) { return false; }
+
+            std::string key = _function.substr(keyStart + 1, keyEnd - keyStart - 2);
+            if (key.find('\\') != std::string::npos) { return false; }
+
+            size_t close = skipSpace(keyEnd);
+            if (close >= length || src[close] != ']') { return false; }
+
+            addKey(std::move(key));
+            pos = close + 1;
+
+        } else {
+            // 'feature' is used as a whole
+            return false;
+        }
+
+        // Reject assignments to feature properties
+        size_t op = skipSpace(pos);
+        if (op < length) {
+            char c0 = src[op];
+            char c1 = op + 1 < length ? src[op + 1] : 0;
+            char c2 = op + 2 < length ? src[op + 2] : 0;
+            if (c0 == '=' && c1 != '=') { return false; }
+            if ((c0 == '+' || c0 == '-') && c1 == c0) { return false; }
+            if (std::strchr("+-*/%&|^", c0) && c1 == '=') { return false; }
+            if ((c0 == '<' || c0 == '>') && c1 == c0 && (c2 == '=' || c2 == '>')) { return false; }
+        }
+        // Prefix increments
+        if (start >= 2 && (src[start - 1] == '+' || src[start - 1] == '-') && src[start - 2] == src[start - 1]) {
+            return false;
+        }
+
+        last = ']';
+    }
+
+    return true;
+}
+
+void StyleContext::addFunctionInfo(FunctionID _id, FunctionKeys _keys,
+                                   std::shared_ptr<const NativeFunction> _native) {
+    m_functionKeys.resize(_id);
+    m_nativeFunctions.resize(_id);
+    m_functionStats.resize(_id);
+
+    m_functionKeys.push_back(std::move(_keys));
+    m_nativeFunctions.push_back(std::move(_native));
+    m_functionStats.emplace_back();
+}
+
+StyleContext::FunctionKeys StyleContext::internKeys(bool _staticKeys, const std::vector<std::string>& _keys) {
+    FunctionKeys result;
+    result.staticKeys = _staticKeys;
+    if (!_staticKeys) { return result; }
+
+    for (auto& key : _keys) {
+        auto it = m_keyIds.find(key);
+        if (it == m_keyIds.end()) {
+            it = m_keyIds.emplace(key, m_keys.size()).first;
+            m_keys.push_back(key);
+            m_keyGeneration.push_back(0);
+        }
+        result.ids.push_back(it->second);
+    }
+    return result;
+}
+
+void StyleContext::useFeatureProxy(bool _proxy) {
+    if (m_proxyActive == _proxy) { return; }
+    m_proxyActive = _proxy;
+
+    duk_get_global_string(m_ctx, _proxy ? PROXY_ID : OBJECT_ID);
+    duk_put_global_string(m_ctx, "feature");
+}
+
+void StyleContext::bindFeatureKeys(const FunctionKeys& _keys) {
+
+    bool bound = true;
+    for (auto id : _keys.ids) {
+        if (m_keyGeneration[id] != m_featureGeneration) { bound = false; break; }
+    }
+    if (bound) { return; }
+
+    duk_get_global_string(m_ctx, OBJECT_ID);
+
+    for (auto id : _keys.ids) {
+        if (m_keyGeneration[id] == m_featureGeneration) { continue; }
+        m_keyGeneration[id] = m_featureGeneration;
+
+        auto& key = m_keys[id];
+        if (!m_feature) {
+            duk_push_undefined(m_ctx);
+        } else {
+            auto& value = m_feature->props.get(key);
+            if (value.is<std::string>()) {
+                duk_push_string(m_ctx, value.get<std::string>().c_str());
+            } else if (value.is<double>()) {
+                duk_push_number(m_ctx, value.get<double>());
+            } else {
+                duk_push_undefined(m_ctx);
+            }
+        }
+        duk_put_prop_string(m_ctx, -2, key.c_str());
+    }
+
+    duk_pop(m_ctx);
+}
+
 void StyleContext::setFeature(const Feature& _feature) {
 
     m_feature = &_feature;
+    m_featureGeneration++;
 
     if (m_keywordGeom != m_feature->geometryType) {
         setKeyword(key_geom, s_geometryStrings[m_feature->geometryType]);
@@ -291,9 +674,20 @@ const Value& StyleContext::getKeyword(const std::string& _key) const {
 
 void StyleContext::clear() {
     m_feature = nullptr;
+    m_featureGeneration++;
 }
 
 bool StyleContext::evalFunction(FunctionID id) {
+
+    if (id < m_functionStats.size()) { m_functionStats[id].duktape++; }
+
+    if (m_staticBinding && id < m_functionKeys.size() && m_functionKeys[id].staticKeys) {
+        useFeatureProxy(false);
+        bindFeatureKeys(m_functionKeys[id]);
+    } else {
+        useFeatureProxy(true);
+    }
+
     // Get all functions (array) in context
     if (!duk_get_global_string(m_ctx, FUNC_ID)) {
         LOGE("EvalFilterFn - functions array not initialized");
@@ -322,8 +716,23 @@ bool StyleContext::evalFunction(FunctionID id) {
     return true;
 }
 
+bool StyleContext::evalNative(FunctionID _id, NativeFunction::Result& _result) {
+
+    if (!m_nativeEvaluation || !isNativeFunction(_id)) { return false; }
+
+    if (m_nativeFunctions[_id]->eval(*this, _result)) {
+        m_functionStats[_id].native++;
+        return true;
+    }
+    m_functionStats[_id].fallback++;
+    return false;
+}
+
 bool StyleContext::evalFilter(FunctionID _id) {
 
+    NativeFunction::Result native;
+    if (evalNative(_id, native)) { return native.truthy(); }
+
     if (!evalFunction(_id)) { return false; };
 
     // Evaluate the "truthiness" of the function result at the top of the stack.
@@ -337,6 +746,12 @@ bool StyleContext::evalFilter(FunctionID _id) {
 
 bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Value& _val) {
 
+    NativeFunction::Result native;
+    if (evalNative(_id, native)) {
+        parseNativeResult(_key, native, _val);
+        return !_val.is<none_type>();
+    }
+
     if (!evalFunction(_id)) { return false; }
 
     // parse evaluated result at stack top
@@ -348,6 +763,64 @@ bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Val
     return !_val.is<none_type>();
 }
 
+static void parseStyleBoolean(StyleParamKey _key, bool _value, StyleParam::Value& _val) {
+    switch (_key) {
+        case StyleParamKey::interactive:
+        case StyleParamKey::text_interactive:
+        case StyleParamKey::visible:
+            _val = _value;
+            break;
+        case StyleParamKey::extrude:
+            _val = _value ? glm::vec2(NAN, NAN) : glm::vec2(0.0f, 0.0f);
+            break;
+        default:
+            break;
+    }
+}
+
+static void parseStyleNumber(StyleParamKey _key, double _value, StyleParam::Value& _val) {
+    if (std::isnan(_value)) {
+        // Ignore setting value
+        LOGD("duk evaluates JS method to NAN.\n");
+        return;
+    }
+
+    switch (_key) {
+        case StyleParamKey::extrude:
+            _val = glm::vec2(0.f, static_cast<float>(_value));
+            break;
+        case StyleParamKey::placement_spacing: {
+            _val = StyleParam::Width{static_cast<float>(_value), Unit::pixel};
+            break;
+        }
+        case StyleParamKey::width:
+        case StyleParamKey::outline_width: {
+            // TODO more efficient way to return pixels.
+            // atm this only works by return value as string
+            _val = StyleParam::Width{static_cast<float>(_value)};
+            break;
+        }
+        case StyleParamKey::text_font_stroke_width:
+        case StyleParamKey::placement_min_length_ratio: {
+            _val = static_cast<float>(_value);
+            break;
+        }
+        case StyleParamKey::order:
+        case StyleParamKey::outline_order:
+        case StyleParamKey::priority:
+        case StyleParamKey::color:
+        case StyleParamKey::outline_color:
+        case StyleParamKey::text_font_fill:
+        case StyleParamKey::text_font_stroke_color: {
+            // Clamped like duk_get_uint
+            _val = _value <= 0 ? 0u : (_value >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(_value));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val) const {
     _val = none_type{};
 
@@ -356,20 +829,7 @@ void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val)
         _val = StyleParam::parseString(_key, value);
 
     } else if (duk_is_boolean(m_ctx, -1)) {
-        bool value = duk_get_boolean(m_ctx, -1);
-
-        switch (_key) {
-            case StyleParamKey::interactive:
-            case StyleParamKey::text_interactive:
-            case StyleParamKey::visible:
-                _val = value;
-                break;
-            case StyleParamKey::extrude:
-                _val = value ? glm::vec2(NAN, NAN) : glm::vec2(0.0f, 0.0f);
-                break;
-            default:
-                break;
-        }
+        parseStyleBoolean(_key, duk_get_boolean(m_ctx, -1), _val);
 
     } else if (duk_is_array(m_ctx, -1)) {
         duk_get_prop_string(m_ctx, -1, "length");
@@ -431,46 +891,9 @@ void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val)
                 break;
         }
 
-    } else if (duk_is_nan(m_ctx, -1)) {
-        // Ignore setting value
-        LOGD("duk evaluates JS method to NAN.\n");
     } else if (duk_is_number(m_ctx, -1)) {
+        parseStyleNumber(_key, duk_get_number(m_ctx, -1), _val);
 
-        switch (_key) {
-            case StyleParamKey::extrude:
-                _val = glm::vec2(0.f, static_cast<float>(duk_get_number(m_ctx, -1)));
-                break;
-            case StyleParamKey::placement_spacing: {
-                double v = duk_get_number(m_ctx, -1);
-                _val = StyleParam::Width{static_cast<float>(v), Unit::pixel};
-                break;
-            }
-            case StyleParamKey::width:
-            case StyleParamKey::outline_width: {
-                // TODO more efficient way to return pixels.
-                // atm this only works by return value as string
-                double v = duk_get_number(m_ctx, -1);
-                _val = StyleParam::Width{static_cast<float>(v)};
-                break;
-            }
-            case StyleParamKey::text_font_stroke_width:
-            case StyleParamKey::placement_min_length_ratio: {
-                _val = static_cast<float>(duk_get_number(m_ctx, -1));
-                break;
-            }
-            case StyleParamKey::order:
-            case StyleParamKey::outline_order:
-            case StyleParamKey::priority:
-            case StyleParamKey::color:
-            case StyleParamKey::outline_color:
-            case StyleParamKey::text_font_fill:
-            case StyleParamKey::text_font_stroke_color: {
-                _val = static_cast<uint32_t>(duk_get_uint(m_ctx, -1));
-                break;
-            }
-            default:
-                break;
-        }
     } else if (duk_is_null_or_undefined(m_ctx, -1)) {
         // Explicitly set value as 'undefined'. This is important for some styling rules.
         _val = Undefined();
@@ -481,6 +904,29 @@ void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val)
     DUMP("parseStyleResult\n");
 }
 
+void StyleContext::parseNativeResult(StyleParamKey _key, const NativeFunction::Result& _result,
+                                     StyleParam::Value& _val) const {
+    using Type = NativeFunction::Result::Type;
+
+    _val = none_type{};
+
+    switch (_result.type) {
+    case Type::string:
+        _val = StyleParam::parseString(_key, *_result.string);
+        break;
+    case Type::boolean:
+        parseStyleBoolean(_key, _result.number != 0, _val);
+        break;
+    case Type::number:
+        parseStyleNumber(_key, _result.number, _val);
+        break;
+    default:
+        // Explicitly set value as 'undefined'. This is important for some styling rules.
+        _val = Undefined();
+        break;
+    }
+}
+
 // Implements Proxy handler.has(target_object, key)
 duk_ret_t StyleContext::jsHasProperty(duk_context *_ctx) {
 
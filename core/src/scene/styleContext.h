@@ -1,5 +1,6 @@
 #pragma once
 
+#include "scene/nativeFunction.h"
 #include "scene/styleParam.h"
 #include "util/fastmap.h"
 
@@ -8,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct duk_hthread;
 typedef struct duk_hthread duk_context;
@@ -25,6 +27,23 @@ struct StyleParam;
 enum class StyleParamKey : uint8_t;
 enum class FilterKeyword : uint8_t;
 
+/*
+ * JS functions of a Scene compiled once to Duktape bytecode (see
+ * StyleContext::compileFunctions) so that each StyleContext only needs to
+ * load them instead of compiling the sources again.
+ */
+struct CompiledFunctions {
+    struct Function {
+        // Empty when the function failed to compile
+        std::vector<char> bytecode;
+        // Feature properties read by the function; only valid with 'staticKeys'
+        std::vector<std::string> keys;
+        bool staticKeys = false;
+        // Set when the function can be evaluated without Duktape
+        std::shared_ptr<const NativeFunction> native;
+    };
+    std::vector<Function> functions;
+};
 
 class StyleContext {
 
@@ -32,6 +51,15 @@ public:
 
     using FunctionID = uint32_t;
 
+    struct FunctionStats {
+        // Evaluations by NativeFunction
+        uint32_t native = 0;
+        // Evaluations passed on to Duktape as NativeFunction could not handle the operands
+        uint32_t fallback = 0;
+        // Evaluations by Duktape, including fallbacks
+        uint32_t duktape = 0;
+    };
+
     StyleContext();
     ~StyleContext();
 
@@ -48,6 +76,9 @@ public:
     /* Called from Filter::eval */
     float getKeywordZoom() const { return m_keywordZoom; }
 
+    /* Called from NativeFunction::eval */
+    const Feature* feature() const { return m_feature; }
+
     /* returns meters per pixels at current style zoom */
     float getPixelAreaScale();
 
@@ -75,15 +106,68 @@ public:
     bool addFunction(const std::string& _function);
     void setSceneGlobals(const YAML::Node& sceneGlobals);
 
+    /*
+     * Load functions which were compiled by compileFunctions
+     */
+    bool loadFunctions(const CompiledFunctions& _functions);
+
     void setKeyword(const std::string& _key, Value _value);
     const Value& getKeyword(const std::string& _key) const;
 
+    /*
+     * When enabled (default) functions that only read fixed feature
+     * properties get these properties copied to a plain 'feature' object
+     * before evaluation, instead of reading them through the Proxy handler.
+     */
+    void setStaticBinding(bool _enabled) { m_staticBinding = _enabled; }
+
+    /*
+     * When enabled (default) functions which could be compiled to a
+     * NativeFunction are evaluated without Duktape when possible.
+     */
+    void setNativeEvaluation(bool _enabled) { m_nativeEvaluation = _enabled; }
+
+    bool isNativeFunction(FunctionID _id) const {
+        return _id < m_nativeFunctions.size() && m_nativeFunctions[_id];
+    }
+
+    /* Evaluation counts per function id, i.e. per function of a draw rule or filter */
+    const std::vector<FunctionStats>& functionStats() const { return m_functionStats; }
+
+    /*
+     * Compile the JS functions of @_scene to bytecode
+     */
+    static std::shared_ptr<CompiledFunctions> compileFunctions(const Scene& _scene);
+
+    /*
+     * Collect the feature properties which are read by @_function into @_keys.
+     * Returns false when the properties cannot be determined from the source,
+     * e.g. for computed property names or when 'feature' is passed around.
+     * @_globalsReadFeature must be set when scene global functions access
+     * 'feature', as calling these hides the properties they read.
+     */
+    static bool scanFeatureKeys(const std::string& _function, bool _globalsReadFeature,
+                                std::vector<std::string>& _keys);
+
 private:
     static int jsGetProperty(duk_context *_ctx);
     static int jsHasProperty(duk_context *_ctx);
 
+    struct FunctionKeys {
+        bool staticKeys = false;
+        std::vector<uint32_t> ids;
+    };
+
+    FunctionKeys internKeys(bool _staticKeys, const std::vector<std::string>& _keys);
+    void bindFeatureKeys(const FunctionKeys& _keys);
+    void useFeatureProxy(bool _proxy);
+
+    void addFunctionInfo(FunctionID _id, FunctionKeys _keys, std::shared_ptr<const NativeFunction> _native);
+    bool evalNative(FunctionID _id, NativeFunction::Result& _result);
     bool evalFunction(FunctionID id);
     void parseStyleResult(StyleParamKey _key, StyleParam::Value& _val) const;
+    void parseNativeResult(StyleParamKey _key, const NativeFunction::Result& _result,
+                           StyleParam::Value& _val) const;
     void parseSceneGlobals(const YAML::Node& node);
 
     std::array<Value, 4> m_keywords;
@@ -92,6 +176,22 @@ private:
 
     int m_functionCount = 0;
 
+    // Feature properties read by each function, for static binding
+    std::vector<FunctionKeys> m_functionKeys;
+    std::unordered_map<std::string, uint32_t> m_keyIds;
+    std::vector<std::string> m_keys;
+    // Feature generation for which each key was last set on the plain feature object
+    std::vector<uint32_t> m_keyGeneration;
+    uint32_t m_featureGeneration = 1;
+
+    std::vector<std::shared_ptr<const NativeFunction>> m_nativeFunctions;
+    std::vector<FunctionStats> m_functionStats;
+
+    bool m_staticBinding = true;
+    bool m_nativeEvaluation = true;
+    bool m_proxyActive = true;
+    bool m_globalsReadFeature = false;
+
     int32_t m_sceneId = -1;
 
     const Feature* m_feature = nullptr;
@@ -0,0 +1,175 @@
+#include "selection/featureIndex.h"
+
+#include "util/geom.h"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Tangram {
+
+// Number of grid cells along each side of the tile
+const int gridSize = 16;
+
+int FeatureIndex::cell(float _value) {
+    return std::max(0, std::min(gridSize - 1, int(std::floor(_value * gridSize))));
+}
+
+void FeatureIndex::addRing(const Line& _line, Entry& _entry) {
+    for (auto& point : _line) {
+        glm::vec2 p(point);
+        m_points.push_back(p);
+        _entry.min = glm::min(_entry.min, p);
+        _entry.max = glm::max(_entry.max, p);
+    }
+    m_rings.push_back(m_points.size());
+}
+
+void FeatureIndex::add(const Feature& _feature, uint32_t _selectionColor) {
+
+    Entry entry;
+    entry.selectionColor = _selectionColor;
+    entry.type = _feature.geometryType;
+    entry.ringsStart = m_rings.size();
+    entry.min = glm::vec2(std::numeric_limits<float>::max());
+    entry.max = glm::vec2(std::numeric_limits<float>::lowest());
+
+    switch (_feature.geometryType) {
+    case GeometryType::points:
+        addRing(_feature.points, entry);
+        break;
+    case GeometryType::lines:
+        for (auto& line : _feature.lines) {
+            addRing(line, entry);
+        }
+        break;
+    case GeometryType::polygons:
+        for (auto& polygon : _feature.polygons) {
+            for (auto& ring : polygon) {
+                addRing(ring, entry);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    entry.ringsEnd = m_rings.size();
+
+    // Nothing to pick
+    if (entry.min.x > entry.max.x) {
+        m_rings.resize(entry.ringsStart);
+        return;
+    }
+
+    if (m_cells.empty()) { m_cells.resize(gridSize * gridSize); }
+
+    uint32_t id = m_entries.size();
+    m_entries.push_back(entry);
+
+    for (int y = cell(entry.min.y), yEnd = cell(entry.max.y); y <= yEnd; y++) {
+        for (int x = cell(entry.min.x), xEnd = cell(entry.max.x); x <= xEnd; x++) {
+            m_cells[y * gridSize + x].push_back(id);
+        }
+    }
+}
+
+float FeatureIndex::distance(const Entry& _entry, glm::vec2 _position) const {
+
+    // Squared distance to the nearest point or segment
+    float minDistance = std::numeric_limits<float>::max();
+    bool inside = false;
+
+    for (uint32_t ring = _entry.ringsStart; ring < _entry.ringsEnd; ring++) {
+        uint32_t start = ring > 0 ? m_rings[ring - 1] : 0;
+        uint32_t end = m_rings[ring];
+
+        if (_entry.type == GeometryType::points || end - start == 1) {
+            for (uint32_t i = start; i < end; i++) {
+                glm::vec2 d = _position - m_points[i];
+                minDistance = std::min(minDistance, glm::dot(d, d));
+            }
+            continue;
+        }
+
+        // Polygon rings are closed by the edge from the last to the first point
+        bool closed = _entry.type == GeometryType::polygons;
+        uint32_t i = closed ? start : start + 1;
+        uint32_t j = closed ? end - 1 : start;
+
+        for (; i < end; j = i++) {
+            const glm::vec2& a = m_points[j];
+            const glm::vec2& b = m_points[i];
+
+            minDistance = std::min(minDistance, sqPointSegmentDistance(_position, a, b));
+
+            // Even-odd rule over all rings, such that holes are excluded
+            if (closed && ((a.y > _position.y) != (b.y > _position.y)) &&
+                (_position.x < (b.x - a.x) * (_position.y - a.y) / (b.y - a.y) + a.x)) {
+                inside = !inside;
+            }
+        }
+    }
+
+    if (inside) { return 0; }
+
+    return std::sqrt(minDistance);
+}
+
+bool FeatureIndex::pick(glm::vec2 _position, float _radius, Hit& _hit) const {
+
+    if (m_entries.empty()) { return false; }
+
+    bool found = false;
+    uint32_t hitId = 0;
+
+    for (int y = cell(_position.y - _radius), yEnd = cell(_position.y + _radius); y <= yEnd; y++) {
+        for (int x = cell(_position.x - _radius), xEnd = cell(_position.x + _radius); x <= xEnd; x++) {
+
+            for (uint32_t id : m_cells[y * gridSize + x]) {
+                const auto& entry = m_entries[id];
+
+                if (_position.x < entry.min.x - _radius || _position.x > entry.max.x + _radius ||
+                    _position.y < entry.min.y - _radius || _position.y > entry.max.y + _radius) {
+                    continue;
+                }
+
+                float d = distance(entry, _position);
+                if (d > _radius) { continue; }
+
+                // Prefer the later added feature on equal distance, which is
+                // drawn above the earlier one within the same style
+                if (!found || d < _hit.distance || (d == _hit.distance && id > hitId)) {
+                    _hit.selectionColor = entry.selectionColor;
+                    _hit.distance = d;
+                    hitId = id;
+                    found = true;
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+size_t FeatureIndex::getMemoryUsage() const {
+    size_t size = m_points.capacity() * sizeof(glm::vec2) +
+        m_rings.capacity() * sizeof(uint32_t) +
+        m_entries.capacity() * sizeof(Entry);
+
+    for (auto& cell : m_cells) {
+        size += cell.capacity() * sizeof(uint32_t);
+    }
+    return size;
+}
+
+void FeatureIndex::clear() {
+    m_points.clear();
+    m_rings.clear();
+    m_entries.clear();
+    m_cells.clear();
+}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include "glm/vec2.hpp"
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * Spatial index of the interactive features of a tile
+ *
+ * The geometry of each feature is stored in tile coordinates together with
+ * its selection color, and the feature is registered in the cells of a
+ * uniform grid over the tile which its bounding box overlaps. pick() finds the
+ * feature nearest to a position without rendering the selection pass and
+ * reading back its pixels.
+ *
+ * Points and lines match within the pick radius of their geometry, polygons
+ * also match when the position is inside. Line widths and point sizes of the
+ * styles are not taken into account.
+ */
+class FeatureIndex {
+
+public:
+
+    struct Hit {
+        uint32_t selectionColor = 0;
+        // Distance to the feature geometry in tile units, 0 when inside a polygon
+        float distance = 0;
+    };
+
+    // Add the geometry of @_feature with @_selectionColor
+    void add(const Feature& _feature, uint32_t _selectionColor);
+
+    // Find the feature nearest to @_position within @_radius, both in tile
+    // coordinates. Later added features win on equal distance.
+    // Returns false when no feature is within @_radius.
+    bool pick(glm::vec2 _position, float _radius, Hit& _hit) const;
+
+    bool empty() const { return m_entries.empty(); }
+
+    size_t getMemoryUsage() const;
+
+    void clear();
+
+private:
+
+    struct Entry {
+        uint32_t selectionColor;
+        GeometryType type;
+        // Range of the entry in m_rings
+        uint32_t ringsStart;
+        uint32_t ringsEnd;
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+
+    void addRing(const Line& _line, Entry& _entry);
+
+    // Distance from @_position to the geometry of @_entry
+    float distance(const Entry& _entry, glm::vec2 _position) const;
+
+    // Cell coordinate of the tile coordinate @_value
+    static int cell(float _value);
+
+    // Feature coordinates
+    std::vector<glm::vec2> m_points;
+    // End of each point group, line or polygon ring in m_points
+    std::vector<uint32_t> m_rings;
+
+    std::vector<Entry> m_entries;
+
+    // Entries overlapping each grid cell, row-major. Empty until the first add().
+    std::vector<std::vector<uint32_t>> m_cells;
+};
+
+}
@@ -1,7 +1,58 @@
 #include "selection/featureSelection.h"
 
+#include "data/propertyItem.h"
+
+#include <algorithm>
+
 namespace Tangram {
 
+void SelectionFeatures::add(uint32_t _color, const Properties& _props) {
+
+    if (m_ranges.empty() || _color != m_ranges.back().firstColor + m_ranges.back().properties.size()) {
+        m_ranges.push_back({ _color, {} });
+    }
+    m_ranges.back().properties.push_back(_props);
+    m_count++;
+
+    for (const auto& item : _props.items()) {
+        m_itemsUsage += sizeof(item) + item.key.capacity();
+        if (item.value.is<std::string>()) {
+            m_itemsUsage += item.value.get<std::string>().capacity();
+        }
+    }
+}
+
+std::shared_ptr<Properties> SelectionFeatures::getProperties(uint32_t _color) {
+
+    // Range with the greatest first color not above _color
+    auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), _color,
+                               [](uint32_t color, const Range& range) { return color < range.firstColor; });
+    if (it == m_ranges.begin()) { return nullptr; }
+    --it;
+
+    uint32_t offset = _color - it->firstColor;
+    if (offset >= it->properties.size()) { return nullptr; }
+
+    return std::shared_ptr<Properties>(shared_from_this(), &it->properties[offset]);
+}
+
+std::vector<uint32_t> SelectionFeatures::firstColors() const {
+    std::vector<uint32_t> colors;
+    colors.reserve(m_ranges.size());
+    for (const auto& range : m_ranges) {
+        colors.push_back(range.firstColor);
+    }
+    return colors;
+}
+
+size_t SelectionFeatures::getMemoryUsage() const {
+    size_t usage = m_ranges.capacity() * sizeof(Range) + m_itemsUsage;
+    for (const auto& range : m_ranges) {
+        usage += range.properties.capacity() * sizeof(Properties);
+    }
+    return usage;
+}
+
 FeatureSelection::FeatureSelection() :
     m_entry(0) {
 }
@@ -18,4 +69,57 @@ uint32_t FeatureSelection::nextColorIdentifier() {
     return entry;
 }
 
+uint32_t FeatureSelection::reserveColors(uint32_t _count) {
+
+    uint32_t first = m_entry.fetch_add(_count);
+
+    // skip ranges that contain zero every 2^32 features
+    while (first == 0 || uint32_t(first + _count) < first) {
+        first = m_entry.fetch_add(_count);
+    }
+
+    return first;
+}
+
+void FeatureSelection::addFeatures(const std::shared_ptr<SelectionFeatures>& _features) {
+
+    auto colors = _features->firstColors();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Remove the entries of tiles that were dropped
+    if (m_features.size() >= m_pruneSize) {
+        for (auto it = m_features.begin(); it != m_features.end(); ) {
+            if (it->second.expired()) {
+                it = m_features.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_pruneSize = std::max(size_t(64), m_features.size() * 2);
+    }
+
+    for (uint32_t color : colors) {
+        m_features[color] = _features;
+    }
+}
+
+std::shared_ptr<Properties> FeatureSelection::getProperties(uint32_t _color) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Entry with the greatest first color not above _color
+    auto it = m_features.upper_bound(_color);
+    if (it == m_features.begin()) { return nullptr; }
+    --it;
+
+    auto features = it->second.lock();
+    if (!features) {
+        m_features.erase(it);
+        return nullptr;
+    }
+
+    return features->getProperties(_color);
+}
+
 }
@@ -1,9 +1,57 @@
 #pragma once
 
+#include "data/properties.h"
+
 #include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Tangram {
 
+
+/*
+ * Properties of the interactive features of a tile
+ *
+ * Only the properties of features which were built with a selection color are
+ * copied, without their geometry. Consecutive colors are stored in ranges and
+ * a feature is found by the offset of its color in the range.
+ */
+class SelectionFeatures : public std::enable_shared_from_this<SelectionFeatures> {
+
+public:
+
+    // Add @_props of the feature with @_color. Colors must be added in increasing order.
+    void add(uint32_t _color, const Properties& _props);
+
+    // Properties of the feature with @_color, sharing ownership of this object;
+    // null when the color was not added
+    std::shared_ptr<Properties> getProperties(uint32_t _color);
+
+    // First color of each range of consecutive colors
+    std::vector<uint32_t> firstColors() const;
+
+    // Number of interactive features
+    uint32_t count() const { return m_count; }
+
+    bool empty() const { return m_count == 0; }
+
+    size_t getMemoryUsage() const;
+
+private:
+
+    struct Range {
+        uint32_t firstColor;
+        std::vector<Properties> properties;
+    };
+
+    std::vector<Range> m_ranges;
+    uint32_t m_count = 0;
+    // Size of the property items
+    size_t m_itemsUsage = 0;
+};
+
 class FeatureSelection {
 
 public:
@@ -12,10 +60,27 @@ public:
 
     uint32_t nextColorIdentifier();
 
+    // Reserve @_count consecutive colors and return the first one
+    uint32_t reserveColors(uint32_t _count);
+
+    // Register @_features. They can be looked up by color as long as they are alive.
+    void addFeatures(const std::shared_ptr<SelectionFeatures>& _features);
+
+    // Properties of the feature with @_color, or null when the features it belongs to
+    // are no longer alive
+    std::shared_ptr<Properties> getProperties(uint32_t _color) const;
+
 private:
 
     std::atomic<uint32_t> m_entry;
 
+    // Registered features by the first color of each of their ranges
+    mutable std::map<uint32_t, std::weak_ptr<SelectionFeatures>> m_features;
+    // Size of m_features at which expired entries are removed
+    size_t m_pruneSize = 64;
+
+    mutable std::mutex m_mutex;
+
 };
 
 }
@@ -1,14 +1,16 @@
 #include "selection/selectionQuery.h"
 
-#include "gl/framebuffer.h"
 #include "labels/label.h"
 #include "labels/labels.h"
 #include "marker/marker.h"
 #include "marker/markerManager.h"
+#include "selection/featureIndex.h"
+#include "selection/featureSelection.h"
 #include "tile/tileManager.h"
 #include "view/view.h"
 
 #include <cmath>
+#include <limits>
 
 namespace Tangram {
 
@@ -20,12 +22,34 @@ QueryType SelectionQuery::type() const {
           (m_queryCallback.is<LabelPickCallback>() ? QueryType::label : QueryType::marker);
 }
 
-void SelectionQuery::process(const View& _view, const FrameBuffer& _framebuffer, const MarkerManager& _markerManager,
-                             const TileManager& _tileManager, const Labels& _labels, std::vector<SelectionColorRead>& _colorCache) const {
-
+void SelectionQuery::windowRect(const View& _view, glm::vec2& _position, glm::vec2& _size) const {
     float radius = m_radius * _view.pixelScale();
-    glm::vec2 windowCoordinates = _view.normalizedWindowCoordinates(m_position.x - radius, m_position.y + radius);
-    glm::vec2 windowSize = _view.normalizedWindowCoordinates(m_position.x + radius, m_position.y - radius) - windowCoordinates;
+    _position = _view.normalizedWindowCoordinates(m_position.x - radius, m_position.y + radius);
+    _size = _view.normalizedWindowCoordinates(m_position.x + radius, m_position.y - radius) - _position;
+}
+
+uint32_t SelectionQuery::nearestColor(const FrameBuffer::PixelRect& _rect) {
+
+    // Find the first non-zero color nearest to the position and within the selection radius.
+    uint32_t color = 0;
+    float minDistance = std::fmin(_rect.width, _rect.height);
+    float hw = static_cast<float>(_rect.width) / 2.f, hh = static_cast<float>(_rect.height) / 2.f;
+    for (int32_t row = 0; row < _rect.height; row++) {
+        for (int32_t col = 0; col < _rect.width; col++) {
+            uint32_t sample = _rect.pixels[row * _rect.width + col];
+            float distance = std::hypot(row - hw, col - hh);
+            if (sample != 0 && distance < minDistance) {
+                color = sample;
+                minDistance = distance;
+            }
+        }
+    }
+    return color;
+}
+
+void SelectionQuery::process(const View& _view, const FrameBuffer& _framebuffer, const MarkerManager& _markerManager,
+                             const FeatureSelection& _featureSelection, const Labels& _labels,
+                             std::vector<SelectionColorRead>& _colorCache) const {
 
     GLuint color = 0;
 
@@ -34,54 +58,48 @@ void SelectionQuery::process(const View& _view, const FrameBuffer& _framebuffer,
     });
 
     if (it == _colorCache.end()) {
-        // Find the first non-zero color nearest to the position and within the selection radius.
+        glm::vec2 windowCoordinates, windowSize;
+        windowRect(_view, windowCoordinates, windowSize);
+
         auto rect = _framebuffer.readRect(windowCoordinates.x, windowCoordinates.y, windowSize.x, windowSize.y);
-        float minDistance = std::fmin(rect.width, rect.height);
-        float hw = static_cast<float>(rect.width) / 2.f, hh = static_cast<float>(rect.height) / 2.f;
-        for (int32_t row = 0; row < rect.height; row++) {
-            for (int32_t col = 0; col < rect.width; col++) {
-                uint32_t sample = rect.pixels[row * rect.width + col];
-                float distance = std::hypot(row - hw, col - hh);
-                if (sample != 0 && distance < minDistance) {
-                    color = sample;
-                    minDistance = distance;
-                }
-            }
-        }
+        color = nearestColor(rect);
+
         // Cache the resulting color for other queries.
         _colorCache.push_back({color, m_radius, m_position});
     } else {
         color = it->color;
     }
 
+    resolve(color, _view, _markerManager, _featureSelection, _labels);
+}
+
+void SelectionQuery::process(const View& _view, const FrameBuffer::PixelRect& _rect, const MarkerManager& _markerManager,
+                             const FeatureSelection& _featureSelection, const Labels& _labels) const {
+
+    resolve(nearestColor(_rect), _view, _markerManager, _featureSelection, _labels);
+}
+
+void SelectionQuery::resolve(uint32_t _color, const View& _view, const MarkerManager& _markerManager,
+                             const FeatureSelection& _featureSelection, const Labels& _labels) const {
+
     switch (type()) {
     case QueryType::feature: {
-        auto& cb = m_queryCallback.get<FeaturePickCallback>();
-
-        if (color == 0) {
-            cb(nullptr);
+        if (_color == 0) {
+            resolveFeature(nullptr);
             return;
         }
 
-        for (const auto& tile : _tileManager.getVisibleTiles()) {
-            if (auto props = tile->getSelectionFeature(color)) {
-                FeaturePickResult queryResult(props, {{m_position.x, m_position.y}});
-                cb(&queryResult);
-                return;
-            }
-        }
-
-        cb(nullptr);
+        resolveFeature(_featureSelection.getProperties(_color));
     } break;
     case QueryType::marker: {
         auto& cb = m_queryCallback.get<MarkerPickCallback>();
 
-        if (color == 0) {
+        if (_color == 0) {
             cb(nullptr);
             return;
         }
 
-        auto marker = _markerManager.getMarkerOrNullBySelectionColor(color);
+        auto marker = _markerManager.getMarkerOrNullBySelectionColor(_color);
 
         if (!marker) {
             cb(nullptr);
@@ -95,35 +113,100 @@ void SelectionQuery::process(const View& _view, const FrameBuffer& _framebuffer,
         cb(&markerResult);
     } break;
     case QueryType::label: {
-        auto& cb = m_queryCallback.get<LabelPickCallback>();
-
-        if (color == 0) {
-            cb(nullptr);
+        if (_color == 0) {
+            resolveLabel({nullptr, nullptr});
             return;
         }
 
-        auto label = _labels.getLabel(color);
+        resolveLabel(_labels.getLabel(_color));
+    } break;
+    default: break;
+    }
+}
 
-        if (!label.first || !label.second) {
-            cb(nullptr);
-            return;
-        }
+bool SelectionQuery::processIndexed(View& _view, const TileManager& _tileManager, Labels& _labels) const {
 
-        auto props = label.second->getSelectionFeature(label.first->options().featureId);
+    float radius = m_radius * _view.pixelScale();
 
-        if (!props) {
-            cb(nullptr);
-            return;
+    switch (type()) {
+    case QueryType::feature: {
+        // Project the position and the radius onto the ground plane
+        double x = m_position.x, y = m_position.y;
+        double rx = m_position.x + radius, ry = m_position.y;
+
+        if (_view.screenToGroundPlane(x, y) < 0) {
+            resolveFeature(nullptr);
+            return true;
         }
+        _view.screenToGroundPlane(rx, ry);
+
+        glm::dvec3 eye = _view.getPosition();
+        glm::dvec2 meters(x + eye.x, y + eye.y);
+        double radiusMeters = std::hypot(rx - x, ry - y);
+
+        std::shared_ptr<Properties> props;
+        double minDistance = std::numeric_limits<double>::max();
+
+        for (const auto& tile : _tileManager.getVisibleTiles()) {
+            auto featureIndex = tile->getFeatureIndex();
+            if (!featureIndex) { continue; }
 
-        auto coordinate = label.second->coordToLngLat(label.first->modelCenter());
+            double scale = tile->getInverseScale();
+            glm::vec2 position((meters - tile->getOrigin()) * scale);
 
-        LabelPickResult queryResult(label.first->renderType(), LngLat{coordinate.x, coordinate.y},
-                                    FeaturePickResult(props, {{m_position.x, m_position.y}}));
+            FeatureIndex::Hit hit;
+            if (featureIndex->pick(position, radiusMeters * scale, hit) &&
+                hit.distance / scale < minDistance) {
+                props = tile->getSelectionFeature(hit.selectionColor);
+                minDistance = hit.distance / scale;
+            }
+        }
 
-        cb(&queryResult);
+        resolveFeature(props);
     } break;
-    default: break;
+    case QueryType::label: {
+        resolveLabel(_labels.getLabelAt(m_position, radius));
+    } break;
+    default:
+        return false;
     }
+
+    return true;
 }
+
+void SelectionQuery::resolveFeature(std::shared_ptr<Properties> _props) const {
+    auto& cb = m_queryCallback.get<FeaturePickCallback>();
+
+    if (!_props) {
+        cb(nullptr);
+        return;
+    }
+
+    FeaturePickResult queryResult(_props, {{m_position.x, m_position.y}});
+    cb(&queryResult);
+}
+
+void SelectionQuery::resolveLabel(std::pair<Label*, Tile*> _label) const {
+    auto& cb = m_queryCallback.get<LabelPickCallback>();
+
+    if (!_label.first || !_label.second) {
+        cb(nullptr);
+        return;
+    }
+
+    auto props = _label.second->getSelectionFeature(_label.first->options().featureId);
+
+    if (!props) {
+        cb(nullptr);
+        return;
+    }
+
+    auto coordinate = _label.second->coordToLngLat(_label.first->modelCenter());
+
+    LabelPickResult queryResult(_label.first->renderType(), LngLat{coordinate.x, coordinate.y},
+                                FeaturePickResult(props, {{m_position.x, m_position.y}}));
+
+    cb(&queryResult);
+}
+
 }
@@ -1,16 +1,20 @@
 #pragma once
 
+#include "gl/framebuffer.h"
 #include "glm/vec2.hpp"
 #include "tangram.h"
 #include "util/variant.h"
 
 namespace Tangram {
 
+class FeatureSelection;
 class MarkerManager;
-class FrameBuffer;
 class TileManager;
+class Label;
 class Labels;
+class Tile;
 class View;
+struct Properties;
 
 enum class QueryType {
     feature,
@@ -32,11 +36,34 @@ public:
     SelectionQuery(glm::vec2 _position, float _radius, QueryCallback _queryCallback);
 
     void process(const View& _view, const FrameBuffer& _framebuffer, const MarkerManager& _markerManager,
-                 const TileManager& _tileManager, const Labels& _labels, std::vector<SelectionColorRead>& _cache) const;
+                 const FeatureSelection& _featureSelection, const Labels& _labels,
+                 std::vector<SelectionColorRead>& _cache) const;
+
+    // Resolve the query with the pixels read from the selection buffer around its position,
+    // e.g. by FrameBuffer::readRectAsync in a previous frame
+    void process(const View& _view, const FrameBuffer::PixelRect& _rect, const MarkerManager& _markerManager,
+                 const FeatureSelection& _featureSelection, const Labels& _labels) const;
+
+    // Normalized window rect of the selection buffer to read for the query
+    void windowRect(const View& _view, glm::vec2& _position, glm::vec2& _size) const;
+
+    // Resolve a feature or label query with the feature indexes of the tiles and the label bounds,
+    // without reading back the selection buffer. Returns false for marker queries, which must be
+    // resolved by process().
+    bool processIndexed(View& _view, const TileManager& _tileManager, Labels& _labels) const;
 
     QueryType type() const;
 
 private:
+    // Selection color nearest to the center of @_rect
+    static uint32_t nearestColor(const FrameBuffer::PixelRect& _rect);
+
+    void resolve(uint32_t _color, const View& _view, const MarkerManager& _markerManager,
+                 const FeatureSelection& _featureSelection, const Labels& _labels) const;
+
+    void resolveFeature(std::shared_ptr<Properties> _props) const;
+    void resolveLabel(std::pair<Label*, Tile*> _label) const;
+
     glm::vec2 m_position;
     float m_radius;
     QueryCallback m_queryCallback;
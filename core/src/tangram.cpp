@@ -1,8 +1,11 @@
 #include "tangram.h"
 
 #include "data/clientGeoJsonSource.h"
+#include "data/rawTileCache.h"
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
+#include "debug/frameProfiler.h"
+#include "debug/trace.h"
 #include "gl.h"
 #include "gl/error.h"
 #include "gl/framebuffer.h"
@@ -16,6 +19,7 @@
 #include "platform.h"
 #include "scene/scene.h"
 #include "scene/sceneLoader.h"
+#include "selection/featureSelection.h"
 #include "selection/selectionQuery.h"
 #include "style/material.h"
 #include "style/style.h"
@@ -23,6 +27,7 @@
 #include "tile/tile.h"
 #include "tile/tileCache.h"
 #include "tile/tileManager.h"
+#include "tile/tilePrefetcher.h"
 #include "util/asyncWorker.h"
 #include "util/fastmap.h"
 #include "util/inputHandler.h"
@@ -30,6 +35,8 @@
 #include "util/jobQueue.h"
 #include "view/view.h"
 
+#include "glm/common.hpp"
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 
@@ -65,6 +72,7 @@ public:
     std::mutex sceneMutex;
 
     RenderState renderState;
+    FrameProfiler frameProfiler;
     JobQueue jobQueue;
     View view;
     Labels labels;
@@ -75,6 +83,11 @@ public:
     std::vector<SceneUpdate> sceneUpdates;
     std::array<Ease, 4> eases;
 
+    // Targets of the position (in meters) and zoom eases for tile prefetching
+    glm::dvec2 positionTarget;
+    float zoomTarget = 0;
+    TilePrefetcher tilePrefetcher;
+
     std::shared_ptr<Scene> scene;
     std::shared_ptr<Scene> nextScene = nullptr;
 
@@ -87,9 +100,13 @@ public:
     std::unique_ptr<FrameBuffer> selectionBuffer = std::make_unique<FrameBuffer>(0, 0);
 
     bool cacheGlState = false;
+    bool featureIndex = false;
+    bool asyncPicking = false;
     float pickRadius = .5f;
 
     std::vector<SelectionQuery> selectionQueries;
+    // Queries waiting for their selection buffer read, by read ID
+    std::vector<std::pair<int, SelectionQuery>> pendingSelectionQueries;
 };
 
 void Map::Impl::setEase(EaseField _f, Ease _e) {
@@ -128,6 +145,7 @@ void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
     }
 
     scene->setPixelScale(view.pixelScale());
+    scene->featureIndex = featureIndex;
 
     auto& camera = scene->camera();
     view.setCameraType(camera.type);
@@ -333,6 +351,7 @@ bool Map::update(float _dt) {
     }
 
     FrameInfo::beginUpdate();
+    impl->frameProfiler.beginUpdate();
 
     impl->jobQueue.runJobs();
 
@@ -352,6 +371,18 @@ bool Map::update(float _dt) {
 
     impl->view.update();
 
+    {
+        auto& positionEase = impl->eases[static_cast<size_t>(EaseField::position)];
+        if (!positionEase.finished()) {
+            impl->tilePrefetcher.easePosition(impl->positionTarget, positionEase.d - positionEase.t);
+        }
+        auto& zoomEase = impl->eases[static_cast<size_t>(EaseField::zoom)];
+        if (!zoomEase.finished()) {
+            impl->tilePrefetcher.easeZoom(impl->zoomTarget, zoomEase.d - zoomEase.t);
+        }
+        impl->tilePrefetcher.update(impl->view, _dt);
+    }
+
     impl->markerManager.update(static_cast<int>(impl->view.getZoom()));
 
     for (const auto& style : impl->scene->styles()) {
@@ -361,7 +392,8 @@ bool Map::update(float _dt) {
     {
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
-        impl->tileManager.updateTileSets(impl->view.state(), impl->view.getVisibleTiles());
+        impl->tileManager.updateTileSets(impl->view.state(), impl->view.getVisibleTiles(),
+                                         impl->tilePrefetcher.tiles());
 
         auto& tiles = impl->tileManager.getVisibleTiles();
         auto& markers = impl->markerManager.markers();
@@ -370,6 +402,7 @@ bool Map::update(float _dt) {
             marker->update(_dt, impl->view);
             markersNeedUpdate |= marker->isEasing();
         }
+        markersNeedUpdate |= impl->markerManager.hasPendingBuilds();
 
         if (impl->view.changedOnLastUpdate() ||
             impl->tileManager.hasTileSetChanged()) {
@@ -377,14 +410,19 @@ bool Map::update(float _dt) {
             for (const auto& tile : tiles) {
                 tile->update(_dt, impl->view);
             }
+            impl->frameProfiler.beginLabels();
             impl->labels.updateLabelSet(impl->view.state(), _dt, impl->scene->styles(), tiles, markers,
                                         *impl->tileManager.getTileCache());
+            impl->frameProfiler.endLabels();
         } else {
+            impl->frameProfiler.beginLabels();
             impl->labels.updateLabels(impl->view.state(), _dt, impl->scene->styles(), tiles, markers);
+            impl->frameProfiler.endLabels();
         }
     }
 
     FrameInfo::endUpdate();
+    impl->frameProfiler.endUpdate();
 
     bool viewChanged = impl->view.changedOnLastUpdate();
     bool tilesChanged = impl->tileManager.hasTileSetChanged();
@@ -407,6 +445,30 @@ void Map::setPickRadius(float _radius) {
     impl->pickRadius = _radius;
 }
 
+void Map::useFeatureIndex(bool _use) {
+    if (impl->featureIndex == _use) { return; }
+
+    impl->featureIndex = _use;
+    impl->scene->featureIndex = _use;
+
+    // Tiles must be rebuilt to add or drop their feature indexes.
+    impl->tileManager.clearTileSets();
+
+    platform->requestRender();
+}
+
+void Map::useAsyncPicking(bool _use) {
+    impl->asyncPicking = _use;
+}
+
+void Map::useFrameStats(bool _use) {
+    impl->frameProfiler.setEnabled(_use);
+}
+
+bool Map::getFrameStats(FrameStats& _stats) {
+    return impl->frameProfiler.getStats(_stats);
+}
+
 void Map::pickFeatureAt(float _x, float _y, FeaturePickCallback _onFeaturePickCallback) {
     impl->selectionQueries.push_back({{_x, _y}, impl->pickRadius, _onFeaturePickCallback});
 
@@ -444,13 +506,52 @@ void Map::render() {
         impl->renderState.invalidate();
     }
 
+    impl->frameProfiler.beginFrame(impl->renderState);
+
     // Run render-thread tasks
     impl->renderState.jobQueue.runJobs();
 
+    // Resolve feature and label queries without the selection pass
+    if (impl->featureIndex && !impl->selectionQueries.empty()) {
+        std::lock_guard<std::mutex> lock(impl->tilesMutex);
+
+        auto& queries = impl->selectionQueries;
+        queries.erase(std::remove_if(queries.begin(), queries.end(), [&](const auto& _query) {
+                    return _query.processIndexed(impl->view, impl->tileManager, impl->labels);
+                }), queries.end());
+    }
+
+    // Resolve the queries whose selection buffer reads were finished by the GPU
+    if (!impl->pendingSelectionQueries.empty()) {
+        std::lock_guard<std::mutex> lock(impl->tilesMutex);
+
+        auto& pending = impl->pendingSelectionQueries;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](const auto& _pending) {
+                    FrameBuffer::PixelRect rect;
+                    if (!impl->selectionBuffer->readRectAsyncResult(_pending.first, rect)) { return false; }
+
+                    _pending.second.process(impl->view, rect, impl->markerManager,
+                                            *impl->scene->featureSelection(), impl->labels);
+                    return true;
+                }), pending.end());
+    }
+
     // Render feature selection pass to offscreen framebuffer
     if (impl->selectionQueries.size() > 0 || drawSelectionBuffer) {
         impl->selectionBuffer->applyAsRenderTarget(impl->renderState);
 
+        // Only draw the region around the queries, unless the selection buffer is shown
+        if (!drawSelectionBuffer) {
+            glm::vec2 min(1.f), max(0.f);
+            for (const auto& selectionQuery : impl->selectionQueries) {
+                glm::vec2 position, size;
+                selectionQuery.windowRect(impl->view, position, size);
+                min = glm::min(min, position);
+                max = glm::max(max, position + size);
+            }
+            impl->selectionBuffer->scissor(min.x, min.y, max.x - min.x, max.y - min.y);
+        }
+
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
         for (const auto& style : impl->scene->styles()) {
@@ -465,16 +566,30 @@ void Map::render() {
             }
         }
 
+        impl->selectionBuffer->scissor(0, 0, 0, 0);
+
         std::vector<SelectionColorRead> colorCache;
         // Resolve feature selection queries
         for (const auto& selectionQuery : impl->selectionQueries) {
+            if (impl->asyncPicking) {
+                // Read without waiting for the GPU, resolved in a later frame
+                glm::vec2 position, size;
+                selectionQuery.windowRect(impl->view, position, size);
+                int read = impl->selectionBuffer->readRectAsync(position.x, position.y, size.x, size.y);
+                if (read) {
+                    impl->pendingSelectionQueries.emplace_back(read, selectionQuery);
+                    continue;
+                }
+            }
             selectionQuery.process(impl->view, *impl->selectionBuffer, impl->markerManager,
-                                   impl->tileManager, impl->labels, colorCache);
+                                   *impl->scene->featureSelection(), impl->labels, colorCache);
         }
 
         impl->selectionQueries.clear();
     }
 
+    if (!impl->pendingSelectionQueries.empty()) { platform->requestRender(); }
+
     // Setup default framebuffer for a new frame
     glm::vec2 viewport(impl->view.getWidth(), impl->view.getHeight());
     FrameBuffer::apply(impl->renderState, impl->renderState.defaultFrameBuffer(),
@@ -482,6 +597,7 @@ void Map::render() {
 
     if (drawSelectionBuffer) {
         impl->selectionBuffer->drawDebug(impl->renderState, viewport);
+        impl->frameProfiler.endFrame(impl->renderState, 0);
         FrameInfo::draw(impl->renderState, impl->view, impl->tileManager);
         return;
     }
@@ -490,12 +606,17 @@ void Map::render() {
         style->onBeginFrame(impl->renderState);
     }
 
+    uint32_t tilesDrawn = 0;
     {
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
+        tilesDrawn = impl->tileManager.getVisibleTiles().size();
+
         // Loop over all styles
         for (const auto& style : impl->scene->styles()) {
 
+            impl->frameProfiler.beginStyle(impl->renderState, *style);
+
             style->onBeginDrawFrame(impl->renderState, impl->view, *(impl->scene));
 
             // Loop over all tiles in m_tileSet
@@ -508,9 +629,13 @@ void Map::render() {
             }
 
             style->onEndDrawFrame();
+
+            impl->frameProfiler.endStyle(impl->renderState);
         }
     }
 
+    impl->frameProfiler.endFrame(impl->renderState, tilesDrawn);
+
     impl->labels.drawDebug(impl->renderState, impl->view);
 
     FrameInfo::draw(impl->renderState, impl->view, impl->tileManager);
@@ -545,6 +670,8 @@ void Map::setPosition(double _lon, double _lat) {
 
     impl->setPositionNow(_lon, _lat);
     impl->clearEase(EaseField::position);
+    // Do not extrapolate the jump
+    impl->tilePrefetcher.reset();
 
 }
 
@@ -554,6 +681,7 @@ void Map::setPositionEased(double _lon, double _lat, float _duration, EaseType _
     getPosition(lon_start, lat_start);
     auto cb = [=](float t) { impl->setPositionNow(ease(lon_start, _lon, t, _e), ease(lat_start, _lat, t, _e)); };
     impl->setEase(EaseField::position, { _duration, cb });
+    impl->positionTarget = impl->view.getMapProjection().LonLatToMeters({ _lon, _lat });
 
 }
 
@@ -578,6 +706,7 @@ void Map::setZoom(float _z) {
 
     impl->setZoomNow(_z);
     impl->clearEase(EaseField::zoom);
+    impl->tilePrefetcher.reset();
 
 }
 
@@ -586,6 +715,7 @@ void Map::setZoomEased(float _z, float _duration, EaseType _e) {
     float z_start = getZoom();
     auto cb = [=](float t) { impl->setZoomNow(ease(z_start, _z, t, _e)); };
     impl->setEase(EaseField::zoom, { _duration, cb });
+    impl->zoomTarget = _z;
 
 }
 
@@ -745,6 +875,12 @@ MarkerID Map::markerAdd() {
     return impl->markerManager.add();
 }
 
+std::vector<MarkerID> Map::markerAddPoints(const char* _styling, const LngLat* _coordinates, int _count) {
+    auto ids = impl->markerManager.addPoints(_styling, _coordinates, _count);
+    platform->requestRender();
+    return ids;
+}
+
 bool Map::markerRemove(MarkerID _marker) {
     bool success = impl->markerManager.remove(_marker);
     platform->requestRender();
@@ -851,6 +987,7 @@ void Map::setupGL() {
     LOG("setup GL");
 
     impl->renderState.invalidate();
+    impl->frameProfiler.invalidate();
 
     impl->tileManager.clearTileSets();
 
@@ -875,6 +1012,10 @@ void Map::useCachedGlState(bool _useCache) {
     impl->cacheGlState = _useCache;
 }
 
+void Map::setTileDataCacheSize(size_t _bytes) {
+    RawTileCache::shared()->setMaxUsage(_bytes);
+}
+
 void Map::runAsyncTask(std::function<void()> _task) {
     if (impl->asyncWorker) {
         impl->asyncWorker->enqueue(std::move(_task));
@@ -911,4 +1052,16 @@ void toggleDebugFlag(DebugFlags _flag) {
     // }
 }
 
+void setTracing(bool _on) {
+    Trace::setEnabled(_on);
+}
+
+std::string getTraceJson() {
+    return Trace::json();
+}
+
+void clearTrace() {
+    Trace::clear();
+}
+
 }
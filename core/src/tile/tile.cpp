@@ -1,13 +1,18 @@
 #include "tile/tile.h"
 
 #include "data/tileSource.h"
+#include "gl/texture.h"
 #include "labels/labelSet.h"
+#include "selection/featureIndex.h"
+#include "selection/featureSelection.h"
 #include "style/style.h"
 #include "tile/tileID.h"
 #include "view/view.h"
 
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <algorithm>
+
 namespace Tangram {
 
 Tile::Tile(TileID _id, const MapProjection& _projection, const TileSource* _source) :
@@ -93,16 +98,22 @@ const std::unique_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
     return m_geometry[_style.getID()];
 }
 
-void Tile::setSelectionFeatures(const fastmap<uint32_t, std::shared_ptr<Properties>> _selectionFeatures) {
-    m_selectionFeatures = _selectionFeatures;
+void Tile::setSelectionFeatures(std::shared_ptr<SelectionFeatures> _selectionFeatures) {
+    m_selectionFeatures = std::move(_selectionFeatures);
+}
+
+void Tile::setFeatureIndex(std::unique_ptr<FeatureIndex> _featureIndex) {
+    m_featureIndex = std::move(_featureIndex);
 }
 
 std::shared_ptr<Properties> Tile::getSelectionFeature(uint32_t _id) {
-    auto it = m_selectionFeatures.find(_id);
-    if (it != m_selectionFeatures.end()) {
-        return it->second;
-    }
-    return nullptr;
+    if (!m_selectionFeatures) { return nullptr; }
+
+    return m_selectionFeatures->getProperties(_id);
+}
+
+size_t Tile::getSelectionFeatureCount() const {
+    return m_selectionFeatures ? m_selectionFeatures->count() : 0;
 }
 
 size_t Tile::getMemoryUsage() const {
@@ -112,9 +123,28 @@ size_t Tile::getMemoryUsage() const {
                 m_memoryUsage += entry->bufferSize();
             }
         }
+        if (m_featureIndex) {
+            m_memoryUsage += m_featureIndex->getMemoryUsage();
+        }
+        // Properties of the interactive features
+        if (m_selectionFeatures) {
+            m_memoryUsage += m_selectionFeatures->getMemoryUsage();
+        }
+    }
+
+    size_t usage = m_memoryUsage;
+
+    // Rasters are shared by the tiles of their area and referenced by their
+    // source. The share of this tile changes as tiles come and go, so it is
+    // not cached.
+    for (auto& raster : m_rasters) {
+        if (raster.texture) {
+            long users = std::max(raster.texture.use_count() - 1, 1L);
+            usage += raster.texture->bufferSize() / users;
+        }
     }
 
-    return m_memoryUsage;
+    return usage;
 }
 
 }
@@ -13,9 +13,11 @@
 
 namespace Tangram {
 
+class FeatureIndex;
 class TileSource;
 class MapProjection;
 struct Properties;
+class SelectionFeatures;
 class Style;
 class View;
 struct StyledMesh;
@@ -72,11 +74,16 @@ public:
 
     void setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh);
 
-    void setSelectionFeatures(const fastmap<uint32_t, std::shared_ptr<Properties>> _selectionFeatures);
+    void setSelectionFeatures(std::shared_ptr<SelectionFeatures> _selectionFeatures);
 
     std::shared_ptr<Properties> getSelectionFeature(uint32_t _id);
 
-    const auto& getSelectionFeatures() const { return m_selectionFeatures; }
+    size_t getSelectionFeatureCount() const;
+
+    /* Set the spatial index of the selection features, used for picking when enabled */
+    void setFeatureIndex(std::unique_ptr<FeatureIndex> _featureIndex);
+
+    const FeatureIndex* getFeatureIndex() const { return m_featureIndex.get(); }
 
     auto& rasters() { return m_rasters; }
     const auto& rasters() const { return m_rasters; }
@@ -133,7 +140,10 @@ private:
 
     mutable size_t m_memoryUsage = 0;
 
-    fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
+    // Interactive features, registered in the FeatureSelection of the scene while alive
+    std::shared_ptr<SelectionFeatures> m_selectionFeatures;
+
+    std::unique_ptr<FeatureIndex> m_featureIndex;
 
 };
 
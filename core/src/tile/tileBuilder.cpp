@@ -3,23 +3,33 @@
 #include "data/properties.h"
 #include "data/propertyItem.h"
 #include "data/tileSource.h"
+#include "debug/trace.h"
 #include "gl/mesh.h"
 #include "log.h"
 #include "scene/dataLayer.h"
 #include "scene/scene.h"
+#include "scene/stops.h"
+#include "selection/featureIndex.h"
 #include "selection/featureSelection.h"
 #include "style/style.h"
 #include "tile/tile.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
+// Number of selection colors reserved at once for the interactive features of a tile
+static constexpr uint32_t selection_color_block = 64;
+
 TileBuilder::TileBuilder(std::shared_ptr<Scene> _scene)
     : m_scene(_scene) {
 
     m_styleContext.initFunctions(*_scene);
 
+    m_ruleSet.setZoomParams(&m_zoomParams);
+
     // Initialize StyleBuilders
     for (auto& style : _scene->styles()) {
         m_styleBuilder[style->getName()] = style->createBuilder();
@@ -28,6 +38,20 @@ TileBuilder::TileBuilder(std::shared_ptr<Scene> _scene)
 
 TileBuilder::~TileBuilder() {}
 
+void TileBuilder::updateZoomParams(int _zoom) {
+
+    if (m_zoomParamsZoom == _zoom) { return; }
+    m_zoomParamsZoom = _zoom;
+
+    const auto& params = m_scene->zoomParams();
+    m_zoomParams.resize(params.size());
+
+    for (size_t i = 0; i < params.size(); i++) {
+        m_zoomParams[i] = *params[i];
+        Stops::eval(*params[i]->stops, params[i]->key, _zoom, m_zoomParams[i].value);
+    }
+}
+
 StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     auto it = m_styleBuilder.find(_name);
     if (it == m_styleBuilder.end()) { return nullptr; }
@@ -61,7 +85,11 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
         bool interactive = false;
         if (rule.get(StyleParamKey::interactive, interactive) && interactive) {
             if (selectionColor == 0) {
-                selectionColor = m_scene->featureSelection()->nextColorIdentifier();
+                if (m_nextSelectionColor == m_endSelectionColor) {
+                    m_nextSelectionColor = m_scene->featureSelection()->reserveColors(selection_color_block);
+                    m_endSelectionColor = m_nextSelectionColor + selection_color_block;
+                }
+                selectionColor = m_nextSelectionColor++;
             }
             rule.selectionColor = selectionColor;
             rule.featureSelection = m_scene->featureSelection().get();
@@ -78,7 +106,7 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
                 LOGN("Invalid style %s", styleName.c_str());
             } else {
                 rule.isOutlineOnly = true;
-                outlineStyle->addFeature(_feature, rule);
+                added |= outlineStyle->addFeature(_feature, rule);
                 rule.isOutlineOnly = false;
             }
         }
@@ -87,41 +115,67 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
         added |= style->addFeature(_feature, rule);
     }
 
-    if (added && (selectionColor != 0)) {
-        m_selectionFeatures[selectionColor] = std::make_shared<Properties>(_feature.props);
+    if (selectionColor == 0) { return; }
+
+    if (!added) {
+        // Return the unused color, so that the colors of a tile stay consecutive
+        m_nextSelectionColor--;
+        return;
+    }
+
+    m_selectionFeatures->add(selectionColor, _feature.props);
+
+    if (m_featureIndex) {
+        m_featureIndex->add(_feature, selectionColor);
     }
 }
 
 std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData, const TileSource& _source) {
 
-    m_selectionFeatures.clear();
+    m_nextSelectionColor = 0;
+    m_endSelectionColor = 0;
+    m_selectionFeatures = std::make_shared<SelectionFeatures>();
+
+    if (m_scene->featureIndex) {
+        m_featureIndex = std::make_unique<FeatureIndex>();
+    }
 
     auto tile = std::make_shared<Tile>(_tileID, *m_scene->mapProjection(), &_source);
 
     tile->initGeometry(m_scene->styles().size());
 
     m_styleContext.setKeywordZoom(_tileID.s);
+    updateZoomParams(_tileID.s);
 
     for (auto& builder : m_styleBuilder) {
         if (builder.second)
             builder.second->setup(*tile);
     }
 
-    for (const auto& datalayer : m_scene->layers()) {
+    // Find the scene layers for each collection, then visit them in
+    // scene layer order like iterating over all layers would.
+    m_layerCollections.clear();
+    for (const auto& collection : _tileData.layers) {
+        for (auto* datalayer : m_scene->layerIndex().layers(_source.name(), collection.name)) {
+            m_layerCollections.push_back({ datalayer, &collection });
+        }
+    }
+    std::stable_sort(m_layerCollections.begin(), m_layerCollections.end(),
+                     [](const auto& a, const auto& b) { return a.layer < b.layer; });
 
-        if (datalayer.source() != _source.name()) { continue; }
+    float zoom = _tileID.s;
 
-        for (const auto& collection : _tileData.layers) {
+    {
+        // One span for the styling of all features, which are too many to trace each
+        TraceSpan span("TileBuilder::applyStyling", _tileID);
 
-            if (!collection.name.empty()) {
-                const auto& dlc = datalayer.collections();
-                bool layerContainsCollection =
-                    std::find(dlc.begin(), dlc.end(), collection.name) != dlc.end();
+        for (const auto& entry : m_layerCollections) {
+            const auto& datalayer = *entry.layer;
+            const auto& features = entry.collection->features;
 
-                if (!layerContainsCollection) { continue; }
-            }
+            for (const auto& feat : features) {
+                if (!datalayer.canMatch(feat.geometryType, zoom)) { continue; }
 
-            for (const auto& feat : collection.features) {
                 applyStyling(feat, datalayer);
             }
         }
@@ -140,7 +194,16 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
         tile->setMesh(builder.second->style(), builder.second->build());
     }
 
-    tile->setSelectionFeatures(m_selectionFeatures);
+    if (!m_selectionFeatures->empty()) {
+        m_scene->featureSelection()->addFeatures(m_selectionFeatures);
+        tile->setSelectionFeatures(std::move(m_selectionFeatures));
+    }
+    m_selectionFeatures.reset();
+
+    if (m_featureIndex && !m_featureIndex->empty()) {
+        tile->setFeatureIndex(std::move(m_featureIndex));
+    }
+    m_featureIndex.reset();
 
     return tile;
 }
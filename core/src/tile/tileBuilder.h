@@ -8,10 +8,13 @@
 namespace Tangram {
 
 class DataLayer;
+class FeatureIndex;
+class SelectionFeatures;
 class StyleBuilder;
 class Tile;
 class TileSource;
 struct Feature;
+struct Layer;
 struct Properties;
 struct TileData;
 
@@ -34,16 +37,40 @@ private:
     // Determine and apply DrawRules for a @_feature
     void applyStyling(const Feature& _feature, const SceneLayer& _layer);
 
+    // Evaluate the Stops of Scene::zoomParams for @_zoom
+    void updateZoomParams(int _zoom);
+
     std::shared_ptr<Scene> m_scene;
 
     StyleContext m_styleContext;
     DrawRuleMergeSet m_ruleSet;
 
+    // Scene::zoomParams evaluated at m_zoomParamsZoom
+    std::vector<StyleParam> m_zoomParams;
+    int m_zoomParamsZoom = -1;
+
     LabelCollider m_labelLayout;
 
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
 
-    fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
+    // Selection colors reserved for the current tile, in blocks on demand.
+    // The next interactive feature gets m_nextSelectionColor.
+    uint32_t m_nextSelectionColor = 0;
+    uint32_t m_endSelectionColor = 0;
+
+    // Properties of the interactive features of the current tile
+    std::shared_ptr<SelectionFeatures> m_selectionFeatures;
+
+    // Index of the selection features when Scene::featureIndex is set
+    std::unique_ptr<FeatureIndex> m_featureIndex;
+
+    struct LayerCollection {
+        const DataLayer* layer;
+        const Layer* collection;
+    };
+
+    // Reusable container of the scene layers to apply to each collection of a tile
+    std::vector<LayerCollection> m_layerCollections;
 };
 
 }
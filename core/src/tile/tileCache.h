@@ -32,6 +32,9 @@ class TileCache {
     struct CacheEntry {
         TileCacheKey key;
         std::shared_ptr<Tile> tile;
+        // Memory usage of the tile when it was added; it changes with the
+        // rasters it shares, the cache removes what it added
+        size_t memoryUsage;
     };
 
     using CacheList = std::list<CacheEntry>;
@@ -43,12 +46,14 @@ public:
         m_cacheUsage(0),
         m_cacheMaxUsage(_cacheSizeMB) {}
 
-    std::vector<TileID> put(int32_t _sourceId, std::shared_ptr<Tile> _tile) {
+    // Returns the keys of the tiles evicted to make room for @_tile
+    std::vector<TileCacheKey> put(int32_t _sourceId, std::shared_ptr<Tile> _tile) {
         TileCacheKey k(_sourceId, _tile->getID());
 
-        m_cacheList.push_front({k, _tile});
+        size_t usage = _tile->getMemoryUsage();
+        m_cacheList.push_front({k, _tile, usage});
         m_cacheMap[k] = m_cacheList.begin();
-        m_cacheUsage += _tile->getMemoryUsage();
+        m_cacheUsage += usage;
 
         return limitCacheSize(m_cacheMaxUsage);
     }
@@ -60,9 +65,9 @@ public:
         auto it = m_cacheMap.find(k);
         if (it != m_cacheMap.end()) {
             std::swap(tile, (*(it->second)).tile);
+            m_cacheUsage -= it->second->memoryUsage;
             m_cacheList.erase(it->second);
             m_cacheMap.erase(it);
-            m_cacheUsage -= tile->getMemoryUsage();
         }
         return tile;
     }
@@ -78,8 +83,9 @@ public:
         return nullptr;
     }
 
-    std::vector<TileID> limitCacheSize(size_t _cacheSizeBytes) {
-        std::vector<TileID> poppedTileIDs;
+    // Returns the keys of the evicted tiles
+    std::vector<TileCacheKey> limitCacheSize(size_t _cacheSizeBytes) {
+        std::vector<TileCacheKey> poppedTiles;
         m_cacheMaxUsage = _cacheSizeBytes;
 
         while (m_cacheUsage > m_cacheMaxUsage) {
@@ -88,19 +94,18 @@ public:
                 m_cacheUsage = 0;
                 break;
             }
-            auto& tile = m_cacheList.back().tile;
-            poppedTileIDs.push_back(tile->getID());
-            m_cacheUsage -= tile->getMemoryUsage();
+            poppedTiles.push_back(m_cacheList.back().key);
+            m_cacheUsage -= m_cacheList.back().memoryUsage;
             m_cacheMap.erase(m_cacheList.back().key);
             m_cacheList.pop_back();
         }
-        return poppedTileIDs;
+        return poppedTiles;
     }
 
     size_t getMemoryUsage() const {
         size_t sum = 0;
         for (auto& entry : m_cacheList) {
-            sum += entry.tile->getMemoryUsage();
+            sum += entry.memoryUsage;
         }
         return sum;
     }
@@ -42,6 +42,7 @@ TileManager::~TileManager() {
 void TileManager::setTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources) {
 
     m_tileCache->clear();
+    m_prefetchedTiles.clear();
 
     // remove sources that are not in new scene - there must be a better way..
     auto it = std::remove_if(
@@ -105,6 +106,7 @@ void TileManager::clearTileSets() {
     }
 
     m_tileCache->clear();
+    m_prefetchedTiles.clear();
 }
 
 void TileManager::clearTileSet(int32_t _sourceId) {
@@ -114,22 +116,34 @@ void TileManager::clearTileSet(int32_t _sourceId) {
     }
 
     m_tileCache->clear();
+    m_prefetchedTiles.clear();
     m_tileSetChanged = true;
 }
 
 void TileManager::updateTileSets(const ViewState& _view,
-                                 const std::set<TileID>& _visibleTiles) {
+                                 const std::set<TileID>& _visibleTiles,
+                                 const std::set<TileID>& _prefetchTiles) {
     m_tiles.clear();
     m_tilesInProgress = 0;
     m_tileSetChanged = false;
+    m_maxPriority = 0;
+    m_prefetchStats.loading = 0;
 
     for (auto& tileSet : m_tileSets) {
         // check if tile set is active for zoom (zoom might be below min_zoom)
         if (tileSet.source->isActiveForZoom(_view.zoom)) {
-            updateTileSet(tileSet, _view, _visibleTiles);
+            updateTileSet(tileSet, _view, _visibleTiles, _prefetchTiles);
         }
     }
 
+    // Order prefetch tasks after all visible tiles, also across tile sets
+    // which share their download queue. (Doubled to stay above the visible
+    // tiles after rounding to the float task priority.)
+    for (auto& it : m_prefetchPriorities) {
+        it.first->setPriority(2 * m_maxPriority + it.second);
+    }
+    m_prefetchPriorities.clear();
+
     loadTiles();
 
     // Make m_tiles an unique list of tiles for rendering sorted from
@@ -142,7 +156,8 @@ void TileManager::updateTileSets(const ViewState& _view,
 }
 
 void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
-                                const std::set<TileID>& _visibleTiles) {
+                                const std::set<TileID>& _visibleTiles,
+                                const std::set<TileID>& _prefetchTiles) {
 
     bool newTiles = false;
 
@@ -169,13 +184,15 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             entry.task.reset();
             newTiles = true;
 
-            m_tileSetChanged = true;
+            if (!entry.m_prefetch) { m_tileSetChanged = true; }
         }
     }
 
     const auto* visibleTiles = &_visibleTiles;
+    const auto* prefetchTiles = &_prefetchTiles;
 
     std::set<TileID> mappedTiles;
+    std::set<TileID> mappedPrefetchTiles;
     if (_view.zoom > _tileSet.source->maxZoom()) {
         for (const auto& id : _visibleTiles) {
             auto tile = id.withMaxSourceZoom(_tileSet.source->maxZoom());
@@ -193,14 +210,17 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             }
         }
         visibleTiles = &mappedTiles;
+
+        for (const auto& id : _prefetchTiles) {
+            mappedPrefetchTiles.insert(id.withMaxSourceZoom(_tileSet.source->maxZoom()));
+        }
+        prefetchTiles = &mappedPrefetchTiles;
     }
 
     // Loop over visibleTiles and add any needed tiles to tileSet
     auto curTilesIt = tiles.begin();
     auto visTilesIt = visibleTiles->begin();
 
-    auto generation = _tileSet.source->generation();
-
     while (visTilesIt != visibleTiles->end() || curTilesIt != tiles.end()) {
 
         auto& visTileId = visTilesIt == visibleTiles->end()
@@ -217,11 +237,20 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             auto& entry = curTilesIt->second;
             entry.setVisible(true);
 
+            if (entry.m_prefetch) {
+                entry.m_prefetch = false;
+                m_prefetchStats.hits++;
+
+                if (entry.isLoading()) {
+                    updateProxyTiles(_tileSet, visTileId, entry);
+                }
+            }
+
             if (entry.isReady()) {
                 m_tiles.push_back(entry.tile);
 
                 if (!entry.isLoading() &&
-                    (entry.tile->sourceGeneration() < generation)) {
+                    (entry.tile->sourceGeneration() < _tileSet.source->tileGeneration(visTileId))) {
                     // Tile needs update - enqueue for loading
                     entry.task = _tileSet.source->createTask(visTileId);
                     enqueueTask(_tileSet, visTileId, _view);
@@ -232,7 +261,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
                 m_tilesInProgress++;
 
             } else if (entry.isCanceled() &&
-                       (entry.task->sourceGeneration() < generation)) {
+                       (entry.task->sourceGeneration() < _tileSet.source->tileGeneration(visTileId))) {
                 // Tile needs update - enqueue for loading
                 entry.task = _tileSet.source->createTask(visTileId);
                 enqueueTask(_tileSet, visTileId, _view);
@@ -268,7 +297,9 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
 
             auto& entry = curTilesIt->second;
 
-            if (entry.getProxyCounter() > 0) {
+            if (entry.m_prefetch && !entry.isCanceled() && prefetchTiles->count(curTileId)) {
+                // Keep loading the predicted tile
+            } else if (entry.getProxyCounter() > 0) {
                 if (entry.isReady()) {
                     m_tiles.push_back(entry.tile);
                 } else if (curTileId.z < maxZoom) {
@@ -289,6 +320,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
 
         if ((it != tiles.end()) &&
             (!it->second.isVisible()) &&
+            (!it->second.m_prefetch || !prefetchTiles->count(it->first)) &&
             (it->second.getProxyCounter() <= 0  ||
              it->first.z >= maxZoom)) {
 
@@ -298,6 +330,10 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
         }
     }
 
+    if (!prefetchTiles->empty()) {
+        addPrefetchTiles(_tileSet, _view, *prefetchTiles);
+    }
+
     for (auto& it : tiles) {
         auto& entry = it.second;
 
@@ -330,7 +366,15 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             auto tileCenter = _view.mapProjection->TileCenter(id);
             double scaleDiv = exp2(id.z - _view.zoom);
             if (scaleDiv < 1) { scaleDiv = 0.1/scaleDiv; } // prefer parent tiles
-            task->setPriority(glm::length2(tileCenter - _view.center) * scaleDiv);
+            double priority = glm::length2(tileCenter - _view.center) * scaleDiv;
+
+            if (entry.m_prefetch) {
+                m_prefetchPriorities.emplace_back(task, priority);
+                m_prefetchStats.loading++;
+            } else {
+                task->setPriority(priority);
+                m_maxPriority = std::max(m_maxPriority, priority);
+            }
             task->setProxyState(entry.getProxyCounter() > 0);
         }
 
@@ -356,9 +400,44 @@ void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
     m_loadTasks.insert(it, std::make_tuple(distance, &_tileSet, _tileID));
 }
 
-void TileManager::loadTiles() {
+void TileManager::addPrefetchTiles(TileSet& _tileSet, const ViewState& _view,
+                                   const std::set<TileID>& _prefetchTiles) {
+
+    auto& tiles = _tileSet.tiles;
+
+    uint32_t loading = 0;
+    for (auto& it : tiles) {
+        if (it.second.m_prefetch && it.second.isLoading()) { loading++; }
+    }
+    if (loading >= m_prefetchLimit) { return; }
 
-    if (m_loadTasks.empty()) { return; }
+    // Prefetch the tiles closest to the current view first
+    std::vector<std::pair<double, TileID>> candidates;
+    for (const auto& id : _prefetchTiles) {
+        if (tiles.find(id) != tiles.end()) { continue; }
+        if (m_tileCache->contains(_tileSet.source->id(), id)) { continue; }
+
+        auto tileCenter = _view.mapProjection->TileCenter(id);
+        candidates.emplace_back(glm::length2(tileCenter - _view.center), id);
+    }
+
+    size_t count = std::min<size_t>(candidates.size(), m_prefetchLimit - loading);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](auto& a, auto& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < count; i++) {
+        auto& id = candidates[i].second;
+
+        auto& entry = tiles[id];
+        entry.task = _tileSet.source->createTask(id);
+        entry.m_prefetch = true;
+
+        m_prefetchTasks.emplace_back(candidates[i].first, &_tileSet, id);
+        m_prefetchStats.requested++;
+    }
+}
+
+void TileManager::loadTiles() {
 
     for (auto& loadTask : m_loadTasks) {
 
@@ -370,11 +449,22 @@ void TileManager::loadTiles() {
         tileSet.source->loadTileData(entry.task, m_dataCallback);
     }
 
-    DBG("loading:%d pending:%d cache: %fMB",
-        m_loadTasks.size(), m_loadPending,
+    for (auto& loadTask : m_prefetchTasks) {
+
+        auto tileId = std::get<2>(loadTask);
+        auto& tileSet = *std::get<1>(loadTask);
+        auto tileIt = tileSet.tiles.find(tileId);
+        if (tileIt == tileSet.tiles.end() || !tileIt->second.task) { continue; }
+
+        tileSet.source->loadTileData(tileIt->second.task, m_dataCallback);
+    }
+
+    DBG("loading:%d prefetch:%d cache: %fMB",
+        m_loadTasks.size(), m_prefetchTasks.size(),
         (double(m_tileCache->getMemoryUsage()) / (1024 * 1024)));
 
     m_loadTasks.clear();
+    m_prefetchTasks.clear();
 }
 
 bool TileManager::addTile(TileSet& _tileSet, const TileID& _tileID) {
@@ -382,7 +472,11 @@ bool TileManager::addTile(TileSet& _tileSet, const TileID& _tileID) {
     auto tile = m_tileCache->get(_tileSet.source->id(), _tileID);
 
     if (tile) {
-        if (tile->sourceGeneration() == _tileSet.source->generation()) {
+        if (m_prefetchedTiles.erase({ _tileSet.source->id(), _tileID }) > 0) {
+            m_prefetchStats.hits++;
+        }
+
+        if (tile->sourceGeneration() >= _tileSet.source->tileGeneration(_tileID)) {
             m_tiles.push_back(tile);
 
             // Update tile origin based on wrap (set in the new tileID)
@@ -424,12 +518,16 @@ void TileManager::removeTile(TileSet& _tileSet, std::map<TileID, TileEntry>::ite
         //  the network request associated with this tile.
         _tileSet.source->cancelLoadingTile(id);
 
+        if (entry.m_prefetch) { m_prefetchStats.wasted++; }
+
     } else if (entry.isReady()) {
-        // Add to cache
-        auto poppedTiles = m_tileCache->put(_tileSet.source->id(), entry.tile);
-        for (auto& tileID : poppedTiles) {
-            _tileSet.source->clearRaster(tileID);
+        // Count as hit or waste when the tile is taken from or evicted from the cache
+        if (entry.m_prefetch) {
+            m_prefetchedTiles.insert({ _tileSet.source->id(), id });
         }
+
+        // Add to cache
+        evictedTiles(m_tileCache->put(_tileSet.source->id(), entry.tile));
     }
 
     // Remove rasters from this TileSource
@@ -439,6 +537,23 @@ void TileManager::removeTile(TileSet& _tileSet, std::map<TileID, TileEntry>::ite
     _tileIt = _tileSet.tiles.erase(_tileIt);
 }
 
+void TileManager::evictedTiles(const std::vector<std::pair<int32_t, TileID>>& _evicted) {
+
+    // The cache is shared by all tile sets, evicted tiles may be of any source
+    for (auto& key : _evicted) {
+        for (auto& tileSet : m_tileSets) {
+            if (tileSet.source->id() == key.first) {
+                tileSet.source->clearRaster(key.second);
+                break;
+            }
+        }
+
+        if (m_prefetchedTiles.erase(key) > 0) {
+            m_prefetchStats.wasted++;
+        }
+    }
+}
+
 bool TileManager::updateProxyTile(TileSet& _tileSet, TileEntry& _tile,
                                   const TileID& _proxyTileId,
                                   const ProxyID _proxyId) {
@@ -547,7 +662,7 @@ void TileManager::clearProxyTiles(TileSet& _tileSet, const TileID& _tileID, Tile
 }
 
 void TileManager::setCacheSize(size_t _cacheSize) {
-    m_tileCache->limitCacheSize(_cacheSize);
+    evictedTiles(m_tileCache->limitCacheSize(_cacheSize));
 }
 
 }
@@ -41,8 +41,23 @@ public:
     /* Sets the tile TileSources */
     void setTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources);
 
-    /* Updates visible tile set and load missing tiles */
-    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles);
+    struct PrefetchStats {
+        // Prefetch loads started
+        uint64_t requested = 0;
+        // Prefetched tiles which became visible
+        uint64_t hits = 0;
+        // Prefetched tiles which were dropped or evicted before they became visible
+        uint64_t wasted = 0;
+        // Prefetch loads in progress
+        uint32_t loading = 0;
+    };
+
+    /* Updates visible tile set and load missing tiles
+     * @_prefetchTiles: Tiles expected to become visible soon. These are loaded
+     * after the visible tiles, with lower priority and within the prefetch limit.
+     */
+    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles,
+                        const std::set<TileID>& _prefetchTiles = {});
 
     void clearTileSets();
 
@@ -68,6 +83,11 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* @_limit: Maximum number of prefetch loads in progress */
+    void setPrefetchLimit(uint32_t _limit) { m_prefetchLimit = _limit; }
+
+    const PrefetchStats& prefetchStats() const { return m_prefetchStats; }
+
 private:
 
     enum class ProxyID : uint8_t {
@@ -175,6 +195,9 @@ private:
 
         bool m_visible = false;
 
+        /* Whether the tile was loaded by prefetch and did not become visible yet */
+        bool m_prefetch = false;
+
         /* Method to check whther this tile is in the current set of visible tiles
          * determined by view::updateTiles().
          */
@@ -197,7 +220,13 @@ private:
         bool clientTileSource;
     };
 
-    void updateTileSet(TileSet& tileSet, const ViewState& _view, const std::set<TileID>& _visibleTiles);
+    void updateTileSet(TileSet& tileSet, const ViewState& _view, const std::set<TileID>& _visibleTiles,
+                       const std::set<TileID>& _prefetchTiles);
+
+    /*
+     * Adds entries for predicted tiles and enqueues them for loading within the prefetch limit
+     */
+    void addPrefetchTiles(TileSet& _tileSet, const ViewState& _view, const std::set<TileID>& _prefetchTiles);
 
     void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
 
@@ -215,6 +244,13 @@ private:
      */
     void removeTile(TileSet& _tileSet, std::map<TileID, TileEntry>::iterator& _tileIter);
 
+    /*
+     * Releases the rasters of tiles evicted from m_tileCache and counts
+     * evicted prefetched tiles as wasted
+     * @_evicted: source id and TileID of each evicted tile
+     */
+    void evictedTiles(const std::vector<std::pair<int32_t, TileID>>& _evicted);
+
     /*
      * Checks and updates m_tileSet with proxy tiles for every new visible tile
      *  @_tile: Tile, the new visible tile for which proxies needs to be added
@@ -249,6 +285,19 @@ private:
     /* Temporary list of tiles that need to be loaded */
     std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
 
+    /* Temporary list of prefetch tiles, loaded after m_loadTasks */
+    std::vector<std::tuple<double, TileSet*, TileID>> m_prefetchTasks;
+
+    /* Loading prefetch tasks and their priority relative to the visible tiles */
+    std::vector<std::pair<std::shared_ptr<TileTask>, double>> m_prefetchPriorities;
+    double m_maxPriority = 0;
+
+    /* Prefetched tiles moved to the cache before they became visible */
+    std::set<std::pair<int32_t, TileID>> m_prefetchedTiles;
+
+    uint32_t m_prefetchLimit = 4;
+    PrefetchStats m_prefetchStats;
+
 };
 
 }
@@ -0,0 +1,101 @@
+#include "tile/tilePrefetcher.h"
+
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include "glm/geometric.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace Tangram {
+
+// Smoothing factor of the velocity estimate
+const float velocityAlpha = 0.5f;
+
+// Minimal predicted motion, relative to the tile size, to prefetch tiles
+const double minTileMotion = 0.25;
+const float minZoomMotion = 0.1f;
+
+void TilePrefetcher::easePosition(glm::dvec2 _position, float _remaining) {
+    m_positionEase.active = true;
+    m_positionEase.remaining = _remaining;
+    m_positionTarget = _position;
+}
+
+void TilePrefetcher::easeZoom(float _zoom, float _remaining) {
+    m_zoomEase.active = true;
+    m_zoomEase.remaining = _remaining;
+    m_zoomTarget = _zoom;
+}
+
+void TilePrefetcher::reset() {
+    m_hasState = false;
+    m_positionEase = {};
+    m_zoomEase = {};
+    m_tiles.clear();
+}
+
+void TilePrefetcher::update(const View& _view, float _dt) {
+
+    glm::dvec2 position(_view.getPosition());
+    float zoom = _view.getZoom();
+
+    if (m_hasState && _dt > 0) {
+        glm::dvec2 velocity = (position - m_position) / double(_dt);
+        float zoomVelocity = (zoom - m_zoom) / _dt;
+
+        m_velocity += double(velocityAlpha) * (velocity - m_velocity);
+        m_zoomVelocity += velocityAlpha * (zoomVelocity - m_zoomVelocity);
+        m_frameTime += velocityAlpha * (_dt - m_frameTime);
+    } else {
+        m_velocity = glm::dvec2(0);
+        m_zoomVelocity = 0;
+    }
+    m_position = position;
+    m_zoom = zoom;
+    m_hasState = true;
+
+    float lookahead = m_frames * m_frameTime;
+
+    // Predict the view 'lookahead' seconds ahead: along the ease when the
+    // view is eased, otherwise by its current velocity
+    glm::dvec2 predictedPosition;
+    if (m_positionEase.active) {
+        double f = m_positionEase.remaining > lookahead ? lookahead / m_positionEase.remaining : 1.0;
+        predictedPosition = position + (m_positionTarget - position) * f;
+    } else {
+        predictedPosition = position + m_velocity * double(lookahead);
+    }
+
+    float predictedZoom;
+    if (m_zoomEase.active) {
+        float f = m_zoomEase.remaining > lookahead ? lookahead / m_zoomEase.remaining : 1.f;
+        predictedZoom = zoom + (m_zoomTarget - zoom) * f;
+    } else {
+        predictedZoom = zoom + m_zoomVelocity * lookahead;
+    }
+
+    m_positionEase = {};
+    m_zoomEase = {};
+    m_tiles.clear();
+
+    double tileSize = 2 * MapProjection::HALF_CIRCUMFERENCE * std::exp2(-zoom);
+    if (glm::length(predictedPosition - position) < minTileMotion * tileSize &&
+        std::abs(predictedZoom - zoom) < minZoomMotion) {
+        return;
+    }
+
+    View predicted(_view);
+    predicted.setPosition(predictedPosition);
+    predicted.setZoom(predictedZoom);
+    predicted.update();
+
+    const auto& visible = _view.getVisibleTiles();
+
+    std::set_difference(predicted.getVisibleTiles().begin(), predicted.getVisibleTiles().end(),
+                        visible.begin(), visible.end(),
+                        std::inserter(m_tiles, m_tiles.end()));
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "tile/tileID.h"
+
+#include "glm/vec2.hpp"
+#include <set>
+
+namespace Tangram {
+
+class View;
+
+/*
+ * Predicts the tiles that become visible during view motion
+ *
+ * The view velocity is estimated from successive updates; while the view is
+ * eased towards a target the ease target is used instead. The predicted view
+ * 'frames' frames ahead yields the set of tiles which are not visible yet but
+ * will be soon. These are passed to TileManager::updateTileSets to be loaded
+ * ahead of time.
+ */
+class TilePrefetcher {
+
+public:
+
+    // Number of frames to look ahead
+    void setFrames(uint32_t _frames) { m_frames = _frames; }
+    uint32_t frames() const { return m_frames; }
+
+    // The view is eased to @_position (in meters) for @_remaining seconds.
+    // Valid for the next call of update().
+    void easePosition(glm::dvec2 _position, float _remaining);
+
+    // The view is eased to @_zoom for @_remaining seconds.
+    // Valid for the next call of update().
+    void easeZoom(float _zoom, float _remaining);
+
+    // Update the motion estimate with @_view after @_dt seconds and predict
+    // the tiles that will become visible
+    void update(const View& _view, float _dt);
+
+    // Predicted tiles that are not in the currently visible set
+    const std::set<TileID>& tiles() const { return m_tiles; }
+
+    void reset();
+
+private:
+
+    struct EaseTarget {
+        bool active = false;
+        float remaining = 0;
+    };
+
+    uint32_t m_frames = 15;
+
+    EaseTarget m_positionEase;
+    glm::dvec2 m_positionTarget;
+
+    EaseTarget m_zoomEase;
+    float m_zoomTarget = 0;
+
+    // Previous view state and smoothed velocities per second
+    bool m_hasState = false;
+    glm::dvec2 m_position;
+    float m_zoom = 0;
+    glm::dvec2 m_velocity;
+    float m_zoomVelocity = 0;
+    float m_frameTime = 1.f / 60.f;
+
+    std::set<TileID> m_tiles;
+};
+
+}
@@ -1,6 +1,7 @@
 #include "tile/tileTask.h"
 
 #include "data/tileSource.h"
+#include "debug/trace.h"
 #include "scene/scene.h"
 #include "tile/tile.h"
 #include "tile/tileBuilder.h"
@@ -17,7 +18,9 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<TileSource> _source, int _su
 
 void TileTask::process(TileBuilder& _tileBuilder) {
 
-    auto tileData = m_source->parse(*this, *_tileBuilder.scene().mapProjection());
+    TraceSpan span("TileTask::process", m_tileId);
+
+    auto tileData = m_source->parseTile(*this, *_tileBuilder.scene().mapProjection());
 
     if (tileData) {
         m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source);
@@ -89,6 +89,11 @@ Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_
         feature.props = getProperties(properties->value, _sourceId);
     }
 
+    auto id = _in.FindMember("id");
+    if (id != _in.MemberEnd() && id->value.IsUint64()) {
+        feature.props.featureId = id->value.GetUint64();
+    }
+
     // Copy geometry into tile data
     const JsonValue& geometry = _in["geometry"];
     const JsonValue& coords = geometry["coordinates"];
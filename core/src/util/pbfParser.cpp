@@ -95,8 +95,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
     while(_featureIn.next()) {
         switch(_featureIn.tag) {
             case FEATURE_ID:
-                // ignored for now, also not used in json parsing
-                _featureIn.skip();
+                feature.props.featureId = _featureIn.varint();
                 break;
 
             case FEATURE_TAGS: {
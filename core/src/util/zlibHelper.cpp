@@ -2,32 +2,67 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <assert.h>
 
-#define CHUNK 16384
-
 namespace Tangram {
 namespace zlib {
 
+// Initial size estimate for data without size trailer
+#define ESTIMATED_RATIO 4
+// Upper bound of the deflate compression ratio, used to reject bogus trailers
+#define MAX_RATIO 1032
+
+bool isGzip(const char* _data, size_t _size) {
+    return _size >= 18 &&
+        (unsigned char)_data[0] == 0x1f &&
+        (unsigned char)_data[1] == 0x8b;
+}
+
+size_t inflatedSize(const char* _data, size_t _size) {
+
+    if (isGzip(_data, _size)) {
+        // ISIZE: the uncompressed size modulo 2^32, little endian
+        auto* trailer = reinterpret_cast<const unsigned char*>(_data + _size - 4);
+        size_t size = size_t(trailer[0]) |
+            size_t(trailer[1]) << 8 |
+            size_t(trailer[2]) << 16 |
+            size_t(trailer[3]) << 24;
+
+        if (size <= _size * MAX_RATIO) { return size; }
+    }
+    return _size * ESTIMATED_RATIO;
+}
+
 int inflate(const char* _data, size_t _size, std::vector<char>& dst) {
 
     int ret;
-    unsigned char out[CHUNK];
 
     z_stream strm;
     memset(&strm, 0, sizeof(z_stream));
 
-    ret = inflateInit2(&strm, 16+MAX_WBITS);
+    // Detect gzip or zlib header
+    ret = inflateInit2(&strm, 32+MAX_WBITS);
     if (ret != Z_OK) { return ret; }
 
     strm.avail_in = _size;
     strm.next_in = (Bytef*)_data;
 
+    size_t offset = dst.size();
+    size_t have = 0;
+    // One spare byte lets zlib read the trailer without running out of output
+    dst.resize(offset + inflatedSize(_data, _size) + 1);
+
     do {
-        strm.avail_out = CHUNK;
-        strm.next_out = out;
+        if (offset + have == dst.size()) {
+            // Short estimate or trailer, grow geometrically
+            dst.resize(dst.size() + std::max(dst.size() - offset, _size));
+        }
+        strm.next_out = (Bytef*)(dst.data() + offset + have);
+        strm.avail_out = dst.size() - offset - have;
 
-        ret = inflate(&strm, Z_NO_FLUSH);
+        size_t avail = strm.avail_out;
+        ret = ::inflate(&strm, Z_NO_FLUSH);
 
          /* state not clobbered */
         assert(ret != Z_STREAM_ERROR);
@@ -39,17 +74,23 @@ int inflate(const char* _data, size_t _size, std::vector<char>& dst) {
         case Z_DATA_ERROR:
         case Z_MEM_ERROR:
             inflateEnd(&strm);
+            dst.resize(offset);
             return ret;
         }
 
-        size_t have = CHUNK - strm.avail_out;
-        dst.insert(dst.end(), out, out+have);
+        have += avail - strm.avail_out;
 
-    } while (ret == Z_OK);
+        // Z_BUF_ERROR: truncated input
+    } while (ret == Z_OK && (strm.avail_out == 0 || strm.avail_in > 0));
 
     inflateEnd(&strm);
 
-    return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
+    dst.resize(offset + have);
+    if (ret != Z_STREAM_END) {
+        dst.resize(offset);
+        return Z_DATA_ERROR;
+    }
+    return Z_OK;
 }
 
 }
@@ -6,6 +6,17 @@
 namespace Tangram {
 namespace zlib {
 
+// Whether @_data starts with the gzip magic bytes
+bool isGzip(const char* _data, size_t _size);
+
+// Expected size of the inflated @_data: the ISIZE trailer of gzip data,
+// otherwise an estimate from the compressed size
+size_t inflatedSize(const char* _data, size_t _size);
+
+// Inflate gzip or zlib compressed @_data and append the result to @dst.
+// @dst is grown once by inflatedSize() and the data is inflated in place,
+// so that gzip data is decoded without intermediate copies or reallocations.
+// Returns Z_OK on success.
 int inflate(const char* _data, size_t _size, std::vector<char>& dst);
 
 }
@@ -14,11 +14,13 @@
 
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
+#include "platform_gl.h"
 #include <dlfcn.h> // dlopen, dlsym
 
 #include <android/log.h>
 #include <android/asset_manager_jni.h>
 #include <cstdarg>
+#include <cstring>
 
 #include <libgen.h>
 #include <unistd.h>
@@ -29,6 +31,7 @@
 #include <regex>
 
 #include "log.h"
+#include "gl/hardware.h"
 
 /* Followed the following document for JavaVM tips when used with native threads
  * http://android.wooyd.org/JNIExample/#NWD1sCYeT-I
@@ -65,6 +68,16 @@ static bool glExtensionsLoaded = false;
 PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT = 0;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT = 0;
+PFNGLGENQUERIESEXTPROC glGenQueriesEXTEXT = 0;
+PFNGLDELETEQUERIESEXTPROC glDeleteQueriesEXTEXT = 0;
+PFNGLBEGINQUERYEXTPROC glBeginQueryEXTEXT = 0;
+PFNGLENDQUERYEXTPROC glEndQueryEXTEXT = 0;
+PFNGLGETQUERYOBJECTUIVEXTPROC glGetQueryObjectuivEXTEXT = 0;
+PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64vEXTEXT = 0;
+PFNGLMAPBUFFERRANGEES3PROC glMapBufferRangeES3 = 0;
+PFNGLFENCESYNCES3PROC glFenceSyncES3 = 0;
+PFNGLCLIENTWAITSYNCES3PROC glClientWaitSyncES3 = 0;
+PFNGLDELETESYNCES3PROC glDeleteSyncES3 = 0;
 
 // Android assets are distinguished from file paths by the "asset" scheme.
 static const char* aaPrefix = "asset:///";
@@ -437,6 +450,31 @@ void initGLExtensions() {
     glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
     glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
 
+    if (Tangram::Hardware::isAvailable("disjoint_timer_query")) {
+        glGenQueriesEXTEXT = (PFNGLGENQUERIESEXTPROC) dlsym(libhandle, "glGenQueriesEXT");
+        glDeleteQueriesEXTEXT = (PFNGLDELETEQUERIESEXTPROC) dlsym(libhandle, "glDeleteQueriesEXT");
+        glBeginQueryEXTEXT = (PFNGLBEGINQUERYEXTPROC) dlsym(libhandle, "glBeginQueryEXT");
+        glEndQueryEXTEXT = (PFNGLENDQUERYEXTPROC) dlsym(libhandle, "glEndQueryEXT");
+        glGetQueryObjectuivEXTEXT = (PFNGLGETQUERYOBJECTUIVEXTPROC) dlsym(libhandle, "glGetQueryObjectuivEXT");
+        glGetQueryObjectui64vEXTEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC) dlsym(libhandle, "glGetQueryObjectui64vEXT");
+
+        Tangram::Hardware::supportsTimerQuery = glGenQueriesEXTEXT && glDeleteQueriesEXTEXT &&
+            glBeginQueryEXTEXT && glEndQueryEXTEXT && glGetQueryObjectuivEXTEXT && glGetQueryObjectui64vEXTEXT;
+    }
+
+    // Pixel buffer objects and sync objects are core in OpenGL ES 3, drivers
+    // commonly create ES 3 contexts for the requested ES 2
+    auto version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (version && strstr(version, "OpenGL ES 3")) {
+        glMapBufferRangeES3 = (PFNGLMAPBUFFERRANGEES3PROC) dlsym(libhandle, "glMapBufferRange");
+        glFenceSyncES3 = (PFNGLFENCESYNCES3PROC) dlsym(libhandle, "glFenceSync");
+        glClientWaitSyncES3 = (PFNGLCLIENTWAITSYNCES3PROC) dlsym(libhandle, "glClientWaitSync");
+        glDeleteSyncES3 = (PFNGLDELETESYNCES3PROC) dlsym(libhandle, "glDeleteSync");
+
+        Tangram::Hardware::supportsPixelBufferObjects = glMapBufferRangeES3 && glFenceSyncES3 &&
+            glClientWaitSyncES3 && glDeleteSyncES3;
+    }
+
     glExtensionsLoaded = true;
 }
 
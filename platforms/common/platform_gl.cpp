@@ -25,6 +25,10 @@ void GL::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
     GL_CHECK(glViewport(x, y, width, height));
 }
 
+void GL::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GL_CHECK(glScissor(x, y, width, height));
+}
+
 void GL::enable(GLenum id) {
     GL_CHECK(glEnable(id));
 }
@@ -272,6 +276,80 @@ GLboolean GL::unmapBuffer(GLenum target) {
     return result;
 }
 
+// Pixel buffer objects and sync objects are only used where Hardware::supportsPixelBufferObjects
+// is set; Android loads the OpenGL ES 3 entry points in initGLExtensions(), iOS links them
+// and only enables them for OpenGL ES 3 contexts.
+void* GL::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID) || defined(PLATFORM_IOS)
+    auto result = glMapBufferRange(target, offset, length, access);
+    GL_CHECK();
+    return result;
+#else
+    return nullptr;
+#endif
+}
+
+GLsync GL::fenceSync(GLenum condition, GLbitfield flags) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID) || defined(PLATFORM_IOS)
+    auto result = glFenceSync(condition, flags);
+    GL_CHECK();
+    return result;
+#else
+    return nullptr;
+#endif
+}
+GLenum GL::clientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID) || defined(PLATFORM_IOS)
+    auto result = glClientWaitSync(sync, flags, timeout);
+    GL_CHECK();
+    return result;
+#else
+    return GL_WAIT_FAILED;
+#endif
+}
+void GL::deleteSync(GLsync sync) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID) || defined(PLATFORM_IOS)
+    GL_CHECK(glDeleteSync(sync));
+#endif
+}
+
+// Timer queries are only used where Hardware::supportsTimerQuery is set; Android loads the
+// entry points of EXT_disjoint_timer_query in initGLExtensions().
+void GL::genQueries(GLsizei n, GLuint *ids) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glGenQueries(n, ids));
+#endif
+}
+void GL::deleteQueries(GLsizei n, const GLuint *ids) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glDeleteQueries(n, ids));
+#endif
+}
+void GL::beginQuery(GLenum target, GLuint id) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glBeginQuery(target, id));
+#endif
+}
+void GL::endQuery(GLenum target) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glEndQuery(target));
+#endif
+}
+void GL::getQueryObjectuiv(GLuint id, GLenum pname, GLuint *params) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glGetQueryObjectuiv(id, pname, params));
+#else
+    *params = 0;
+#endif
+}
+void GL::getQueryObjectui64v(GLuint id, GLenum pname, uint64_t *params) {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_ANDROID)
+    GL_CHECK(glGetQueryObjectui64v(id, pname, reinterpret_cast<GLuint64*>(params)));
+#else
+    *params = 0;
+#endif
+}
+
 void GL::finish(void) {
     GL_CHECK(glFinish());
 }
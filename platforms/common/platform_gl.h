@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #ifdef PLATFORM_ANDROID
 #include <GLES2/gl2platform.h>
 
@@ -17,6 +19,38 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysOESEXT
 #define glGenVertexArrays glGenVertexArraysOESEXT
 #define glBindVertexArray glBindVertexArrayOESEXT
+
+// EXT_disjoint_timer_query, null when not supported
+extern PFNGLGENQUERIESEXTPROC glGenQueriesEXTEXT;
+extern PFNGLDELETEQUERIESEXTPROC glDeleteQueriesEXTEXT;
+extern PFNGLBEGINQUERYEXTPROC glBeginQueryEXTEXT;
+extern PFNGLENDQUERYEXTPROC glEndQueryEXTEXT;
+extern PFNGLGETQUERYOBJECTUIVEXTPROC glGetQueryObjectuivEXTEXT;
+extern PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64vEXTEXT;
+
+#define glGenQueries glGenQueriesEXTEXT
+#define glDeleteQueries glDeleteQueriesEXTEXT
+#define glBeginQuery glBeginQueryEXTEXT
+#define glEndQuery glEndQueryEXTEXT
+#define glGetQueryObjectuiv glGetQueryObjectuivEXTEXT
+#define glGetQueryObjectui64v glGetQueryObjectui64vEXTEXT
+
+// OpenGL ES 3 pixel buffer reads and sync objects, null when the context is not ES 3
+typedef struct __GLsync *GLsync;
+typedef void* (GL_APIENTRYP PFNGLMAPBUFFERRANGEES3PROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLsync (GL_APIENTRYP PFNGLFENCESYNCES3PROC) (GLenum condition, GLbitfield flags);
+typedef GLenum (GL_APIENTRYP PFNGLCLIENTWAITSYNCES3PROC) (GLsync sync, GLbitfield flags, uint64_t timeout);
+typedef void (GL_APIENTRYP PFNGLDELETESYNCES3PROC) (GLsync sync);
+
+extern PFNGLMAPBUFFERRANGEES3PROC glMapBufferRangeES3;
+extern PFNGLFENCESYNCES3PROC glFenceSyncES3;
+extern PFNGLCLIENTWAITSYNCES3PROC glClientWaitSyncES3;
+extern PFNGLDELETESYNCES3PROC glDeleteSyncES3;
+
+#define glMapBufferRange glMapBufferRangeES3
+#define glFenceSync glFenceSyncES3
+#define glClientWaitSync glClientWaitSyncES3
+#define glDeleteSync glDeleteSyncES3
 #endif
 
 #ifdef PLATFORM_IOS
@@ -25,6 +59,14 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysOES
 #define glGenVertexArrays glGenVertexArraysOES
 #define glBindVertexArray glBindVertexArrayOES
+// OpenGL ES 3 pixel buffer reads and sync objects, which the ES2 headers do not declare;
+// only called with OpenGL ES 3 contexts
+extern "C" {
+GL_API GLvoid* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+GL_API GLsync glFenceSync(GLenum condition, GLbitfield flags);
+GL_API GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+GL_API GLvoid glDeleteSync(GLsync sync);
+}
 #endif
 
 #ifdef PLATFORM_OSX
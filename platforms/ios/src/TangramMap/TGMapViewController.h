@@ -323,6 +323,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (assign, nonatomic) BOOL continuous;
 
+/**
+ If asynchronous picking is set to `true`, feature, label and marker picks read the selection
+ buffer through pixel buffers, without stalling the render thread until the read completes.
+
+ @note This requires an OpenGL ES 3 context, which the map view only creates when this is set
+ before its view is loaded. Otherwise picks are read synchronously.
+ */
+@property (assign, nonatomic) BOOL asyncPicking;
+
 #pragma mark Delegates
 
 /// Assign a gesture recognizer delegate, may be `nil`, see `TGRecognizerDelegate` for more details
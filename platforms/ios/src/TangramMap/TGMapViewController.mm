@@ -735,7 +735,13 @@ __CG_STATIC_ASSERT(sizeof(TGGeoPoint) == sizeof(Tangram::LngLat));
 {
     [super viewDidLoad];
 
-    self.context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES2];
+    // Asynchronous picking reads pixel buffers, which need OpenGL ES 3
+    if (self.asyncPicking) {
+        self.context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    }
+    if (!self.context) {
+        self.context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES2];
+    }
     if (!self.context) {
         NSLog(@"Failed to create ES context");
     }
@@ -833,6 +839,15 @@ __CG_STATIC_ASSERT(sizeof(TGGeoPoint) == sizeof(Tangram::LngLat));
     self.paused = !c;
 }
 
+- (void)setAsyncPicking:(BOOL)asyncPicking
+{
+    _asyncPicking = asyncPicking;
+
+    if (!self.map) { return; }
+
+    self.map->useAsyncPicking(asyncPicking);
+}
+
 - (void)update
 {
     bool viewComplete = self.map->update([self timeSinceLastUpdate]);
@@ -13,6 +13,7 @@
 #import "TGHttpHandler.h"
 #import "platform_ios.h"
 #import "log.h"
+#import "gl/hardware.h"
 
 void logMsg(const char* fmt, ...) {
     va_list args;
@@ -26,7 +27,13 @@ void setCurrentThreadPriority(int priority) {
 }
 
 void initGLExtensions() {
-    // No-op
+    // Pixel buffer objects, sync objects and vertex array objects are core in
+    // OpenGL ES 3, whose contexts need not list them as extensions
+    EAGLContext* context = [EAGLContext currentContext];
+    if (context && context.API >= kEAGLRenderingAPIOpenGLES3) {
+        Tangram::Hardware::supportsPixelBufferObjects = true;
+        Tangram::Hardware::supportsVAOs = true;
+    }
 }
 
 NSString* resolvePath(const char* _path) {
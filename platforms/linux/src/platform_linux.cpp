@@ -86,6 +86,9 @@ void setCurrentThreadPriority(int priority) {
 void initGLExtensions() {
 #if defined(PLATFORM_LINUX)
     Tangram::Hardware::supportsMapBuffer = true;
+    Tangram::Hardware::supportsPixelBufferObjects =
+        Tangram::Hardware::isAvailable("pixel_buffer_object") && Tangram::Hardware::isAvailable("ARB_sync");
+    Tangram::Hardware::supportsTimerQuery = Tangram::Hardware::isAvailable("timer_query");
 #elif defined(PLATFORM_RPI)
     // no-op
 #endif
@@ -21,6 +21,9 @@ void GL::lineWidth(GLfloat width) {
 void GL::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
     __evas_gl_glapi->glViewport(x, y, width, height);
 }
+void GL::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    __evas_gl_glapi->glScissor(x, y, width, height);
+}
 
 void GL::enable(GLenum id) {
     __evas_gl_glapi->glEnable(id);
@@ -256,6 +259,30 @@ void* GL::mapBuffer(GLenum target, GLenum access) {
 GLboolean GL::unmapBuffer(GLenum target) {
     return __evas_gl_glapi->glUnmapBufferOES(target);
 }
+void* GL::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    return nullptr;
+}
+
+// sync objects, not supported with GLES2
+GLsync GL::fenceSync(GLenum condition, GLbitfield flags) {
+    return nullptr;
+}
+GLenum GL::clientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout) {
+    return GL_WAIT_FAILED;
+}
+void GL::deleteSync(GLsync sync) {}
+
+// timer queries, not supported with GLES2
+void GL::genQueries(GLsizei n, GLuint *ids) {}
+void GL::deleteQueries(GLsizei n, const GLuint *ids) {}
+void GL::beginQuery(GLenum target, GLuint id) {}
+void GL::endQuery(GLenum target) {}
+void GL::getQueryObjectuiv(GLuint id, GLenum pname, GLuint *params) {
+    *params = 0;
+}
+void GL::getQueryObjectui64v(GLuint id, GLenum pname, uint64_t *params) {
+    *params = 0;
+}
 
 void GL::finish(void) {
     __evas_gl_glapi->glFinish();
@@ -1,226 +1,400 @@
+#include "gl_mock.h"
+
 #include "gl.h"
 
+#include <vector>
+
 namespace Tangram {
 
+// Calls since the last reset
+static uint64_t s_calls = 0;
+// Last generated object name
+static GLuint s_names = 0;
+// Whether to act like a driver that accepts everything
+static bool s_acceptAll = false;
+
+namespace GLMock {
+
+uint64_t calls() { return s_calls; }
+
+void resetCalls() { s_calls = 0; }
+
+void setAcceptAll(bool _acceptAll) { s_acceptAll = _acceptAll; }
+
+}
+
+// Generate @_n object names when accepting everything
+static void genNames(GLsizei _n, GLuint* _names) {
+    if (!s_acceptAll) { return; }
+    for (GLsizei i = 0; i < _n; i++) { _names[i] = ++s_names; }
+}
+
 GLenum GL::getError() {
+    s_calls++;
     return 0;
 }
 
 const GLubyte* GL::getString(GLenum name) {
+    s_calls++;
     return nullptr;
 }
 
 void GL::clear(GLbitfield mask) {
+    s_calls++;
 }
 void GL::lineWidth(GLfloat width) {
+    s_calls++;
 }
 void GL::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    s_calls++;
+}
+void GL::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    s_calls++;
 }
 
 void GL::enable(GLenum id) {
+    s_calls++;
 }
 void GL::disable(GLenum id) {
+    s_calls++;
 }
 void GL::depthFunc(GLenum func) {
+    s_calls++;
 }
 void GL::depthMask(GLboolean flag) {
+    s_calls++;
 }
 void GL::depthRange(GLfloat n, GLfloat f) {
+    s_calls++;
 }
 void GL::clearDepth(GLfloat d) {
+    s_calls++;
 }
 void GL::blendFunc(GLenum sfactor, GLenum dfactor) {
+    s_calls++;
 }
 void GL::stencilFunc(GLenum func, GLint ref, GLuint mask) {
+    s_calls++;
 }
 void GL::stencilMask(GLuint mask) {
+    s_calls++;
 }
 void GL::stencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+    s_calls++;
 }
 void GL::clearStencil(GLint s) {
+    s_calls++;
 }
 void GL::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    s_calls++;
 }
 void GL::cullFace(GLenum mode) {
+    s_calls++;
 }
 void GL::frontFace(GLenum mode) {
+    s_calls++;
 }
 void GL::clearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+    s_calls++;
 }
 void GL::getIntegerv(GLenum pname, GLint *params ) {
+    s_calls++;
+    if (!s_acceptAll) { return; }
+    switch (pname) {
+    case GL_MAX_TEXTURE_SIZE: *params = 4096; break;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: *params = 16; break;
+    default: *params = 0;
+    }
 }
 
 // Program
 void GL::useProgram(GLuint program) {
+    s_calls++;
 }
 void GL::deleteProgram(GLuint program) {
+    s_calls++;
 }
 void GL::deleteShader(GLuint shader) {
+    s_calls++;
 }
 GLuint GL::createShader(GLenum type) {
-    return 0;
+    s_calls++;
+    return s_acceptAll ? ++s_names : 0;
 }
 GLuint GL::createProgram() {
-    return 0;
+    s_calls++;
+    return s_acceptAll ? ++s_names : 0;
 }
 
 void GL::compileShader(GLuint shader) {
+    s_calls++;
 }
 void GL::attachShader(GLuint program, GLuint shader) {
+    s_calls++;
 }
 void GL::linkProgram(GLuint program) {
+    s_calls++;
 }
 
 void GL::shaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length) {
+    s_calls++;
 }
 void GL::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    s_calls++;
 }
 void GL::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    s_calls++;
 }
 GLint GL::getUniformLocation(GLuint program, const GLchar *name) {
+    s_calls++;
     return 0;
 }
 GLint GL::getAttribLocation(GLuint program, const GLchar *name) {
+    s_calls++;
     return 0;
 }
 void GL::getProgramiv(GLuint program, GLenum pname, GLint *params) {
+    s_calls++;
+    if (s_acceptAll) { *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0; }
 }
 void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
+    s_calls++;
+    if (s_acceptAll) { *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0; }
 }
 
 // Buffers
 void GL::bindBuffer(GLenum target, GLuint buffer) {
+    s_calls++;
 }
 void GL::deleteBuffers(GLsizei n, const GLuint *buffers) {
+    s_calls++;
 }
 void GL::genBuffers(GLsizei n, GLuint *buffers) {
+    s_calls++;
+    genNames(n, buffers);
 }
 void GL::bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    s_calls++;
 }
 void GL::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    s_calls++;
 }
 void GL::readPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                     GLenum format, GLenum type, GLvoid* pixels) {
+    s_calls++;
 }
 
 // Texture
 void GL::bindTexture(GLenum target, GLuint texture ) {
+    s_calls++;
 }
 void GL::activeTexture(GLenum texture) {
+    s_calls++;
 }
 void GL::genTextures(GLsizei n, GLuint *textures ) {
+    s_calls++;
+    genNames(n, textures);
 }
 void GL::deleteTextures(GLsizei n, const GLuint *textures) {
+    s_calls++;
 }
 void GL::texParameteri(GLenum target, GLenum pname, GLint param ) {
+    s_calls++;
 }
 void GL::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
                     GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+    s_calls++;
 }
 void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                        GLenum format, GLenum type, const GLvoid *pixels) {
+    s_calls++;
 }
 void GL::generateMipmap(GLenum target) {
+    s_calls++;
 }
 
 void GL::enableVertexAttribArray(GLuint index) {
+    s_calls++;
 }
 void GL::disableVertexAttribArray(GLuint index) {
+    s_calls++;
 }
 void GL::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
                              GLsizei stride, const void *pointer) {
+    s_calls++;
 }
 
 void GL::drawArrays(GLenum mode, GLint first, GLsizei count ) {
+    s_calls++;
 }
 void GL::drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices ) {
+    s_calls++;
 }
 
 void GL::uniform1f(GLint location, GLfloat v0) {
+    s_calls++;
 }
 void GL::uniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    s_calls++;
 }
 void GL::uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    s_calls++;
 }
 void GL::uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    s_calls++;
 }
 
 void GL::uniform1i(GLint location, GLint v0) {
+    s_calls++;
 }
 void GL::uniform2i(GLint location, GLint v0, GLint v1) {
+    s_calls++;
 }
 void GL::uniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    s_calls++;
 }
 void GL::uniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    s_calls++;
 }
 
 void GL::uniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniform1iv(GLint location, GLsizei count, const GLint *value) {
+    s_calls++;
 }
 void GL::uniform2iv(GLint location, GLsizei count, const GLint *value) {
+    s_calls++;
 }
 void GL::uniform3iv(GLint location, GLsizei count, const GLint *value) {
+    s_calls++;
 }
 void GL::uniform4iv(GLint location, GLsizei count, const GLint *value) {
+    s_calls++;
 }
 
 void GL::uniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    s_calls++;
 }
 void GL::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    s_calls++;
 }
 
 // mapbuffer
 void* GL::mapBuffer(GLenum target, GLenum access) {
+    s_calls++;
     return nullptr;
 }
 GLboolean GL::unmapBuffer(GLenum target) {
+    s_calls++;
     return true;
 }
+void* GL::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    s_calls++;
+    if (!s_acceptAll) { return nullptr; }
+    static std::vector<char> mapped;
+    mapped.assign(length, char(0xff));
+    return mapped.data();
+}
+
+GLsync GL::fenceSync(GLenum condition, GLbitfield flags) {
+    s_calls++;
+    return s_acceptAll ? reinterpret_cast<GLsync>(uintptr_t(++s_names)) : nullptr;
+}
+GLenum GL::clientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout) {
+    s_calls++;
+    return s_acceptAll ? GL_ALREADY_SIGNALED : GL_WAIT_FAILED;
+}
+void GL::deleteSync(GLsync sync) {
+    s_calls++;
+}
+
+void GL::genQueries(GLsizei n, GLuint *ids) {
+    s_calls++;
+    genNames(n, ids);
+}
+void GL::deleteQueries(GLsizei n, const GLuint *ids) {
+    s_calls++;
+}
+void GL::beginQuery(GLenum target, GLuint id) {
+    s_calls++;
+}
+void GL::endQuery(GLenum target) {
+    s_calls++;
+}
+void GL::getQueryObjectuiv(GLuint id, GLenum pname, GLuint *params) {
+    s_calls++;
+    *params = 0;
+}
+void GL::getQueryObjectui64v(GLuint id, GLenum pname, uint64_t *params) {
+    s_calls++;
+    *params = 0;
+}
 
 void GL::finish(void) {
+    s_calls++;
 }
 
 // VAO
 void GL::bindVertexArray(GLuint array) {
+    s_calls++;
 }
 void GL::deleteVertexArrays(GLsizei n, const GLuint *arrays) {
+    s_calls++;
 }
 void GL::genVertexArrays(GLsizei n, GLuint *arrays) {
+    s_calls++;
+    genNames(n, arrays);
 }
 
 // Framebuffer
 void GL::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    s_calls++;
 }
 void GL::genFramebuffers(GLsizei n, GLuint *framebuffers) {
+    s_calls++;
+    genNames(n, framebuffers);
 }
 void GL::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
                               GLuint texture, GLint level) {
+    s_calls++;
 }
 void GL::renderbufferStorage(GLenum target, GLenum internalformat, GLsizei width,
                              GLsizei height) {
+    s_calls++;
 }
 void GL::framebufferRenderbuffer(GLenum target, GLenum attachment,
                                  GLenum renderbuffertarget, GLuint renderbuffer) {
+    s_calls++;
 }
 void GL::genRenderbuffers(GLsizei n, GLuint *renderbuffers) {
+    s_calls++;
+    genNames(n, renderbuffers);
 }
 void GL::bindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    s_calls++;
 }
 void GL::deleteFramebuffers(GLsizei n, const GLuint *framebuffers) {
+    s_calls++;
 }
 void GL::deleteRenderbuffers(GLsizei n, const GLuint *renderbuffers) {
+    s_calls++;
 }
 GLenum GL::checkFramebufferStatus(GLenum target) {
-    return 0;
+    s_calls++;
+    return s_acceptAll ? GL_FRAMEBUFFER_COMPLETE : 0;
 }
 
 }
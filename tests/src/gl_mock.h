@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Tangram {
+
+// The GL functions of the mock do nothing but count their calls. GL is
+// called on the render thread only.
+namespace GLMock {
+
+// Number of GL functions called since the last reset
+uint64_t calls();
+
+void resetCalls();
+
+// Act like a driver that accepts everything: shaders compile and link,
+// objects get names, framebuffers are complete, fences are signaled at once,
+// mapped buffers read as 0xff bytes and capabilities have fixed values.
+// Off by default, as for the unit tests.
+void setAcceptAll(bool _acceptAll);
+
+}
+}
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <iterator>
 
 #include <libgen.h>
 
@@ -43,6 +45,68 @@ bool MockPlatform::startUrlRequest(const std::string& _url, UrlCallback _callbac
 
 void MockPlatform::cancelUrlRequest(const std::string& _url) {}
 
+bool MockUrlPlatform::startUrlRequest(const std::string& _url, UrlCallback _callback) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!acceptRequests) { return false; }
+
+        startCount++;
+        if (!serveFiles) {
+            m_pending.emplace_back(_url, std::move(_callback));
+            return true;
+        }
+    }
+
+    std::string path = _url;
+    if (path.compare(0, 7, "file://") == 0) { path = path.substr(7); }
+
+    std::vector<char> data;
+    std::ifstream file(path, std::ios::binary);
+    if (file) {
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    _callback(std::move(data));
+    return true;
+}
+
+void MockUrlPlatform::cancelUrlRequest(const std::string& _url) {
+    UrlCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                               [&](auto& request) { return request.first == _url; });
+        if (it == m_pending.end()) { return; }
+
+        cancelCount++;
+        callback = std::move(it->second);
+        m_pending.erase(it);
+    }
+    // Like the platform clients, respond to canceled requests with empty data
+    callback({});
+}
+
+bool MockUrlPlatform::respond(const std::string& _url, std::vector<char> _data) {
+    UrlCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                               [&](auto& request) { return request.first == _url; });
+        if (it == m_pending.end()) { return false; }
+
+        callback = std::move(it->second);
+        m_pending.erase(it);
+    }
+    callback(std::move(_data));
+    return true;
+}
+
+std::vector<std::string> MockUrlPlatform::pendingUrls() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> urls;
+    for (auto& request : m_pending) { urls.push_back(request.first); }
+    return urls;
+}
+
 void setCurrentThreadPriority(int priority) {}
 
 void initGLExtensions() {}
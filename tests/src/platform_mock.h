@@ -2,6 +2,12 @@
 
 #include "platform.h"
 
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 class MockPlatform : public Platform {
 
 public:
@@ -13,4 +19,33 @@ public:
 
 };
 
+// Keeps URL requests pending until the test responds to them
+class MockUrlPlatform : public MockPlatform {
+
+public:
+
+    bool startUrlRequest(const std::string& _url, UrlCallback _callback) override;
+    void cancelUrlRequest(const std::string& _url) override;
+
+    // Respond to the oldest pending request for @_url, returns false when there is none
+    bool respond(const std::string& _url, std::vector<char> _data);
 
+    // URLs of the pending requests in the order they were started
+    std::vector<std::string> pendingUrls() const;
+
+    // Number of requests started and canceled
+    size_t startCount = 0;
+    size_t cancelCount = 0;
+
+    // When false startUrlRequest fails
+    bool acceptRequests = true;
+
+    // When true requests are answered immediately with the content of the
+    // local file at the path of the URL, or empty data when it does not exist
+    bool serveFiles = false;
+
+private:
+
+    std::deque<std::pair<std::string, UrlCallback>> m_pending;
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,99 @@
+#include "catch.hpp"
+
+#include "data/clientGeoJsonSource.h"
+#include "data/clientTileIndex.h"
+#include "data/propertyItem.h"
+#include "platform_mock.h"
+
+using namespace Tangram;
+
+TEST_CASE("TileGenerations only invalidate tiles touched by an update", "[ClientTileIndex]") {
+
+    TileGenerations generations(16);
+
+    REQUIRE(generations.generation(TileID(0, 0, 0)) == 0);
+
+    // A point in the top-left quadrant
+    int64_t gen = generations.update(0.1, 0.1, 0.1, 0.1);
+    REQUIRE(gen == generations.generation());
+
+    // Ancestors and the tiles containing the point
+    REQUIRE(generations.generation(TileID(0, 0, 0)) == gen);
+    REQUIRE(generations.generation(TileID(0, 0, 1)) == gen);
+    REQUIRE(generations.generation(TileID(6553, 6553, 16)) == gen);
+
+    // Tiles elsewhere keep their generation
+    REQUIRE(generations.generation(TileID(1, 1, 1)) == 0);
+    REQUIRE(generations.generation(TileID(6600, 6553, 16)) == 0);
+
+    // Tiles below the tracked zoom are covered by their ancestor
+    REQUIRE(generations.generation(TileID(6553 * 4, 6553 * 4, 18)) == gen);
+
+    // An update spanning the whole map invalidates all tiles
+    int64_t all = generations.update(0, 0, 1, 1);
+    REQUIRE(generations.generation(TileID(1, 1, 1)) == all);
+    REQUIRE(generations.generation(TileID(6600, 6553, 16)) == all);
+
+    int64_t cleared = generations.updateAll();
+    REQUIRE(generations.generation(TileID(100, 100, 10)) == cleared);
+}
+
+TEST_CASE("ClientGeoJsonSource invalidates only tiles of added features", "[ClientTileIndex]") {
+
+    auto platform = std::make_shared<MockPlatform>();
+    ClientGeoJsonSource source(platform, "points", "", -1, -1, 16);
+
+    int64_t initial = source.generation();
+
+    source.addPoint(Properties(), LngLat(-73.99, 40.73));
+
+    REQUIRE(source.generation() > initial);
+
+    // Tile of the point at z10 and a tile on the other side of the world
+    REQUIRE(source.tileGeneration(TileID(301, 384, 10)) == source.generation());
+    REQUIRE(source.tileGeneration(TileID(900, 384, 10)) < source.generation());
+
+    // Changes within a change block take effect at its end
+    int64_t before = source.generation();
+    source.beginChangeBlock();
+    source.addPoint(Properties(), LngLat(139.69, 35.69));
+    REQUIRE(source.generation() == before);
+    source.endChangeBlock();
+
+    REQUIRE(source.generation() > before);
+    REQUIRE(source.tileGeneration(TileID(301, 384, 10)) <= before);
+
+    source.clearData();
+    REQUIRE(source.tileGeneration(TileID(301, 384, 10)) == source.generation());
+}
+
+TEST_CASE("ClientGeoJsonSource updates and removes features by ID", "[ClientTileIndex]") {
+
+    auto platform = std::make_shared<MockPlatform>();
+    ClientGeoJsonSource source(platform, "points", "", -1, -1, 16);
+
+    TileID nyc(301, 384, 10);
+    TileID tokyo(909, 403, 10);
+
+    auto id = source.addPoint(Properties(), LngLat(-73.99, 40.73));
+    auto other = source.addPoint(Properties(), LngLat(2.35, 48.85));
+    REQUIRE(id != other);
+
+    int64_t added = source.tileGeneration(nyc);
+    REQUIRE(source.tileGeneration(tokyo) < added);
+
+    // Moving the feature invalidates its previous and its new tile
+    source.updateFeature(id, Properties(), LngLat(139.69, 35.69));
+    REQUIRE(source.tileGeneration(nyc) > added);
+    REQUIRE(source.tileGeneration(tokyo) == source.generation());
+
+    // Unknown IDs leave the source unchanged
+    int64_t generation = source.generation();
+    source.updateFeature(1000, Properties(), LngLat(0, 0));
+    source.removeFeature(1000);
+    REQUIRE(source.generation() == generation);
+
+    source.removeFeature(id);
+    REQUIRE(source.tileGeneration(tokyo) > generation);
+    REQUIRE(source.tileGeneration(nyc) < generation);
+}
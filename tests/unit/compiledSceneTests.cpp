@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include "yaml-cpp/yaml.h"
+#include "scene/compiledScene.h"
+#include "scene/dataLayer.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+#include "scene/stops.h"
+
+#include "platform_mock.h"
+
+#include <cstring>
+
+using namespace Tangram;
+
+std::shared_ptr<Scene> loadLayers(std::shared_ptr<Platform> platform, const std::string& hash) {
+    auto scene = std::make_shared<Scene>(platform);
+    scene->sourceHash() = hash;
+
+    YAML::Node layers = YAML::Load(R"END(
+        roads:
+            data: { source: osm }
+            filter: { kind: [highway, major_road], $zoom: { min: 10 }, is_bridge: false }
+            draw:
+                lines:
+                    color: [[10, red], [14, blue]]
+                    width: function() { return feature.lanes * 2; }
+                    order: 2
+            bridges:
+                filter: { is_bridge: true }
+                draw:
+                    lines:
+                        width: 4px
+                        cap: round
+        )END");
+
+    for (const auto& layer : layers) {
+        SceneLoader::loadLayer(layer, scene);
+    }
+    return scene;
+}
+
+void compareLayers(const SceneLayer& a, const SceneLayer& b) {
+    REQUIRE(a.name() == b.name());
+    REQUIRE(a.depth() == b.depth());
+    REQUIRE(a.visible() == b.visible());
+    REQUIRE(a.filter().data.which() == b.filter().data.which());
+    REQUIRE(a.filter().operands().size() == b.filter().operands().size());
+
+    REQUIRE(a.rules().size() == b.rules().size());
+    for (size_t i = 0; i < a.rules().size(); i++) {
+        auto& ra = a.rules()[i];
+        auto& rb = b.rules()[i];
+        REQUIRE(ra.name == rb.name);
+        REQUIRE(ra.id == rb.id);
+        REQUIRE(ra.parameters.size() == rb.parameters.size());
+
+        for (size_t j = 0; j < ra.parameters.size(); j++) {
+            auto& pa = ra.parameters[j];
+            auto& pb = rb.parameters[j];
+            REQUIRE(pa.key == pb.key);
+            REQUIRE(pa.function == pb.function);
+            REQUIRE(pa.toString() == pb.toString());
+            REQUIRE((pa.stops == nullptr) == (pb.stops == nullptr));
+            if (pa.stops) {
+                REQUIRE(pa.stops->frames.size() == pb.stops->frames.size());
+                REQUIRE(pa.stops->evalColor(12) == pb.stops->evalColor(12));
+            }
+        }
+    }
+
+    REQUIRE(a.sublayers().size() == b.sublayers().size());
+    for (size_t i = 0; i < a.sublayers().size(); i++) {
+        compareLayers(a.sublayers()[i], b.sublayers()[i]);
+    }
+}
+
+TEST_CASE("Compiled scene restores layers, filters and draw rules", "[CompiledScene]") {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+
+    auto scene = loadLayers(platform, "hash");
+
+    std::vector<char> data;
+    REQUIRE(CompiledScene::write(*scene, data));
+
+    Scene loaded(platform);
+    loaded.sourceHash() = "hash";
+    REQUIRE(CompiledScene::read(data, loaded));
+
+    REQUIRE(loaded.names() == scene->names());
+    REQUIRE(loaded.functions() == scene->functions());
+    REQUIRE(loaded.stops().size() == scene->stops().size());
+
+    REQUIRE(loaded.layers().size() == 1);
+    auto& layer = loaded.layers()[0];
+    REQUIRE(layer.source() == "osm");
+    REQUIRE(layer.collections() == std::vector<std::string>{ "roads" });
+
+    compareLayers(scene->layers()[0], layer);
+
+    REQUIRE(layer.sublayers()[0].name() == "roads:bridges");
+    REQUIRE(layer.sublayers()[0].depth() == 2);
+}
+
+TEST_CASE("Compiled scene is rejected for other scene sources", "[CompiledScene]") {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+
+    auto scene = loadLayers(platform, "hash");
+
+    std::vector<char> data;
+    REQUIRE(CompiledScene::write(*scene, data));
+
+    Scene other(platform);
+    other.sourceHash() = "other";
+    REQUIRE(CompiledScene::read(data, other) == false);
+    REQUIRE(other.layers().empty());
+
+    // Truncated data
+    Scene truncated(platform);
+    truncated.sourceHash() = "hash";
+    data.resize(data.size() / 2);
+    REQUIRE(CompiledScene::read(data, truncated) == false);
+    REQUIRE(truncated.layers().empty());
+    REQUIRE(truncated.names().empty());
+}
+
+TEST_CASE("Compiled scene is rejected for another layout of the style parameters", "[CompiledScene]") {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+
+    auto scene = loadLayers(platform, "hash");
+
+    std::vector<char> data;
+    REQUIRE(CompiledScene::write(*scene, data));
+
+    // The fingerprint follows magic and version
+    uint64_t hash = CompiledScene::layoutHash();
+    REQUIRE(hash == CompiledScene::layoutHash());
+    REQUIRE(std::memcmp(data.data() + 8, &hash, sizeof(hash)) == 0);
+
+    // Written by a build with other StyleParamKeys
+    hash++;
+    std::memcpy(data.data() + 8, &hash, sizeof(hash));
+
+    Scene loaded(platform);
+    loaded.sourceHash() = "hash";
+    REQUIRE(CompiledScene::read(data, loaded) == false);
+    REQUIRE(loaded.layers().empty());
+}
@@ -0,0 +1,200 @@
+#include "catch.hpp"
+
+#include "data/downloadScheduler.h"
+#include "platform_mock.h"
+
+#include <map>
+
+using namespace Tangram;
+
+static DownloadScheduler::Options fixedOptions(uint32_t _max, uint32_t _perHost = 6) {
+    DownloadScheduler::Options options;
+    options.maxDownloads = _max;
+    options.maxDownloadsPerHost = _perHost;
+    options.adaptive = false;
+    return options;
+}
+
+static DownloadScheduler::Request request(const std::string& _url, std::vector<std::string>& _responses,
+                                          double _priority = 0) {
+    DownloadScheduler::Request request;
+    request.url = _url;
+    request.priority = [=]() { return _priority; };
+    request.callback = [&_responses, _url](std::vector<char>&& _data) {
+        _responses.push_back(_url + ":" + std::string(_data.begin(), _data.end()));
+    };
+    return request;
+}
+
+TEST_CASE("DownloadScheduler coalesces requests for the same URL", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(4));
+
+    std::vector<std::string> responses;
+    scheduler->request(request("http://a/1", responses));
+    scheduler->request(request("http://a/1", responses));
+
+    REQUIRE(platform->startCount == 1);
+    REQUIRE(scheduler->stats().coalesced == 1);
+
+    REQUIRE(platform->respond("http://a/1", { 'x' }));
+    REQUIRE(responses == std::vector<std::string>({ "http://a/1:x", "http://a/1:x" }));
+    REQUIRE(scheduler->stats().active == 0);
+}
+
+TEST_CASE("DownloadScheduler starts queued requests by priority", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(1));
+
+    std::vector<std::string> responses;
+    scheduler->request(request("http://a/first", responses, 5));
+    scheduler->request(request("http://a/far", responses, 10));
+    scheduler->request(request("http://a/near", responses, 1));
+
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://a/first" }));
+    REQUIRE(scheduler->stats().queued == 2);
+
+    platform->respond("http://a/first", {});
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://a/near" }));
+
+    platform->respond("http://a/near", {});
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://a/far" }));
+}
+
+TEST_CASE("DownloadScheduler limits requests per host", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(4, 1));
+
+    REQUIRE(DownloadScheduler::host("https://tile.example.com:8080/1/2/3.mvt") == "tile.example.com:8080");
+
+    std::vector<std::string> responses;
+    scheduler->request(request("http://a/1", responses));
+    scheduler->request(request("http://a/2", responses));
+    scheduler->request(request("http://b/1", responses));
+
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://a/1", "http://b/1" }));
+
+    platform->respond("http://a/1", {});
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://b/1", "http://a/2" }));
+}
+
+TEST_CASE("DownloadScheduler drops canceled requests before they are started", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(1));
+
+    std::vector<std::string> responses;
+    auto active = scheduler->request(request("http://a/1", responses));
+    auto queued = scheduler->request(request("http://a/2", responses));
+
+    bool canceled = false;
+    auto req = request("http://a/3", responses);
+    req.canceled = [&]() { return canceled; };
+    scheduler->request(std::move(req));
+
+    // Canceling a queued request never reaches the platform
+    scheduler->cancel(queued);
+    REQUIRE(platform->cancelCount == 0);
+    REQUIRE(scheduler->stats().dropped == 1);
+
+    // Requests which are canceled meanwhile are dropped on dispatch
+    canceled = true;
+
+    // Canceling the active request cancels the platform request
+    scheduler->cancel(active);
+    REQUIRE(platform->cancelCount == 1);
+    REQUIRE(platform->pendingUrls().empty());
+    REQUIRE(scheduler->stats().dropped == 2);
+
+    REQUIRE(responses.empty());
+    REQUIRE(platform->startCount == 1);
+}
+
+TEST_CASE("DownloadScheduler notifies dropped requests", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(1));
+
+    std::vector<std::string> responses;
+    scheduler->request(request("http://a/1", responses));
+
+    bool canceled = false;
+    int failed = 0;
+    auto req = request("http://a/2", responses);
+    req.canceled = [&]() { return canceled; };
+    req.failed = [&]() { failed++; };
+    scheduler->request(std::move(req));
+
+    canceled = true;
+    platform->respond("http://a/1", {});
+
+    REQUIRE(failed == 1);
+    REQUIRE(scheduler->stats().dropped == 1);
+    REQUIRE(platform->startCount == 1);
+}
+
+TEST_CASE("DownloadScheduler starts queued requests after a request could not be started", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, fixedOptions(1));
+
+    std::vector<std::string> responses;
+    scheduler->request(request("http://a/1", responses, 0));
+
+    int failed = 0;
+    auto req = request("http://a/2", responses, 1);
+    req.failed = [&]() {
+        failed++;
+        platform->acceptRequests = true;
+    };
+    scheduler->request(std::move(req));
+    scheduler->request(request("http://a/3", responses, 2));
+
+    platform->acceptRequests = false;
+    platform->respond("http://a/1", {});
+
+    REQUIRE(failed == 1);
+    REQUIRE(platform->pendingUrls() == std::vector<std::string>({ "http://a/3" }));
+    REQUIRE(scheduler->stats().active == 1);
+}
+
+TEST_CASE("DownloadScheduler adapts concurrency to latency", "[DownloadScheduler]") {
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+
+    double time = 0;
+    DownloadScheduler::Options options;
+    options.minDownloads = 2;
+    options.maxDownloads = 16;
+    options.maxDownloadsPerHost = 16;
+    options.clock = [&]() { return time; };
+
+    auto scheduler = std::make_shared<DownloadScheduler>(platform, options);
+    uint32_t initial = scheduler->stats().limit;
+
+    std::vector<std::string> responses;
+    int count = 0;
+
+    auto run = [&](double _latency, int _requests) {
+        for (int i = 0; i < _requests; i++) {
+            std::string url = "http://a/" + std::to_string(count++);
+            scheduler->request(request(url, responses));
+            time += _latency;
+            platform->respond(url, { 'x' });
+        }
+    };
+
+    // Constant latency: grow towards the maximum
+    run(0.1, 50);
+    uint32_t grown = scheduler->stats().limit;
+    REQUIRE(grown > initial);
+    REQUIRE(grown <= 16);
+
+    // Rising latency: shrink
+    run(0.5, 50);
+    REQUIRE(scheduler->stats().limit < grown);
+    REQUIRE(scheduler->stats().limit >= 2);
+}
@@ -2,6 +2,8 @@
 
 #include "scene/drawRule.h"
 #include "scene/sceneLayer.h"
+#include "scene/stops.h"
+#include "scene/styleContext.h"
 #include "platform.h"
 
 #include <cstdio>
@@ -205,3 +207,40 @@ TEST_CASE("DrawRule correctly reports that it doesn't contain a parameter", "[Dr
 
 
 }
+
+TEST_CASE("DrawRule uses stops values precomputed for the zoom level", "[DrawRule]") {
+
+    Stops stops({ Stops::Frame(0, 1.f), Stops::Frame(10, 11.f) });
+    stops.zoomIndex = 0;
+
+    std::vector<StyleParam> params = { { StyleParamKey::priority, &stops } };
+    const SceneLayer layer = { "a", Filter(), { { "dg1", dg1, params } }, {} };
+
+    std::vector<StyleParam> zoomParams = { params[0] };
+    Stops::eval(stops, StyleParamKey::priority, 5, zoomParams[0].value);
+
+    StyleContext ctx;
+    ctx.setKeywordZoom(5);
+
+    DrawRuleMergeSet ruleSet;
+    ruleSet.setZoomParams(&zoomParams);
+    ruleSet.mergeRules(layer);
+
+    auto& rule = ruleSet.matchedRules()[0];
+    REQUIRE(ruleSet.evaluateRuleForContext(rule, ctx));
+    REQUIRE(&rule.findParameter(StyleParamKey::priority) == &zoomParams[0]);
+
+    float priority = 0;
+    REQUIRE(rule.get(StyleParamKey::priority, priority));
+    REQUIRE(priority == 6.f);
+
+    // Stops without precomputed values are still evaluated per feature
+    stops.zoomIndex = -1;
+    DrawRuleMergeSet fallback;
+    fallback.mergeRules(layer);
+
+    auto& fallbackRule = fallback.matchedRules()[0];
+    REQUIRE(fallback.evaluateRuleForContext(fallbackRule, ctx));
+    REQUIRE(fallbackRule.get(StyleParamKey::priority, priority));
+    REQUIRE(priority == 6.f);
+}
@@ -369,3 +369,114 @@ TEST_CASE( "Test evalFunction explicit", "[Duktape][evalFunction]") {
     }
 
 }
+
+TEST_CASE( "Test scanFeatureKeys", "[Duktape][scanFeatureKeys]") {
+    std::vector<std::string> keys;
+
+    REQUIRE(StyleContext::scanFeatureKeys(R"(function() { return feature.kind === 'x' && feature['name:en']; })",
+                                          false, keys));
+    REQUIRE(keys == std::vector<std::string>({ "kind", "name:en" }));
+
+    keys.clear();
+    REQUIRE(StyleContext::scanFeatureKeys(R"(function() { return 'feature.a' + /feature/.test(feature.b); })",
+                                          false, keys));
+    REQUIRE(keys == std::vector<std::string>({ "b" }));
+
+    keys.clear();
+    REQUIRE(StyleContext::scanFeatureKeys(R"(function() { return global.width; })", false, keys));
+    REQUIRE(keys.empty());
+
+    // Properties cannot be determined
+    REQUIRE(!StyleContext::scanFeatureKeys(R"(function() { return feature[key]; })", false, keys));
+    REQUIRE(!StyleContext::scanFeatureKeys(R"(function() { return 'a' in feature; })", false, keys));
+    REQUIRE(!StyleContext::scanFeatureKeys(R"(function() { feature.a = 1; return true; })", false, keys));
+    REQUIRE(!StyleContext::scanFeatureKeys(R"(function() { return global.width; })", true, keys));
+}
+
+TEST_CASE( "Test evalFilter with compiled functions", "[Duktape][loadFunctions]") {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    Scene scene(platform);
+    scene.functions() = {
+        R"(function() { return feature.scalerank === 2; })",
+        R"(function() { var k = 'scalerank'; return feature[k] === 2; })",
+        R"(function() { return feature.name === undefined; })",
+    };
+
+    auto compiled = StyleContext::compileFunctions(scene);
+    REQUIRE(compiled->functions.size() == 3);
+    REQUIRE(compiled->functions[0].staticKeys);
+    REQUIRE(!compiled->functions[1].staticKeys);
+
+    for (bool staticBinding : { true, false }) {
+        StyleContext ctx;
+        ctx.setStaticBinding(staticBinding);
+        REQUIRE(ctx.loadFunctions(*compiled));
+
+        Feature feat1;
+        feat1.props.set("scalerank", 2);
+        feat1.props.set("name", "test");
+
+        ctx.setFeature(feat1);
+        REQUIRE(ctx.evalFilter(0) == true);
+        REQUIRE(ctx.evalFilter(1) == true);
+        REQUIRE(ctx.evalFilter(2) == false);
+
+        Feature feat2;
+        ctx.setFeature(feat2);
+        REQUIRE(ctx.evalFilter(0) == false);
+        REQUIRE(ctx.evalFilter(1) == false);
+        REQUIRE(ctx.evalFilter(2) == true);
+    }
+}
+
+TEST_CASE( "Test native evaluation of simple functions", "[Duktape][NativeFunction]") {
+    std::vector<std::string> functions = {
+        R"(function() { return feature.kind === 'major_road' ? 3 : 1; })",
+        R"(function() { return feature.height * 2 + 1; })",
+        R"(function() { return $zoom >= 14 && feature['kind'] == "major_road"; })",
+        R"(function() { return feature.name || 'unnamed'; })",
+        R"(function() { return feature.kind + '_' + feature.height; })",
+        R"(function() { return feature.kind.length; })",
+    };
+
+    REQUIRE(NativeFunction::compile(functions[0]));
+    REQUIRE(NativeFunction::compile(functions[4]));
+    REQUIRE(!NativeFunction::compile(functions[5]));
+
+    Feature feature;
+    feature.props.set("kind", "major_road");
+    feature.props.set("height", 20);
+
+    StyleContext native;
+    StyleContext duktape;
+    duktape.setNativeEvaluation(false);
+
+    for (auto* ctx : { &native, &duktape }) {
+        REQUIRE(ctx->setFunctions(functions));
+        ctx->setFeature(feature);
+        ctx->setKeywordZoom(15);
+    }
+
+    REQUIRE(native.isNativeFunction(0));
+    REQUIRE(!native.isNativeFunction(5));
+
+    StyleParamKey keys[] = { StyleParamKey::order, StyleParamKey::width, StyleParamKey::visible,
+                             StyleParamKey::text_source, StyleParamKey::text_source, StyleParamKey::priority };
+
+    for (uint32_t id = 0; id < functions.size(); id++) {
+        StyleParam::Value a, b;
+        REQUIRE(native.evalStyle(id, keys[id], a) == duktape.evalStyle(id, keys[id], b));
+        REQUIRE(a == b);
+        REQUIRE(native.evalFilter(id) == duktape.evalFilter(id));
+    }
+
+    auto& stats = native.functionStats();
+    REQUIRE(stats.size() == functions.size());
+    REQUIRE(stats[0].native == 2);
+    REQUIRE(stats[0].duktape == 0);
+    // String concatenation falls back to Duktape
+    REQUIRE(stats[4].fallback == 2);
+    REQUIRE(stats[4].duktape == 2);
+    REQUIRE(stats[5].native == 0);
+    REQUIRE(stats[5].duktape == 2);
+}
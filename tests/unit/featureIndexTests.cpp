@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include "selection/featureIndex.h"
+
+using namespace Tangram;
+
+static Feature square(float _min, float _max) {
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.polygons.push_back({{ {_min, _min, 0}, {_max, _min, 0}, {_max, _max, 0}, {_min, _max, 0} }});
+    return feature;
+}
+
+TEST_CASE("FeatureIndex picks polygons containing the position", "[FeatureIndex]") {
+
+    FeatureIndex index;
+    FeatureIndex::Hit hit;
+
+    REQUIRE(!index.pick({0.5f, 0.5f}, 0.01f, hit));
+
+    // A square with a hole
+    Feature feature = square(0.1f, 0.9f);
+    feature.polygons[0].push_back({ {0.4f, 0.4f, 0}, {0.6f, 0.4f, 0}, {0.6f, 0.6f, 0}, {0.4f, 0.6f, 0} });
+    index.add(feature, 1);
+
+    REQUIRE(index.pick({0.2f, 0.2f}, 0.f, hit));
+    REQUIRE(hit.selectionColor == 1);
+    REQUIRE(hit.distance == 0);
+
+    REQUIRE(!index.pick({0.5f, 0.5f}, 0.01f, hit));
+    REQUIRE(index.pick({0.5f, 0.5f}, 0.15f, hit));
+    REQUIRE(hit.distance == Approx(0.1f));
+
+    REQUIRE(!index.pick({0.95f, 0.95f}, 0.01f, hit));
+
+    // Later features win on equal distance
+    index.add(square(0.15f, 0.25f), 2);
+    REQUIRE(index.pick({0.2f, 0.2f}, 0.f, hit));
+    REQUIRE(hit.selectionColor == 2);
+}
+
+TEST_CASE("FeatureIndex picks the nearest line or point within the radius", "[FeatureIndex]") {
+
+    FeatureIndex index;
+    FeatureIndex::Hit hit;
+
+    Feature line;
+    line.geometryType = GeometryType::lines;
+    line.lines.push_back({ {0.f, 0.5f, 0}, {1.f, 0.5f, 0} });
+    index.add(line, 1);
+
+    Feature point;
+    point.geometryType = GeometryType::points;
+    point.points.push_back({0.5f, 0.55f, 0});
+    index.add(point, 2);
+
+    REQUIRE(index.pick({0.1f, 0.52f}, 0.05f, hit));
+    REQUIRE(hit.selectionColor == 1);
+    REQUIRE(hit.distance == Approx(0.02f));
+
+    REQUIRE(index.pick({0.5f, 0.54f}, 0.05f, hit));
+    REQUIRE(hit.selectionColor == 2);
+
+    REQUIRE(!index.pick({0.1f, 0.6f}, 0.05f, hit));
+
+    index.clear();
+    REQUIRE(index.empty());
+    REQUIRE(!index.pick({0.1f, 0.52f}, 0.05f, hit));
+}
@@ -0,0 +1,113 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+#include "selection/featureIndex.h"
+#include "selection/featureSelection.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "yaml-cpp/yaml.h"
+
+#include "platform_mock.h"
+
+using namespace Tangram;
+
+static Properties properties(const std::string& _id) {
+    Properties props;
+    props.set("id", _id);
+    return props;
+}
+
+TEST_CASE("FeatureSelection looks up features by their selection color", "[FeatureSelection]") {
+
+    FeatureSelection selection;
+
+    uint32_t first = selection.reserveColors(6);
+    REQUIRE(first != 0);
+    REQUIRE(selection.reserveColors(6) == first + 6);
+
+    auto features = std::make_shared<SelectionFeatures>();
+    features->add(first, properties("a0"));
+    features->add(first + 1, properties("a1"));
+    features->add(first + 4, properties("b1"));
+    REQUIRE(features->count() == 3);
+    REQUIRE(features->firstColors() == std::vector<uint32_t>({ first, first + 4 }));
+    REQUIRE(features->getMemoryUsage() > 0);
+
+    selection.addFeatures(features);
+
+    auto props = selection.getProperties(first + 4);
+    REQUIRE(props);
+    REQUIRE(props->getString("id") == "b1");
+    REQUIRE(selection.getProperties(first + 1)->getString("id") == "a1");
+
+    REQUIRE(!selection.getProperties(first + 2));
+    REQUIRE(!selection.getProperties(first + 5));
+    REQUIRE(!selection.getProperties(first - 1));
+
+    // Features are dropped with their tile
+    features.reset();
+    REQUIRE(!selection.getProperties(first));
+
+    // Properties keep their features alive
+    REQUIRE(props->getString("id") == "b1");
+}
+
+TEST_CASE("Features of consecutively built tiles are picked from their own tile", "[FeatureSelection]") {
+
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    auto scene = std::make_shared<Scene>(platform);
+    scene->config() = YAML::Load(R"END(
+        sources:
+            src:
+                type: GeoJSON
+                url: file:///tiles/{z}/{x}/{y}.json
+        layers:
+            buildings:
+                data: { source: src }
+                draw:
+                    polygons:
+                        color: red
+                        interactive: true
+        )END");
+
+    REQUIRE(SceneLoader::applyConfig(platform, scene));
+    scene->featureIndex = true;
+
+    auto& source = *scene->tileSources().front();
+    TileBuilder builder(scene);
+
+    auto buildTile = [&](const std::string& _name) {
+        TileData data;
+        data.layers.emplace_back("buildings");
+        for (int i = 0; i < 2; i++) {
+            Feature feature;
+            float min = 0.1f + 0.5f * i, max = min + 0.3f;
+            feature.polygons.push_back({{ {min, min, 0}, {max, min, 0}, {max, max, 0}, {min, max, 0} }});
+            feature.props.set("id", _name + std::to_string(i));
+            data.layers.back().features.push_back(std::move(feature));
+        }
+        return builder.build(TileID(0, 0, 1), data, source);
+    };
+
+    auto tile0 = buildTile("a");
+    auto tile1 = buildTile("b");
+
+    REQUIRE(tile0->getSelectionFeatureCount() == 2);
+    REQUIRE(tile1->getSelectionFeatureCount() == 2);
+    REQUIRE(tile1->getMemoryUsage() > 0);
+
+    auto pick = [&](const Tile& _tile, glm::vec2 _position) -> std::string {
+        FeatureIndex::Hit hit;
+        if (!_tile.getFeatureIndex() || !_tile.getFeatureIndex()->pick(_position, 0.f, hit)) { return ""; }
+        auto props = scene->featureSelection()->getProperties(hit.selectionColor);
+        return props ? props->getString("id") : "";
+    };
+
+    REQUIRE(pick(*tile0, {0.2f, 0.2f}) == "a0");
+    REQUIRE(pick(*tile0, {0.7f, 0.7f}) == "a1");
+    REQUIRE(pick(*tile1, {0.2f, 0.2f}) == "b0");
+    REQUIRE(pick(*tile1, {0.7f, 0.7f}) == "b1");
+}
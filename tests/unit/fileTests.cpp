@@ -1,9 +1,18 @@
 #include "catch.hpp"
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <thread>
 #include <sys/stat.h>
 #include "tangram.h"
 #include "platform.h"
+#include "data/networkDataSource.h"
+#include "data/rawData.h"
+#include "data/tileData.h"
+#include "platform_mock.h"
 
 TEST_CASE( "Compare byte size of allocated resource to os file size", "[Core][bytesFromResource]" ) {
 #if 0
@@ -20,3 +29,74 @@ TEST_CASE( "Compare byte size of allocated resource to os file size", "[Core][by
     free(data);
 #endif
 }
+
+TEST_CASE( "Map file contents into RawData", "[Core][RawData]" ) {
+    using namespace Tangram;
+
+    const char* path = "/tmp/tangram-rawdata-test.bin";
+
+    // Large enough to be mapped, not read
+    std::vector<char> bytes(64 * 1024);
+    for (size_t i = 0; i < bytes.size(); i++) { bytes[i] = char(i * 7); }
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    auto data = RawData::mapFile(path);
+    REQUIRE(data);
+    REQUIRE(std::vector<char>(data->data(), data->data() + data->size()) == bytes);
+
+    // Small files are read
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "tile";
+    }
+    auto small = RawData::mapFile(path);
+    REQUIRE(small);
+    REQUIRE(std::string(small->data(), small->size()) == "tile");
+
+    std::remove(path);
+    REQUIRE_FALSE(RawData::mapFile(path));
+}
+
+TEST_CASE( "Map local tiles of NetworkDataSource off the loading thread", "[Core][RawData]" ) {
+    using namespace Tangram;
+
+    struct FileSource : TileSource {
+        FileSource(std::unique_ptr<DataSource> _sources) : TileSource("file", std::move(_sources)) {}
+
+        const char* mimeType() override { return ""; }
+
+        std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const override {
+            return nullptr;
+        }
+    };
+
+    const char* path = "/tmp/tangram-rawdata-test-0-0-0.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "tile";
+    }
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    auto source = std::make_shared<FileSource>(std::make_unique<NetworkDataSource>(
+        platform, "file:///tmp/tangram-rawdata-test-{z}-{x}-{y}.bin"));
+
+    std::promise<std::thread::id> loaded;
+    auto task = source->createTask(TileID(0, 0, 0));
+    source->loadTileData(task, {[&](std::shared_ptr<TileTask>) {
+        loaded.set_value(std::this_thread::get_id());
+    }});
+
+    auto future = loaded.get_future();
+    REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(future.get() != std::this_thread::get_id());
+
+    auto& data = static_cast<BinaryTileTask&>(*task).rawTileData;
+    REQUIRE(data);
+    REQUIRE(std::string(data->data(), data->size()) == "tile");
+    REQUIRE(platform->startCount == 0);
+
+    std::remove(path);
+}
@@ -0,0 +1,82 @@
+#include "catch.hpp"
+
+#include "gl/framebuffer.h"
+#include "gl/hardware.h"
+#include "gl/renderState.h"
+
+#include "gl_mock.h"
+
+using namespace Tangram;
+
+TEST_CASE("FrameBuffer reads rects through pixel buffers", "[FrameBuffer]") {
+
+    GLMock::setAcceptAll(true);
+    Hardware::supportsPixelBufferObjects = true;
+
+    RenderState rs;
+    FrameBuffer fb(64, 32, false);
+    REQUIRE(fb.applyAsRenderTarget(rs));
+
+    int id = fb.readRectAsync(0.5f, 0.5f, 0.25f, 0.25f);
+    REQUIRE(id != 0);
+
+    FrameBuffer::PixelRect rect;
+    REQUIRE(fb.readRectAsyncResult(id, rect));
+    REQUIRE(rect.left == 32);
+    REQUIRE(rect.bottom == 16);
+    REQUIRE(rect.width == 16);
+    REQUIRE(rect.height == 8);
+    REQUIRE(rect.pixels.size() == 16 * 8);
+    // Copied from the mapped buffer
+    REQUIRE(rect.pixels[0] == 0xffffffff);
+
+    // A read is resolved once
+    REQUIRE(fb.readRectAsyncResult(id, rect));
+    REQUIRE(rect.width == 0);
+    REQUIRE(rect.pixels.empty());
+
+    // Pixel buffers are reused once resolved, until then reads fall back to readRect
+    int ids[4];
+    for (auto& read : ids) {
+        read = fb.readRectAsync(0.f, 0.f, 0.5f, 0.5f);
+        REQUIRE(read != 0);
+    }
+    REQUIRE(fb.readRectAsync(0.f, 0.f, 0.5f, 0.5f) == 0);
+
+    REQUIRE(fb.readRectAsyncResult(ids[2], rect));
+    REQUIRE(rect.width == 32);
+    REQUIRE(fb.readRectAsync(0.f, 0.f, 0.5f, 0.5f) != 0);
+
+    Hardware::supportsPixelBufferObjects = false;
+    GLMock::setAcceptAll(false);
+}
+
+TEST_CASE("FrameBuffer skips reads of empty rects", "[FrameBuffer]") {
+
+    GLMock::setAcceptAll(true);
+    Hardware::supportsPixelBufferObjects = true;
+
+    RenderState rs;
+    FrameBuffer fb(64, 32, false);
+    REQUIRE(fb.applyAsRenderTarget(rs));
+
+    GLMock::resetCalls();
+
+    REQUIRE(fb.readRectAsync(0.5f, 0.5f, 0.f, 0.25f) == 0);
+    // Outside of the framebuffer
+    REQUIRE(fb.readRectAsync(1.5f, 0.5f, 0.25f, 0.25f) == 0);
+
+    auto rect = fb.readRect(0.5f, 0.5f, 0.25f, 0.f);
+    REQUIRE(rect.width * rect.height == 0);
+    REQUIRE(rect.pixels.empty());
+
+    REQUIRE(GLMock::calls() == 0);
+
+    // Empty reads take no pixel buffers
+    for (int i = 0; i < 4; i++) {
+        REQUIRE(fb.readRectAsync(0.f, 0.f, 0.5f, 0.5f) != 0);
+    }
+
+    Hardware::supportsPixelBufferObjects = false;
+    GLMock::setAcceptAll(false);
+}
@@ -0,0 +1,48 @@
+#include "catch.hpp"
+
+#include "debug/frameProfiler.h"
+#include "gl/renderState.h"
+
+using namespace Tangram;
+
+TEST_CASE("FrameProfiler publishes the stats of a frame", "[FrameProfiler]") {
+
+    FrameProfiler profiler;
+    RenderState rs;
+    FrameStats stats;
+
+    // Disabled by default
+    profiler.beginFrame(rs);
+    profiler.endFrame(rs, 1);
+    REQUIRE(!profiler.getStats(stats));
+
+    profiler.setEnabled(true);
+
+    profiler.beginUpdate();
+    profiler.beginLabels();
+    profiler.endLabels();
+    profiler.endUpdate();
+
+    rs.counters.drawCalls = 10;
+    profiler.beginFrame(rs);
+    REQUIRE(rs.counters.drawCalls == 0);
+
+    rs.counters.drawCalls = 3;
+    rs.counters.vertices = 300;
+    rs.counters.uploadBytes = 1024;
+    profiler.endFrame(rs, 5);
+
+    REQUIRE(profiler.getStats(stats));
+    REQUIRE(stats.frame == 1);
+    REQUIRE(stats.tilesDrawn == 5);
+    REQUIRE(stats.drawCalls == 3);
+    REQUIRE(stats.vertices == 300);
+    REQUIRE(stats.uploadBytes == 1024);
+    REQUIRE(stats.updateTime >= stats.labelTime);
+    REQUIRE(stats.labelTime >= 0);
+    // No timer queries with the GL mock
+    REQUIRE(stats.gpuTime < 0);
+
+    profiler.setEnabled(false);
+    REQUIRE(!profiler.getStats(stats));
+}
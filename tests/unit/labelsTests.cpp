@@ -8,6 +8,7 @@
 #include "labels/textLabel.h"
 #include "labels/textLabels.h"
 #include "gl/dynamicQuadMesh.h"
+#include "marker/marker.h"
 
 #include "view/view.h"
 #include "tile/tile.h"
@@ -216,4 +217,51 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
     }
 
 }
+
+TEST_CASE( "Update the labels of visible markers with a style of the scene", "[Labels][Marker]" ) {
+
+    View view(256, 256);
+    view.setPosition(0, 0);
+    view.setZoom(0);
+    view.update(false);
+
+    struct TestLabelMesh : public LabelSet {
+        void addLabel(std::unique_ptr<Label> _label) { m_labels.push_back(std::move(_label)); }
+    };
+
+    class TestLabels : public Labels {
+    public:
+        size_t labelCount() const { return m_labels.size(); }
+    };
+
+    std::vector<std::unique_ptr<Style>> styles;
+    for (uint32_t id = 0; id < 2; id++) {
+        styles.push_back(std::make_unique<TextStyle>("text" + std::to_string(id), nullptr, false));
+        styles.back()->setID(id);
+    }
+
+    std::vector<std::unique_ptr<Marker>> markers;
+    auto addMarker = [&](uint32_t _styleId, bool _visible) {
+        auto mesh = std::make_unique<TestLabelMesh>();
+        mesh->addLabel(makeLabel(glm::vec2{0, 0}, Label::Type::point, "0"));
+
+        markers.push_back(std::make_unique<Marker>(markers.size() + 1));
+        auto& marker = *markers.back();
+        marker.setBounds({ {0, 0}, {0, 0} });
+        marker.setMesh(_styleId, 0, std::move(mesh));
+        marker.setVisible(_visible);
+        marker.update(0, view);
+    };
+
+    addMarker(1, true);
+    // Style of a previous scene
+    addMarker(5, true);
+    addMarker(0, false);
+
+    TestLabels labels;
+    labels.updateLabels(view.state(), 0, styles, {}, markers, false);
+
+    REQUIRE(labels.labelCount() == 1);
+}
+
 }
@@ -0,0 +1,156 @@
+#include "catch.hpp"
+
+#include "marker/marker.h"
+#include "marker/markerManager.h"
+#include "scene/drawRule.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+#include "util/mapProjection.h"
+#include "yaml-cpp/yaml.h"
+
+#include "platform_mock.h"
+
+using namespace Tangram;
+
+static const char* pointStyling = "{ style: points, color: white, size: [10px, 10px] }";
+
+static std::shared_ptr<Scene> markerScene() {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    auto scene = std::make_shared<Scene>(platform);
+    scene->config() = YAML::Load("sources: {}");
+    SceneLoader::applyConfig(platform, scene);
+    return scene;
+}
+
+static const Marker* findMarker(const MarkerManager& _markers, MarkerID _id) {
+    for (auto& marker : _markers.markers()) {
+        if (marker->id() == _id) { return marker.get(); }
+    }
+    return nullptr;
+}
+
+// Markers with the same parsed styling share the name of their draw rule data
+static bool sameStyling(const Marker* _a, const Marker* _b) {
+    return _a->drawRule() && _b->drawRule() && _a->drawRule()->name == _b->drawRule()->name;
+}
+
+static int countBuilt(const MarkerManager& _markers, int _zoom) {
+    int count = 0;
+    for (auto& marker : _markers.markers()) {
+        if (marker->builtZoomLevel() == _zoom) { count++; }
+    }
+    return count;
+}
+
+TEST_CASE("MarkerManager rebuilds markers for a new zoom over several updates", "[MarkerManager]") {
+
+    MarkerManager markers;
+    markers.setScene(markerScene());
+
+    std::vector<LngLat> coordinates = { {0., 0.}, {1., 1.}, {2., 2.} };
+    auto ids = markers.addPoints(pointStyling, coordinates.data(), coordinates.size());
+    REQUIRE(ids.size() == 3);
+    REQUIRE(countBuilt(markers, 0) == 3);
+
+    // Rebuild one marker per update
+    markers.setBuildTimeBudget(std::chrono::steady_clock::duration::zero());
+
+    REQUIRE(markers.update(10));
+    REQUIRE(countBuilt(markers, 10) == 1);
+    REQUIRE(markers.hasPendingBuilds());
+
+    // Removed markers are skipped
+    REQUIRE(markers.remove(ids[2]));
+    REQUIRE(!markers.remove(ids[2]));
+
+    REQUIRE(markers.update(10));
+    REQUIRE(countBuilt(markers, 10) == 2);
+    REQUIRE(!markers.update(10));
+    REQUIRE(!markers.hasPendingBuilds());
+
+    // All markers within the default budget
+    markers.setBuildTimeBudget(std::chrono::seconds(10));
+    REQUIRE(markers.update(12));
+    REQUIRE(countBuilt(markers, 12) == 2);
+    REQUIRE(!markers.hasPendingBuilds());
+}
+
+TEST_CASE("MarkerManager adds point markers in batches", "[MarkerManager]") {
+
+    MarkerManager markers;
+    std::vector<LngLat> coordinates = { {-74., 40.7}, {2.35, 48.85}, {139.7, 35.7} };
+
+    // Requires a scene
+    REQUIRE(markers.addPoints(pointStyling, coordinates.data(), coordinates.size()).empty());
+
+    markers.setScene(markerScene());
+
+    REQUIRE(markers.addPoints(pointStyling, coordinates.data(), 0).empty());
+    REQUIRE(markers.addPoints(pointStyling, nullptr, 3).empty());
+    REQUIRE(markers.addPoints(nullptr, coordinates.data(), 3).empty());
+    // Invalid styling adds no markers
+    REQUIRE(markers.addPoints("{ style: points, color: [", coordinates.data(), 3).empty());
+    REQUIRE(markers.markers().empty());
+
+    MarkerID single = markers.add();
+    auto ids = markers.addPoints(pointStyling, coordinates.data(), coordinates.size());
+    REQUIRE(ids.size() == 3);
+    REQUIRE(markers.markers().size() == 4);
+
+    MercatorProjection projection;
+    for (size_t i = 0; i < ids.size(); i++) {
+        // IDs follow the ones of single markers, in the order of the coordinates
+        REQUIRE(ids[i] == single + 1 + i);
+
+        auto marker = findMarker(markers, ids[i]);
+        REQUIRE(marker);
+        REQUIRE(marker->stylingString() == pointStyling);
+        REQUIRE(marker->feature()->geometryType == GeometryType::points);
+        REQUIRE(marker->mesh());
+
+        auto meters = projection.LonLatToMeters({ coordinates[i].longitude, coordinates[i].latitude });
+        REQUIRE(marker->origin().x == Approx(meters.x));
+        REQUIRE(marker->origin().y == Approx(meters.y));
+    }
+
+    // Batch markers are updated like single ones
+    REQUIRE(markers.setVisible(ids[1], false));
+    REQUIRE(!findMarker(markers, ids[1])->isVisible());
+    REQUIRE(markers.remove(ids[0]));
+    REQUIRE(markers.markers().size() == 3);
+}
+
+TEST_CASE("MarkerManager parses each styling once", "[MarkerManager]") {
+
+    MarkerManager markers;
+    markers.setScene(markerScene());
+
+    std::vector<LngLat> coordinates = { {0., 0.}, {1., 1.} };
+    auto ids = markers.addPoints(pointStyling, coordinates.data(), coordinates.size());
+    REQUIRE(ids.size() == 2);
+    REQUIRE(sameStyling(findMarker(markers, ids[0]), findMarker(markers, ids[1])));
+
+    // Single markers get the draw rules of the batch
+    MarkerID a = markers.add();
+    MarkerID b = markers.add();
+    REQUIRE(markers.setPoint(a, {2., 2.}));
+    REQUIRE(markers.setPoint(b, {3., 3.}));
+    REQUIRE(markers.setStyling(a, pointStyling));
+    REQUIRE(markers.setStyling(b, pointStyling));
+    REQUIRE(sameStyling(findMarker(markers, a), findMarker(markers, ids[0])));
+    REQUIRE(sameStyling(findMarker(markers, a), findMarker(markers, b)));
+
+    // Another styling gets its own draw rules
+    const char* otherStyling = "{ style: points, color: red, size: [20px, 20px] }";
+    REQUIRE(markers.setStyling(b, otherStyling));
+    REQUIRE(!sameStyling(findMarker(markers, a), findMarker(markers, b)));
+    REQUIRE(findMarker(markers, b)->stylingString() == otherStyling);
+
+    // Back to the cached one
+    REQUIRE(markers.setStyling(b, pointStyling));
+    REQUIRE(sameStyling(findMarker(markers, a), findMarker(markers, b)));
+
+    // A new scene drops the cached styling, markers are restyled with it
+    markers.setScene(markerScene());
+    REQUIRE(sameStyling(findMarker(markers, a), findMarker(markers, ids[1])));
+}
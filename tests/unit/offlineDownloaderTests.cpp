@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include "data/mbtilesDataSource.h"
+#include "data/networkDataSource.h"
+#include "data/offlineDownloader.h"
+#include "platform_mock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+
+using namespace Tangram;
+
+static const char* s_mbtilesPath = "/tmp/tangram-offline-test.mbtiles";
+static const char* s_urlTemplate = "file:///tmp/tangram-offline-test-{z}-{x}-{y}.mvt";
+
+static std::string tilePath(const TileID& _tile) {
+    return "/tmp/tangram-offline-test-" + std::to_string(_tile.z) + "-" +
+        std::to_string(_tile.x) + "-" + std::to_string(_tile.y) + ".mvt";
+}
+
+static void writeTile(const TileID& _tile) {
+    std::ofstream file(tilePath(_tile), std::ios::binary);
+    file << _tile.toString();
+}
+
+// Run the download of @_region and wait for it to finish
+static OfflineDownloader::Progress download(std::shared_ptr<OfflineDownloader> _downloader,
+                                            const OfflineDownloader::Region& _region) {
+    std::promise<OfflineDownloader::Progress> result;
+    auto future = result.get_future();
+
+    bool started = _downloader->start(_region, nullptr,
+                                      [&](const OfflineDownloader::Progress& _progress, bool _canceled) {
+                                          result.set_value(_progress);
+                                      });
+    REQUIRE(started);
+    REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    return future.get();
+}
+
+TEST_CASE("OfflineDownloader enumerates the tiles of a region", "[OfflineDownloader]") {
+
+    auto world = OfflineDownloader::Region::bounds({ -180, -85 }, { 180, 85 }, 0, 2);
+    REQUIRE(OfflineDownloader::countTiles(world) == 1 + 4 + 16);
+
+    // A block in Manhattan is within one tile at z10
+    auto block = OfflineDownloader::Region::bounds({ -74.0, 40.72 }, { -73.98, 40.74 }, 10, 10);
+    std::vector<TileID> tiles;
+    OfflineDownloader::getTiles(block, 10, tiles);
+    REQUIRE(tiles == std::vector<TileID>({ TileID(301, 384, 10) }));
+
+    // A triangle covers about half of its bounding box
+    OfflineDownloader::Region triangle;
+    triangle.polygon = { { { -180, -85 }, { 180, -85 }, { -180, 85 } } };
+    triangle.minZoom = triangle.maxZoom = 3;
+    uint64_t count = OfflineDownloader::countTiles(triangle);
+    REQUIRE(count >= 32);
+    REQUIRE(count < 64);
+}
+
+TEST_CASE("OfflineDownloader stores tiles into MBTiles and resumes", "[OfflineDownloader]") {
+
+    std::remove(s_mbtilesPath);
+
+    auto platform = std::make_shared<MockUrlPlatform>();
+    platform->serveFiles = true;
+
+    auto network = std::make_shared<NetworkDataSource>(platform, s_urlTemplate);
+    auto mbtiles = std::make_shared<MBTilesDataSource>(platform, "offline", s_mbtilesPath, "", true);
+    REQUIRE(mbtiles->isWritable());
+
+    OfflineDownloader::Options options;
+    options.maxPending = 2;
+    options.batchSize = 2;
+    auto downloader = std::make_shared<OfflineDownloader>(network, mbtiles, options);
+
+    auto region = OfflineDownloader::Region::bounds({ -180, -85 }, { 180, 85 }, 0, 1);
+
+    // All tiles but one are available
+    TileID missing(1, 1, 1);
+    std::vector<TileID> tiles = { TileID(0, 0, 0), TileID(0, 0, 1), TileID(1, 0, 1), TileID(0, 1, 1) };
+    for (auto& tile : tiles) { writeTile(tile); }
+    std::remove(tilePath(missing).c_str());
+
+    auto progress = download(downloader, region);
+    REQUIRE(progress.total == 5);
+    REQUIRE(progress.stored == 4);
+    REQUIRE(progress.failed == 1);
+    REQUIRE(progress.skipped == 0);
+    REQUIRE(progress.bytes > 0);
+    REQUIRE(platform->startCount == 5);
+
+    // Resume: only the missing tile is downloaded
+    writeTile(missing);
+
+    progress = download(downloader, region);
+    REQUIRE(progress.stored == 1);
+    REQUIRE(progress.skipped == 4);
+    REQUIRE(progress.failed == 0);
+    REQUIRE(platform->startCount == 6);
+
+    std::promise<std::vector<TileID>> stored;
+    mbtiles->getTileIDs(0, 1, [&](std::vector<TileID> _tiles) { stored.set_value(std::move(_tiles)); });
+    REQUIRE(stored.get_future().get().size() == 5);
+
+    for (auto& tile : tiles) { std::remove(tilePath(tile).c_str()); }
+    std::remove(tilePath(missing).c_str());
+    std::remove(s_mbtilesPath);
+}
@@ -0,0 +1,158 @@
+#include "catch.hpp"
+
+#include "data/memoryCacheDataSource.h"
+#include "data/rawTileCache.h"
+#include "data/tileSource.h"
+#include "tile/tileID.h"
+
+#include <string>
+
+using namespace Tangram;
+
+static RawTileCache::Data data(size_t _size) {
+    return std::make_shared<RawData>(std::vector<char>(_size));
+}
+
+TEST_CASE("RawTileCache returns cached data by key", "[RawTileCache]") {
+    RawTileCache cache(1024, 4);
+
+    auto a = data(10);
+    cache.put("http://a/0/0/0", a);
+
+    REQUIRE(cache.get("http://a/0/0/0") == a);
+    REQUIRE(cache.get("http://b/0/0/0") == nullptr);
+
+    // Replacing an entry updates the usage
+    cache.put("http://a/0/0/0", data(20));
+    REQUIRE(cache.stats().usage == 20);
+    REQUIRE(cache.stats().entries == 1);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 1);
+
+    cache.remove("http://a/0/0/0");
+    REQUIRE(cache.get("http://a/0/0/0") == nullptr);
+    REQUIRE(cache.stats().usage == 0);
+}
+
+TEST_CASE("RawTileCache evicts unreferenced entries first", "[RawTileCache]") {
+    RawTileCache cache(100, 1);
+
+    cache.put("a", data(40));
+    cache.put("b", data(40));
+
+    // Neither 'a' nor 'b' was accessed, one of them is evicted
+    cache.put("c", data(40));
+    REQUIRE(cache.stats().usage <= 100);
+    REQUIRE(cache.stats().evictions == 1);
+
+    std::string evicted = cache.get("a") ? "b" : "a";
+    REQUIRE(cache.get(evicted) == nullptr);
+
+    // 'c' and the survivor of 'a' and 'b' were referenced by get()
+    cache.get("c");
+    cache.put("d", data(40));
+    REQUIRE(cache.get("d") != nullptr);
+    REQUIRE(cache.stats().entries == 2);
+
+    // Data exceeding the budget is not cached
+    cache.put("e", data(200));
+    REQUIRE(cache.get("e") == nullptr);
+
+    cache.setMaxUsage(50);
+    REQUIRE(cache.stats().usage <= 50);
+
+    cache.clear();
+    REQUIRE(cache.stats().entries == 0);
+}
+
+TEST_CASE("RawTileCache keeps hot entries under pressure", "[RawTileCache]") {
+    RawTileCache cache(10 * 100, 1);
+
+    auto hot = data(100);
+    cache.put("hot", hot);
+
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(cache.get("hot") == hot);
+        cache.put(std::to_string(i), data(100));
+    }
+    REQUIRE(cache.get("hot") == hot);
+    REQUIRE(cache.stats().usage <= 1000);
+}
+
+struct CacheTestSource : TileSource {
+    CacheTestSource(std::unique_ptr<DataSource> _sources) : TileSource("test", std::move(_sources)) {}
+
+    const char* mimeType() override { return ""; }
+
+    std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const override {
+        return nullptr;
+    }
+};
+
+// Serves tiles of the URL template http://@_host/z/x/y
+struct UrlDataSource : TileSource::DataSource {
+    UrlDataSource(std::string _host) : host(_host) {}
+
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        loads++;
+        static_cast<BinaryTileTask&>(*_task).rawTileData = data(10);
+        _cb.func(_task);
+        return true;
+    }
+
+    std::string cacheKey(const TileID& _tile) const override {
+        return "http://" + host + "/" + _tile.toString();
+    }
+
+    std::string host;
+    int loads = 0;
+};
+
+TEST_CASE("MemoryCacheDataSource removes its entries from a shared cache on clear", "[RawTileCache]") {
+    auto cache = std::make_shared<RawTileCache>(1024, 4);
+
+    auto source = [&](const std::string& _host, UrlDataSource*& _urlSource) {
+        auto url = std::make_unique<UrlDataSource>(_host);
+        _urlSource = url.get();
+        auto memory = std::make_unique<MemoryCacheDataSource>(cache);
+        memory->setNext(std::move(url));
+        return std::make_shared<CacheTestSource>(std::move(memory));
+    };
+
+    UrlDataSource* urlA = nullptr;
+    UrlDataSource* urlB = nullptr;
+    auto sourceA = source("a", urlA);
+    auto sourceB = source("b", urlB);
+
+    auto load = [](std::shared_ptr<TileSource> _source, TileID _tileID) {
+        _source->loadTileData(_source->createTask(_tileID), {[](std::shared_ptr<TileTask>) {}});
+    };
+
+    for (int x = 0; x < 2; x++) {
+        load(sourceA, TileID(x, 0, 1));
+        load(sourceB, TileID(x, 0, 1));
+    }
+    REQUIRE(cache->stats().entries == 4);
+
+    load(sourceA, TileID(0, 0, 1));
+    REQUIRE(urlA->loads == 2);
+
+    // Cached data of source 'a' is dropped, the data of 'b' is kept
+    sourceA->clearData();
+    REQUIRE(cache->stats().entries == 2);
+
+    load(sourceA, TileID(0, 0, 1));
+    load(sourceB, TileID(0, 0, 1));
+    REQUIRE(urlA->loads == 3);
+    REQUIRE(urlB->loads == 2);
+}
+
+TEST_CASE("RawTileCache does not cache views of mapped memory", "[RawTileCache]") {
+    RawTileCache cache(1024, 1);
+
+    auto owner = std::make_shared<std::vector<char>>(100);
+    cache.put("mapped", std::make_shared<RawData>(owner->data(), owner->size(), owner));
+
+    REQUIRE(!cache.contains("mapped"));
+    REQUIRE(cache.stats().usage == 0);
+}
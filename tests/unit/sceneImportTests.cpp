@@ -6,6 +6,7 @@
 #include "yaml-cpp/yaml.h"
 #include "platform_mock.h"
 #include "scene/importer.h"
+#include "tangram.h"
 
 using namespace Tangram;
 using namespace YAML;
@@ -264,3 +265,13 @@ TEST_CASE("Sequence overwrites map", "[import][core]") {
     CHECK(root["a"].IsSequence());
     CHECK(root["a"].size() == 2);
 }
+
+TEST_CASE("Source hash separates the fields of scene updates", "[import][core]") {
+    TestImporter importer;
+
+    auto hash = importer.sourceHash({ SceneUpdate("a.b", "c") });
+
+    CHECK(hash == importer.sourceHash({ SceneUpdate("a.b", "c") }));
+    CHECK(hash != importer.sourceHash({ SceneUpdate("a.bc", "") }));
+    CHECK(hash != importer.sourceHash({ SceneUpdate("a.", "bc") }));
+}
@@ -9,6 +9,7 @@ class TestTexture : public Texture {
 public:
     using Texture::Texture;
     const std::vector<DirtyRange>& dirtyRanges() { return m_dirtyRanges; }
+    const std::vector<GLuint>& data() { return m_data; }
 };
 
 TEST_CASE("Merging of dirty Regions - Non overlapping, test ordering", "[Texture]") {
@@ -113,3 +114,22 @@ TEST_CASE("Merging of dirty Regions - Merge three regions, when 3rd region is ad
     }
 
 }
+
+TEST_CASE("Texture size and sub data", "[Texture]") {
+    TextureOptions options = {GL_RGBA, GL_RGBA, {GL_LINEAR, GL_LINEAR}, {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}};
+
+    TestTexture texture(256, 128, options);
+    REQUIRE(texture.bufferSize() == 256 * 128 * 4);
+
+    TestTexture mipmapped(256, 256, options, true);
+    REQUIRE(mipmapped.bufferSize() == 256 * 256 * 4 + (256 * 256 * 4) / 3);
+
+    // Data outside of the sub region is cleared
+    std::vector<GLuint> subData(4 * 4, 0xffffffff);
+    texture.setSubData(subData.data(), 8, 8, 4, 4, 4);
+
+    REQUIRE(texture.data().size() == 256 * 128);
+    REQUIRE(texture.data()[8 * 256 + 8] == 0xffffffff);
+    REQUIRE(texture.data()[8 * 256 + 7] == 0);
+    REQUIRE(texture.data()[0] == 0);
+}
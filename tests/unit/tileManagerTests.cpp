@@ -1,7 +1,12 @@
 #include "catch.hpp"
 
+#include "data/tileData.h"
 #include "data/tileSource.h"
+#include "gl/texture.h"
+#include "tile/tile.h"
+#include "tile/tileCache.h"
 #include "tile/tileManager.h"
+#include "tile/tilePrefetcher.h"
 #include "tile/tileWorker.h"
 #include "util/mapProjection.h"
 #include "util/fastmap.h"
@@ -276,3 +281,219 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+TEST_CASE( "Prefetch predicted Tiles within limit", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(std::make_shared<MockPlatform>(), worker);
+    tileManager.setPrefetchLimit(1);
+
+    // View center in tile 1/0/1
+    ViewState viewState { &s_projection, true, glm::dvec2(1e7, 1e7), 1 };
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,1} };
+    std::set<TileID> prefetchTiles = { TileID{1,0,1}, TileID{1,1,1} };
+
+    /// Load the visible tile and the closest predicted tile
+    tileManager.updateTileSets(viewState, visibleTiles, prefetchTiles);
+
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(tileManager.prefetchStats().requested == 1);
+    REQUIRE(worker.tasks.size() == 2);
+    REQUIRE(worker.tasks[1]->tileId() == TileID(1,0,1));
+    // Prefetch tasks come after visible tiles
+    REQUIRE(worker.tasks[1]->getPriority() > worker.tasks[0]->getPriority());
+
+    worker.processTask();
+    worker.processTask();
+
+    /// Prefetched tiles are not rendered; the next one starts loading
+    tileManager.updateTileSets(viewState, visibleTiles, prefetchTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(source->tileTaskCount == 3);
+    REQUIRE(tileManager.prefetchStats().requested == 2);
+
+    /// Prefetched tile becomes visible, the other one is not predicted anymore
+    std::set<TileID> visibleTiles_2 = { TileID{0,0,1}, TileID{1,0,1} };
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+    REQUIRE(source->tileTaskCount == 3);
+    REQUIRE(tileManager.prefetchStats().hits == 1);
+    REQUIRE(tileManager.prefetchStats().wasted == 1);
+    REQUIRE(worker.tasks.back()->isCanceled() == true);
+}
+
+TEST_CASE( "Count prefetched Tiles evicted from the cache as wasted", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(std::make_shared<MockPlatform>(), worker);
+    tileManager.setPrefetchLimit(1);
+
+    ViewState viewState { &s_projection, true, glm::dvec2(1e7, 1e7), 1 };
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,1} };
+    std::set<TileID> prefetchTiles = { TileID{1,0,1} };
+
+    tileManager.updateTileSets(viewState, visibleTiles, prefetchTiles);
+    REQUIRE(worker.tasks.size() == 2);
+
+    auto prefetched = worker.tasks[1];
+    worker.processTask();
+    worker.processTask();
+
+    // Give the prefetched tile a size in the cache
+    auto texture = std::make_shared<Texture>(16, 16);
+    prefetched->tile()->rasters().emplace_back(TileID(1,0,1), texture);
+
+    /// Not predicted anymore, the prefetched tile is moved to the cache
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(bool(tileManager.getTileCache()->contains(source->id(), TileID(1,0,1))));
+    REQUIRE(tileManager.prefetchStats().wasted == 0);
+
+    /// Evicted before it became visible
+    tileManager.setCacheSize(0);
+    REQUIRE(!bool(tileManager.getTileCache()->contains(source->id(), TileID(1,0,1))));
+    REQUIRE(tileManager.prefetchStats().wasted == 1);
+
+    /// Loaded again when it becomes visible
+    std::set<TileID> visibleTiles_2 = { TileID{0,0,1}, TileID{1,0,1} };
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+
+    REQUIRE(source->tileTaskCount == 3);
+    REQUIRE(tileManager.prefetchStats().hits == 0);
+    REQUIRE(tileManager.prefetchStats().wasted == 1);
+}
+
+TEST_CASE( "Predict Tiles ahead of view motion", "[TileManager][TilePrefetcher]" ) {
+    View view(256, 256);
+    view.setZoom(4);
+    view.setPosition(0, 0);
+    view.update();
+
+    TilePrefetcher prefetcher;
+    prefetcher.update(view, 0.016f);
+    REQUIRE(prefetcher.tiles().empty());
+
+    /// Pan east by a quarter tile per frame
+    double tileSize = 2 * MapProjection::HALF_CIRCUMFERENCE / 16;
+    for (int i = 0; i < 4; i++) {
+        view.translate(tileSize / 4, 0);
+        view.update();
+        prefetcher.update(view, 0.016f);
+    }
+
+    REQUIRE(!prefetcher.tiles().empty());
+
+    int maxVisibleX = 0;
+    for (auto& tile : view.getVisibleTiles()) { maxVisibleX = std::max(maxVisibleX, tile.x); }
+
+    for (auto& tile : prefetcher.tiles()) {
+        REQUIRE(view.getVisibleTiles().count(tile) == 0);
+        REQUIRE(tile.x > maxVisibleX);
+    }
+
+    /// Stopped view: nothing to prefetch
+    for (int i = 0; i < 10; i++) {
+        view.update();
+        prefetcher.update(view, 0.016f);
+    }
+    REQUIRE(prefetcher.tiles().empty());
+
+    /// Zoom ease: predict tiles at the target zoom
+    prefetcher.easeZoom(6, 0.1f);
+    prefetcher.update(view, 0.016f);
+
+    REQUIRE(!prefetcher.tiles().empty());
+    for (auto& tile : prefetcher.tiles()) {
+        REQUIRE(tile.z == 6);
+    }
+}
+
+struct ParseCountSource : TileSource {
+    mutable int parseCount = 0;
+
+    ParseCountSource() : TileSource("", nullptr, -1, -1, 2) {}
+
+    const char* mimeType() override { return ""; };
+
+    std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const override {
+        parseCount++;
+        return std::make_shared<TileData>();
+    }
+};
+
+TEST_CASE( "Parse overzoomed data Tiles once for all styling zooms", "[TileSource]" ) {
+    auto source = std::make_shared<ParseCountSource>();
+
+    auto parse = [&](TileID _tileID) {
+        return source->parseTile(*source->createTask(_tileID), s_projection);
+    };
+
+    auto data = parse(TileID(1, 1, 2, 3, 0));
+    REQUIRE(source->parseCount == 1);
+
+    // Same data tile at other styling zooms and wraps
+    REQUIRE(parse(TileID(1, 1, 2, 4, 0)) == data);
+    REQUIRE(parse(TileID(1, 1, 2, 5, 1)) == data);
+    REQUIRE(source->parseCount == 1);
+
+    // Tiles below max zoom are always parsed
+    parse(TileID(0, 0, 1));
+    parse(TileID(0, 0, 1));
+    REQUIRE(source->parseCount == 3);
+
+    // Updated source data
+    source->clearData();
+    REQUIRE(parse(TileID(1, 1, 2, 3, 0)) != data);
+    REQUIRE(source->parseCount == 4);
+}
+
+TEST_CASE( "Count the rasters shared by Tiles once", "[Tile]" ) {
+
+    auto texture = std::make_shared<Texture>(256, 256);
+    size_t size = texture->bufferSize();
+
+    Tile a(TileID(0, 0, 1), s_projection);
+    // Overzoomed tile of the same raster
+    Tile b(TileID(0, 0, 1, 2, 0), s_projection);
+    a.rasters().emplace_back(TileID(0, 0, 1), texture);
+    b.rasters().emplace_back(TileID(0, 0, 1), texture);
+
+    // The remaining reference is held like the one of a RasterSource
+    REQUIRE(a.getMemoryUsage() + b.getMemoryUsage() == size);
+}
+
+TEST_CASE( "TileCache removes the usage it added for tiles sharing rasters", "[Tile]" ) {
+
+    auto texture = std::make_shared<Texture>(256, 256);
+    size_t size = texture->bufferSize();
+
+    auto a = std::make_shared<Tile>(TileID(0, 0, 1), s_projection);
+    auto b = std::make_shared<Tile>(TileID(0, 0, 1, 2, 0), s_projection);
+    a->rasters().emplace_back(TileID(0, 0, 1), texture);
+    b->rasters().emplace_back(TileID(0, 0, 1), texture);
+
+    TileCache cache(size);
+    REQUIRE(cache.put(0, a).empty());
+    REQUIRE(cache.getMemoryUsage() == size / 2);
+
+    // The share of the cached tile grows when the other tile is dropped
+    b.reset();
+    REQUIRE(cache.get(0, a->getID()) == a);
+    REQUIRE(cache.getMemoryUsage() == 0);
+
+    auto c = std::make_shared<Tile>(TileID(0, 0, 1, 3, 0), s_projection);
+    c->rasters().emplace_back(TileID(0, 0, 1), texture);
+    REQUIRE(cache.put(0, c).empty());
+
+    // Evicted by a limit below its share
+    REQUIRE(cache.limitCacheSize(size / 2 - 1).size() == 1);
+}
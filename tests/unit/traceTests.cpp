@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include "debug/trace.h"
+
+#include <thread>
+
+using namespace Tangram;
+
+TEST_CASE("Trace writes the spans of all threads as trace events", "[Trace]") {
+
+    Trace::clear();
+
+    { TraceSpan span("disabled"); }
+    REQUIRE(Trace::json().find("disabled") == std::string::npos);
+
+    Trace::setEnabled(true);
+
+    { TraceSpan span("main"); }
+
+    std::thread worker([]() {
+        TraceSpan span("worker", TileID(1, 2, 3));
+    });
+    worker.join();
+
+    auto json = Trace::json();
+    REQUIRE(json.find("\"name\":\"main\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"worker\"") != std::string::npos);
+    REQUIRE(json.find("\"tile\":\"3/1/2\"") != std::string::npos);
+
+    Trace::clear();
+    REQUIRE(Trace::json().find("main") == std::string::npos);
+
+    Trace::setEnabled(false);
+}
+
+TEST_CASE("Trace keeps the latest spans of a thread", "[Trace]") {
+
+    Trace::clear();
+    Trace::setEnabled(true);
+
+    { TraceSpan span("first"); }
+    for (int i = 0; i < 10000; i++) {
+        TraceSpan span("span");
+    }
+    { TraceSpan span("last"); }
+
+    auto json = Trace::json();
+    REQUIRE(json.find("first") == std::string::npos);
+    REQUIRE(json.find("last") != std::string::npos);
+
+    Trace::clear();
+    Trace::setEnabled(false);
+}
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -249,3 +250,26 @@ TEST_CASE("Sequences in filters implicitly create an 'any' filter", "[filters][c
     REQUIRE(filter.eval(bmw1, ctx));
     REQUIRE(!filter.eval(bike, ctx));
 }
+
+TEST_CASE( "yaml-filter-tests: geometry mask and zoom range", "[filters][core][yaml]") {
+    float min, max;
+
+    Filter filter = load("filter: { $geometry: line, $zoom: { min: 10, max: 14 } }");
+    REQUIRE(filter.geometryMask() == (1 << GeometryType::lines));
+    filter.zoomRange(min, max);
+    REQUIRE(min == 10);
+    REQUIRE(max == 14);
+
+    filter = load("filter: { any: [{ $geometry: point, $zoom: 5 }, { $geometry: [polygon], $zoom: { min: 12 } }] }");
+    REQUIRE(filter.geometryMask() == ((1 << GeometryType::points) | (1 << GeometryType::polygons)));
+    filter.zoomRange(min, max);
+    REQUIRE(min == 5);
+    REQUIRE(std::isinf(max));
+
+    // Filters on other keys or functions do not restrict geometry and zoom
+    filter = load("filter: { any: [{ kind: road }, function() { return $zoom > 10; }] }");
+    REQUIRE(filter.geometryMask() == 0xff);
+    filter.zoomRange(min, max);
+    REQUIRE(std::isinf(min));
+    REQUIRE(std::isinf(max));
+}
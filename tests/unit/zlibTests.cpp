@@ -0,0 +1,73 @@
+#include "catch.hpp"
+
+#include "util/zlibHelper.h"
+
+#include <zlib.h>
+#include <string>
+
+using namespace Tangram;
+
+// Compress @_data, with gzip header when @_gzip is set, otherwise with zlib header
+static std::vector<char> deflate(const std::string& _data, bool _gzip) {
+    z_stream strm;
+    memset(&strm, 0, sizeof(z_stream));
+    deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (_gzip ? 16 : 0) + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+    std::vector<char> out(deflateBound(&strm, _data.size()) + 32);
+    strm.next_in = (Bytef*)_data.data();
+    strm.avail_in = _data.size();
+    strm.next_out = (Bytef*)out.data();
+    strm.avail_out = out.size();
+    deflate(&strm, Z_FINISH);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return out;
+}
+
+static std::string testData(size_t _size) {
+    std::string data;
+    for (size_t i = 0; data.size() < _size; i++) {
+        data += "layer " + std::to_string(i % 97) + " feature " + std::to_string(i) + ";";
+    }
+    data.resize(_size);
+    return data;
+}
+
+TEST_CASE("Inflate gzip data sized from the ISIZE trailer", "[zlib]") {
+    std::string data = testData(100000);
+    auto compressed = deflate(data, true);
+
+    REQUIRE(zlib::isGzip(compressed.data(), compressed.size()));
+    REQUIRE(zlib::inflatedSize(compressed.data(), compressed.size()) == data.size());
+
+    std::vector<char> out = { 'a', 'b' };
+    REQUIRE(zlib::inflate(compressed.data(), compressed.size(), out) == Z_OK);
+    REQUIRE(out.size() == data.size() + 2);
+    REQUIRE(std::string(out.begin() + 2, out.end()) == data);
+    // Inflated in place without growing the buffer beyond the trailer size
+    REQUIRE(out.capacity() <= data.size() + 3);
+}
+
+TEST_CASE("Inflate zlib data with unknown size", "[zlib]") {
+    std::string data = testData(250000);
+    auto compressed = deflate(data, false);
+
+    REQUIRE_FALSE(zlib::isGzip(compressed.data(), compressed.size()));
+
+    std::vector<char> out;
+    REQUIRE(zlib::inflate(compressed.data(), compressed.size(), out) == Z_OK);
+    REQUIRE(std::string(out.begin(), out.end()) == data);
+}
+
+TEST_CASE("Reject truncated and uncompressed data", "[zlib]") {
+    std::string data = testData(10000);
+    auto compressed = deflate(data, true);
+    compressed.resize(compressed.size() / 2);
+
+    std::vector<char> out = { 'a' };
+    REQUIRE(zlib::inflate(compressed.data(), compressed.size(), out) != Z_OK);
+    REQUIRE(out.size() == 1);
+
+    REQUIRE(zlib::inflate(data.data(), data.size(), out) != Z_OK);
+    REQUIRE(out.size() == 1);
+}
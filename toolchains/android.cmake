@@ -12,6 +12,10 @@ add_library(${LIB_NAME} SHARED
   ${CMAKE_SOURCE_DIR}/platforms/android/tangram/src/main/cpp/jniExports.cpp
   ${CMAKE_SOURCE_DIR}/platforms/android/tangram/src/main/cpp/platform_android.cpp)
 
+target_include_directories(${LIB_NAME}
+  PRIVATE
+  ${CMAKE_SOURCE_DIR}/platforms/common)
+
 target_link_libraries(${LIB_NAME}
   PUBLIC
   ${CORE_LIBRARY}
@@ -0,0 +1,50 @@
+// Generates a CompiledScene from a scene file:
+//
+//   sceneCompiler.out path/to/scene.yaml path/to/scene.bin
+//
+// Reference the output from the scene as 'scene: { compiled: scene.bin }'
+// to skip parsing of layers, filters and draw rules on startup.
+
+#include "platform_mock.h"
+#include "scene/compiledScene.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace Tangram;
+
+int main(int argc, char** argv) {
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <scene.yaml> <output>\n", argv[0]);
+        return 1;
+    }
+
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    auto scene = std::make_shared<Scene>(platform, argv[1]);
+
+    if (!SceneLoader::loadScene(platform, scene)) {
+        fprintf(stderr, "Could not load scene '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<char> data;
+    if (!CompiledScene::write(*scene, data)) {
+        fprintf(stderr, "Could not compile scene '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::ofstream out(argv[2], std::ios::out | std::ios::binary);
+    out.write(data.data(), data.size());
+
+    if (!out.good()) {
+        fprintf(stderr, "Could not write '%s'\n", argv[2]);
+        return 1;
+    }
+
+    printf("Compiled %zu layers into '%s' (%zu bytes)\n", scene->layers().size(), argv[2], data.size());
+
+    return 0;
+}